@@ -2,7 +2,13 @@
 #include <stdio.h>
 #include <string.h>
 #include "sms.h"
+#include "sms_bus.h"
+#include "sms_battery.h"
+#include "sms_profile.h"
 #include "input.h"
+#include "../cpu/z80_jit.h"
+#include "../cpu/z80_trace.h"
+#include "../cpu/z80_stats.h"
 
 static SDL_Window *window = NULL;
 static SDL_Renderer *renderer = NULL;
@@ -43,11 +49,32 @@ SDL_AppResult sms_init(struct sms_t *sms)
     return SDL_APP_CONTINUE;
 }
 
+// Watchpoint hits are logged with the CPU's position: cycles at the start
+// of the accessing instruction and PC as it stood during the access
+static void sms_stamp_watch_hit(void *ctx, struct mmu_watch_hit *hit)
+{
+    struct sms_t *sms = ctx;
+    hit->cycles = sms->cpu.cycles;
+    hit->pc = sms->cpu.registers.PC;
+}
+
+// Ports are decoded on A7, A6 and A0 only, so a polled port is idle on
+// every one of its mirrors
+static void sms_idle_port(struct sms_t *sms, uint8_t port)
+{
+    for (int mirror = 0; mirror < 256; mirror++)
+    {
+        if (((mirror ^ port) & SMS_PORT_DECODE_MASK) == 0)
+            z80_idle_port(&sms->cpu, (uint8_t)mirror);
+    }
+}
+
 struct sms_t *sms_create(struct sms_t *sms)
 {
     mmu_init(&sms->mem);
     z80_init(&sms->cpu);
     vdp_init(&sms->vdp);
+    sms_ports_init(sms);
 
     sms->cpu.read8 = (uint8_t (*)(void *, uint16_t))mmu_read8;
     sms->cpu.write8 = (void (*)(void *, uint16_t, uint8_t))mmu_write8;
@@ -55,18 +82,253 @@ struct sms_t *sms_create(struct sms_t *sms)
     sms->cpu.write16 = (void (*)(void *, uint16_t, uint16_t))mmu_write16;
     sms->cpu.io_read8 = (uint8_t (*)(void *, uint8_t))sms_port_read;
     sms->cpu.io_write8 = (void (*)(void *, uint8_t, uint8_t))sms_port_write;
+    sms->cpu.io_write_block = (size_t (*)(void *, uint8_t, const uint8_t *, size_t))sms_port_write_block;
 
     sms->cpu.memory_ctx = &sms->mem;
+    sms->cpu.read_pages = sms->mem.read_pages;
+    sms->cpu.write_pages = sms->mem.write_pages;
+    sms->cpu.page_banks = sms->mem.page_banks;
     sms->cpu.io_ctx = sms;
 
+    // The VDP counters/status and the pads only change between scanlines,
+    // so loops polling them can be fast-forwarded to the end of the slice
+    sms->cpu.idle_skip = true;
+    sms_idle_port(sms, SMS_PORT_VDP_V_COUNTER);
+    sms_idle_port(sms, SMS_PORT_VDP_H_COUNTER);
+    sms_idle_port(sms, SMS_PORT_VDP_CONTROL);
+    sms_idle_port(sms, SMS_PORT_IO_A);
+    sms_idle_port(sms, SMS_PORT_IO_B);
+
     sms->rom_loaded = false;
     sms->paused = false;
+    sms->rom_hash = 0;
+    sms->rom_start_cycles = 0;
+    sms->line_deadline = 0;
+    sms->block_file[0] = '\0';
+    sms->battery = NULL;
+    sms->closed_battery = NULL;
+    sms->profile = NULL;
+    sms->mem.on_watch_hit = sms_stamp_watch_hit;
+    sms->mem.watch_ctx = sms;
 
     return sms;
 }
 
+// Decoded blocks persist between runs in the user's pref directory, one file
+// per ROM hash, so a ROM seen before starts with its code already decoded
+static void sms_block_file_path(struct sms_t *sms)
+{
+    sms->block_file[0] = '\0';
+    char *pref_path = SDL_GetPrefPath("Caster", "Caster");
+    if (!pref_path)
+    {
+        return;
+    }
+    snprintf(sms->block_file, sizeof(sms->block_file), "%sblocks-%016llx.bin",
+             pref_path, (unsigned long long)sms->rom_hash);
+    SDL_free(pref_path);
+}
+
+static void sms_load_block_file(struct sms_t *sms)
+{
+    if (!sms->cpu.block_cache || !sms->block_file[0])
+    {
+        return;
+    }
+    uint64_t loaded = sms->cpu.block_cache->loaded;
+    z80_block_cache_load(&sms->cpu, sms->block_file, sms->rom_hash);
+    if (sms->cpu.block_cache->loaded != loaded)
+    {
+        printf("Restored %llu decoded blocks from %s\n",
+               (unsigned long long)(sms->cpu.block_cache->loaded - loaded), sms->block_file);
+    }
+}
+
+static void sms_save_block_file(struct sms_t *sms)
+{
+    if (sms->cpu.block_cache && sms->rom_loaded && sms->block_file[0])
+    {
+        z80_block_cache_save(&sms->cpu, sms->block_file, sms->rom_hash);
+    }
+}
+
+// Cartridge RAM is saved next to the block files, named after the ROM.
+// Reading and writing the file is left to the battery's own thread, which
+// first waits for the outgoing ROM's battery to finish its last flush.
+static void sms_open_battery(struct sms_t *sms)
+{
+    char path[512];
+    char *pref_path = SDL_GetPrefPath("Caster", "Caster");
+    snprintf(path, sizeof(path), "%ssave-%016llx.sav",
+             pref_path ? pref_path : "", (unsigned long long)sms->rom_hash);
+    SDL_free(pref_path);
+    sms->battery = sms_battery_open(path, sms->closed_battery);
+    if (sms->battery)
+    {
+        sms->closed_battery = NULL;
+    }
+}
+
+static void sms_close_battery(struct sms_t *sms)
+{
+    if (!sms->battery)
+        return;
+    sms_battery_close(sms->battery, &sms->mem);
+    sms->closed_battery = sms->battery;
+    sms->battery = NULL;
+}
+
+// Per-ROM idle-loop and HALT statistics, printed when the ROM is replaced
+// or the machine shuts down
+static void sms_report_idle(struct sms_t *sms)
+{
+    uint64_t total = sms->cpu.cycles - sms->rom_start_cycles;
+    if (!sms->rom_loaded || total == 0)
+    {
+        return;
+    }
+    printf("ROM %016llx: skipped %llu of %llu cycles in idle loops (%.1f%%), %llu halted (%.1f%%)\n",
+           (unsigned long long)sms->rom_hash,
+           (unsigned long long)sms->cpu.idle_skipped,
+           (unsigned long long)total,
+           100.0 * sms->cpu.idle_skipped / total,
+           (unsigned long long)sms->cpu.halted_cycles,
+           100.0 * sms->cpu.halted_cycles / total);
+}
+
+// Write the instruction trace next to the block files, named after the ROM.
+// Decode it with z80_trace_decode.
+static void sms_dump_trace(struct sms_t *sms)
+{
+    char path[512];
+    char *pref_path = SDL_GetPrefPath("Caster", "Caster");
+    snprintf(path, sizeof(path), "%strace-%016llx.bin",
+             pref_path ? pref_path : "", (unsigned long long)sms->rom_hash);
+    SDL_free(pref_path);
+    z80_trace_dump(sms->cpu.trace, path);
+}
+
+// Start recording every instruction into a ring buffer, or stop and write
+// out what was recorded
+void sms_toggle_trace(struct sms_t *sms)
+{
+    if (sms->cpu.trace)
+    {
+        sms_dump_trace(sms);
+        z80_trace_destroy(sms->cpu.trace);
+        sms->cpu.trace = NULL;
+        return;
+    }
+
+    sms->cpu.trace = z80_trace_create(Z80_TRACE_DEFAULT_SIZE);
+    if (sms->cpu.trace)
+    {
+        printf("Tracing the last %u instructions\n", sms->cpu.trace->mask + 1);
+    }
+}
+
+// Write the opcode histogram next to the block files, named after the ROM
+static void sms_dump_opcode_stats(struct sms_t *sms)
+{
+    char path[512];
+    char *pref_path = SDL_GetPrefPath("Caster", "Caster");
+    snprintf(path, sizeof(path), "%sopcodes-%016llx.csv",
+             pref_path ? pref_path : "", (unsigned long long)sms->rom_hash);
+    SDL_free(pref_path);
+    z80_stats_dump_csv(sms->cpu.stats, path);
+}
+
+// Start counting executed opcodes, or stop and write out the counts. While
+// counting, the CPU runs in the debug loop.
+void sms_toggle_opcode_stats(struct sms_t *sms)
+{
+    if (sms->cpu.stats)
+    {
+        sms_dump_opcode_stats(sms);
+        z80_stats_destroy(sms->cpu.stats);
+        sms->cpu.stats = NULL;
+        return;
+    }
+
+    if (!Z80_OPCODE_STATS)
+    {
+        printf("Opcode statistics need a build with CASTER_OPCODE_STATS\n");
+        return;
+    }
+    sms->cpu.stats = z80_stats_create();
+    if (sms->cpu.stats)
+    {
+        printf("Counting executed opcodes\n");
+    }
+}
+
+// Write the access profile next to the opcode histogram, as CSV for reading
+// and binary for tools
+static void sms_dump_profile(struct sms_t *sms)
+{
+    char path[512];
+    char *pref_path = SDL_GetPrefPath("Caster", "Caster");
+    snprintf(path, sizeof(path), "%sprofile-%016llx.csv",
+             pref_path ? pref_path : "", (unsigned long long)sms->rom_hash);
+    sms_profile_dump_csv(sms->profile, path);
+    snprintf(path, sizeof(path), "%sprofile-%016llx.bin",
+             pref_path ? pref_path : "", (unsigned long long)sms->rom_hash);
+    sms_profile_dump_binary(sms->profile, sms->rom_hash, path);
+    SDL_free(pref_path);
+}
+
+// Start counting accesses per byte, or stop and write out the counts. While
+// counting, every memory access takes the MMU's slow path and the CPU runs
+// in the debug loop; the block cache is flushed both ways since it works
+// from a copy of the write table.
+void sms_toggle_profile(struct sms_t *sms)
+{
+    if (sms->profile)
+    {
+        sms_dump_profile(sms);
+        mmu_profile_stop(&sms->mem);
+        sms->cpu.on_execute = NULL;
+        sms_profile_destroy(sms->profile);
+        sms->profile = NULL;
+        z80_block_cache_flush(&sms->cpu);
+        return;
+    }
+
+    sms->profile = sms_profile_create(sms->mem.cartridge_size);
+    if (sms->profile)
+    {
+        mmu_profile_start(&sms->mem, &sms->profile->mem);
+        sms->cpu.on_execute = (void (*)(void *, uint16_t))mmu_profile_execute;
+        z80_block_cache_flush(&sms->cpu);
+        printf("Profiling memory accesses\n");
+    }
+}
+
 void sms_destroy(struct sms_t *sms)
 {
+    sms_report_idle(sms);
+    sms_save_block_file(sms);
+    sms_close_battery(sms);
+    // Exiting would cut the last flush short
+    sms_battery_wait(sms->closed_battery);
+    sms->closed_battery = NULL;
+    z80_trace_destroy(sms->cpu.trace);
+    sms->cpu.trace = NULL;
+    if (sms->cpu.stats)
+    {
+        sms_toggle_opcode_stats(sms);
+    }
+    if (sms->profile)
+    {
+        sms_toggle_profile(sms);
+    }
+
+    struct z80_jit *jit = sms->cpu.jit;
+    struct z80_block_cache *cache = sms->cpu.block_cache;
+    z80_jit_attach(&sms->cpu, NULL);
+    z80_jit_destroy(jit);
+    z80_block_cache_attach(&sms->cpu, NULL);
+    z80_block_cache_destroy(cache);
     mmu_deinit(&sms->mem);
 
     if (texture)
@@ -87,74 +349,151 @@ void sms_destroy(struct sms_t *sms)
     gui_cleanup();
 }
 
-bool sms_load_rom(struct sms_t *sms, const uint8_t *rom_data, size_t size)
+// Run the CPU through the recompiler, optionally checking every block
+// against the interpreter. Returns false (and keeps interpreting) where no
+// native backend is available.
+bool sms_enable_jit(struct sms_t *sms, bool verify)
 {
-    if (!sms || !rom_data)
+    struct z80_jit *jit = z80_jit_create(verify ? Z80_JIT_VERIFY : Z80_JIT_RUN);
+    if (!jit)
     {
+        printf("JIT not available on this platform, using the interpreter\n");
         return false;
     }
 
-    mmu_load_rom(&sms->mem, rom_data, size);
-    sms->rom_loaded = true;
-
-    printf("ROM loaded successfully: %zu bytes\n", size);
+    if (!sms->cpu.block_cache)
+    {
+        z80_block_cache_attach(&sms->cpu, z80_block_cache_create());
+    }
+    // Attaching flushes the cache; bring back the ROM's stored blocks
+    z80_jit_attach(&sms->cpu, jit);
+    if (sms->rom_loaded)
+    {
+        sms_load_block_file(sms);
+    }
+    printf("JIT enabled%s\n", verify ? " (verifying against the interpreter)" : "");
     return true;
 }
 
-bool sms_load_rom_file(struct sms_t *sms, const char *filename)
+// Watch start..end for the accesses in kinds (enum mmu_watch_kind bits).
+// Reads and writes are caught by taking the pages out of the Z80's page
+// tables; execution by a breakpoint over the range, which the frame loop
+// logs and runs through. Returns the index, or -1 if no slot is free.
+int sms_add_watchpoint(struct sms_t *sms, uint16_t start, uint16_t end, uint8_t kinds)
 {
-    if (!sms || !filename)
+    if ((kinds & MMU_WATCH_EXECUTE) && !z80_set_breakpoint_range(&sms->cpu, start, end))
     {
-        return false;
+        return -1;
     }
-
-    FILE *file = fopen(filename, "rb");
-    if (!file)
+    int index = mmu_watch_add(&sms->mem, start, end, kinds);
+    if (index < 0 && (kinds & MMU_WATCH_EXECUTE))
     {
-        printf("Failed to open ROM file: %s\n", filename);
-        return false;
+        z80_clear_breakpoint_range(&sms->cpu, start, end);
     }
+    // The block cache works from a copy of the write table
+    z80_block_cache_flush(&sms->cpu);
+    return index;
+}
 
-    fseek(file, 0, SEEK_END);
-    long size = ftell(file);
-    fseek(file, 0, SEEK_SET);
+void sms_remove_watchpoint(struct sms_t *sms, int index)
+{
+    struct mmu_watch *watch = sms->mem.watch;
+    if (!watch || index < 0 || index >= watch->count)
+    {
+        return;
+    }
+    if (watch->points[index].kinds & MMU_WATCH_EXECUTE)
+    {
+        z80_clear_breakpoint_range(&sms->cpu, watch->points[index].start, watch->points[index].end);
+    }
+    mmu_watch_remove(&sms->mem, index);
+    z80_block_cache_flush(&sms->cpu);
+}
 
-    if (size <= 0)
+// The CPU stopped at a breakpoint: log it if an execute watchpoint put it
+// there, in which case the slice carries on
+static bool sms_execute_watch_hit(struct sms_t *sms)
+{
+    struct mmu_watch *watch = sms->mem.watch;
+    uint16_t pc = sms->cpu.registers.PC;
+    if (!watch)
     {
-        printf("Invalid ROM file size: %ld\n", size);
-        fclose(file);
         return false;
     }
+    uint32_t hits = watch->hits;
+    mmu_watch_check(&sms->mem, pc, MMU_WATCH_EXECUTE, mmu_peek8(&sms->mem, pc));
+    return watch->hits != hits;
+}
 
-    // Allocate buffer
-    uint8_t *rom_buffer = malloc((size_t)size);
-    if (!rom_buffer)
+// Keep what was decoded for the outgoing ROM, and its cartridge RAM, before
+// it is dropped
+static void sms_unload_rom(struct sms_t *sms)
+{
+    sms_report_idle(sms);
+    sms_save_block_file(sms);
+    sms_close_battery(sms);
+    // The cartridge counts are sized for this ROM
+    if (sms->profile)
     {
-        printf("Failed to allocate memory for ROM buffer (%ld bytes)\n", size);
-        fclose(file);
-        return false;
+        sms_toggle_profile(sms);
     }
+}
 
-    // Read file in one go
-    size_t bytes_read = fread(rom_buffer, 1, (size_t)size, file);
-    fclose(file);
+// The MMU holds a new cartridge: restart the bookkeeping that follows it
+static void sms_rom_inserted(struct sms_t *sms)
+{
+    z80_block_cache_flush(&sms->cpu);
+    sms->rom_loaded = true;
+    sms->rom_hash = z80_block_hash(sms->mem.cartridge, sms->mem.cartridge_size, Z80_BLOCK_HASH_SEED);
+    sms->rom_start_cycles = sms->cpu.cycles;
+    sms->line_deadline = sms->cpu.cycles;
+    sms->cpu.idle_skipped = 0;
+    sms->cpu.halted_cycles = 0;
+    sms_block_file_path(sms);
+    sms_load_block_file(sms);
+    sms_open_battery(sms);
+}
 
-    if (bytes_read != (size_t)size)
+bool sms_load_rom(struct sms_t *sms, const uint8_t *rom_data, size_t size)
+{
+    if (!sms || !rom_data)
     {
-        printf("Failed to read ROM file completely\n");
-        free(rom_buffer);
         return false;
     }
 
-    bool success = sms_load_rom(sms, rom_buffer, bytes_read);
-    free(rom_buffer);
+    sms_unload_rom(sms);
+    mmu_load_rom(&sms->mem, rom_data, size);
+    sms_rom_inserted(sms);
+
+    printf("ROM loaded successfully: %zu bytes, %s mapper\n", size, mmu_mapper_name(sms->mem.mapper_type));
+    return true;
+}
+
+// The file is mapped and used as the cartridge directly where possible,
+// so the ROM is never held more than once, see mmu_load_rom_file()
+bool sms_load_rom_file(struct sms_t *sms, const char *filename)
+{
+    if (!sms || !filename)
+    {
+        return false;
+    }
 
-    if (success)
+    sms_unload_rom(sms);
+    if (!mmu_load_rom_file(&sms->mem, filename))
     {
-        printf("ROM file '%s' loaded successfully\n", filename);
+        // The old cartridge is still in; keep saving its RAM
+        if (sms->rom_loaded)
+        {
+            sms_open_battery(sms);
+        }
+        return false;
     }
+    sms_rom_inserted(sms);
 
-    return success;
+    printf("ROM file '%s' loaded successfully (%zu bytes, %s mapper%s)\n", filename,
+           sms->mem.cartridge_size, mmu_mapper_name(sms->mem.mapper_type),
+           sms->mem.cartridge_mapped ? ", mapped" : "");
+    return true;
 }
 
 void sms_reset(struct sms_t *sms)
@@ -168,40 +507,23 @@ void sms_reset(struct sms_t *sms)
 
 uint8_t sms_port_read(struct sms_t *sms, uint8_t port)
 {
-    switch (port)
-    {
-        case SMS_PORT_VDP_V_COUNTER:
-        case SMS_PORT_VDP_H_COUNTER:
-        case SMS_PORT_VDP_DATA:
-        case SMS_PORT_VDP_CONTROL:
-            return vdp_port_read(&sms->vdp, port);
-        case SMS_PORT_IO_A:
-        case SMS_PORT_IO_B:
-            return input_port_read(sms, port);
-        
-    default:
-        return 0xFF;
-    }
+    return sms_port_read_inline(sms, port);
 }
 
 void sms_port_write(struct sms_t *sms, uint8_t port, uint8_t value)
 {
-    switch (port)
-    {
-    case SMS_PORT_VDP_DATA:
-    case SMS_PORT_VDP_CONTROL:
-        vdp_port_write(&sms->vdp, port, value);
-        break;
+    sms_port_write_inline(sms, port, value);
+}
 
-    default:
-        break;
-    }
+size_t sms_port_write_block(struct sms_t *sms, uint8_t port, const uint8_t *data, size_t size)
+{
+    return sms_port_write_block_inline(sms, port, data, size);
 }
 
 void sms_run_frame(struct sms_t *sms)
 {
-    // Early exit if no ROM loaded
-    if (!sms->rom_loaded || sms->paused)
+    // Early exit if no ROM loaded, or its save is still being read
+    if (!sms->rom_loaded || sms->paused || !sms_battery_ready(sms->battery, &sms->mem))
     {
         SDL_RenderClear(renderer);
         gui_render(sms, renderer, texture);
@@ -216,17 +538,34 @@ void sms_run_frame(struct sms_t *sms)
     struct z80_t *cpu = &sms->cpu;
     struct vdp_t *vdp = &sms->vdp;
 
+    // Scanlines end on absolute deadlines, so an instruction running past
+    // one is paid back from the next line instead of accumulating
     for (uint16_t scanline = 0; scanline < SCANLINES_PER_FRAME; scanline++)
     {
-        z80_run_cycles(cpu, CYCLES_PER_SCANLINE);
-        vdp_process_scanline(vdp, framebuffer);
-
-        if (vdp_interrupt_pending(vdp))
+        sms->line_deadline += CYCLES_PER_SCANLINE;
+        enum z80_run_reason reason;
+        do
+        {
+            reason = z80_run_until(cpu, sms->line_deadline);
+            // A port access moved the VDP's IRQ output mid-line
+            if (reason == Z80_RUN_IO_EVENT)
+                z80_set_interrupt_line(cpu, vdp_interrupt_pending(vdp));
+        } while (reason == Z80_RUN_IO_EVENT ||
+                 (reason == Z80_RUN_BREAKPOINT && sms_execute_watch_hit(sms)));
+
+        // The CPU dying on an opcode or reaching a breakpoint is exactly
+        // what a running trace is for: write it out while it is fresh
+        if (cpu->trace && (reason == Z80_RUN_STOPPED || reason == Z80_RUN_BREAKPOINT))
         {
-            z80_set_interrupt_line(cpu, true);
+            sms_toggle_trace(sms);
         }
+        vdp_process_scanline(vdp, framebuffer);
+        z80_set_interrupt_line(cpu, vdp_interrupt_pending(vdp));
     }
 
+    // Cartridge RAM written this frame goes to the battery's writer thread
+    sms_battery_update(sms->battery, &sms->mem);
+
     // Update texture and render
     SDL_UpdateTexture(texture, NULL, framebuffer, 256 * sizeof(uint32_t));
     SDL_RenderClear(renderer);
@@ -7,13 +7,21 @@
 #include "../gui/gui.h"
 #include "SDL3/SDL.h"
 
+struct sms_battery;
+struct sms_profile;
+
 #define SMS_MASTER_CLOCK_HZ       53693100u   // 53.6931 MHz
 #define SMS_SYSTEM_CLOCK_HZ       (SMS_MASTER_CLOCK_HZ / 15)  // ≈ 3579540 Hz
 #define NTSC_CHROMA_SUBCARRIER_HZ   3579545u    // 315 / 88 MHz (~3.579545 MHz)
 
-// SMS I/O Port definitions
+// SMS I/O Port definitions. Only A7, A6 and A0 are decoded
+// (SMS_PORT_DECODE_MASK), so each port below answers on all its mirrors.
 typedef enum
 {
+    // Memory and I/O control (write-only)
+    SMS_PORT_MEMORY_CONTROL = 0x3E,
+    SMS_PORT_IO_CONTROL     = 0x3F,
+
     // VDP (Video Display Processor) Ports
     SMS_PORT_VDP_V_COUNTER = 0x7E, // VDP V Counter (read-only)
     SMS_PORT_VDP_H_COUNTER = 0x7F, // VDP H Counter (read-only)
@@ -25,32 +33,70 @@ typedef enum
     SMS_PORT_IO_B = 0xDD,    // I/O Port B (Controller 2)
 
     // PSG (Programmable Sound Generator) Port
-    // SMS_PORT_PSG = 0x7F, // PSG Data Port (write-only, same as H Counter)
+    SMS_PORT_PSG = 0x7F,     // PSG Data Port (write-only, same as H Counter)
+} sms_port_t;
 
+#define SMS_PORT_DECODE_MASK 0xC1   // A7, A6, A0
 
-} sms_port_t;
+struct sms_t;
+
+// Handlers of one I/O port, see sms_map_port_read()
+typedef uint8_t (*sms_port_read_fn)(struct sms_t *sms, uint8_t port);
+typedef void (*sms_port_write_fn)(struct sms_t *sms, uint8_t port, uint8_t value);
+
+struct sms_port_handler
+{
+    sms_port_read_fn read;
+    sms_port_write_fn write;
+};
 
+// The frame loop state sits right behind the CPU, and the VDP ahead of the
+// 80KB memory map, so the per-scanline working set stays together
 struct sms_t
 {
     struct z80_t cpu;
-    struct mmu_t mem;
-    struct vdp_t vdp;
+    uint64_t line_deadline;    // cpu.cycles at which the current scanline ends
     // System state
     bool powered_on;
     bool paused;
     bool rom_loaded;
+    struct vdp_t vdp;
+    // Every port number, mirrors included, so an IN or OUT is one indirect
+    // call; see sms_ports.c
+    struct sms_port_handler ports[256];
+    struct mmu_t mem;
+    uint64_t rom_start_cycles; // cpu.cycles when the ROM was loaded
+    // Decoded-block file of the loaded ROM (empty = none), see z80_block.h
+    uint64_t rom_hash;
+    char block_file[512];
+    // Writer of the loaded ROM's cartridge RAM save, and the previous ROM's
+    // while it finishes its last flush, see sms_battery.h
+    struct sms_battery *battery;
+    struct sms_battery *closed_battery;
+    // Access heatmap while profiling (NULL otherwise), see sms_profile.h
+    struct sms_profile *profile;
 };
 
 // System functions
 SDL_AppResult sms_init(struct sms_t *sms);
 struct sms_t *sms_create(struct sms_t *sms);
 void sms_destroy(struct sms_t *sms);
+bool sms_enable_jit(struct sms_t *sms, bool verify);
+void sms_toggle_trace(struct sms_t *sms);
+void sms_toggle_opcode_stats(struct sms_t *sms);
+void sms_toggle_profile(struct sms_t *sms);
+int sms_add_watchpoint(struct sms_t *sms, uint16_t start, uint16_t end, uint8_t kinds);
+void sms_remove_watchpoint(struct sms_t *sms, int index);
 bool sms_load_rom(struct sms_t *sms, const uint8_t *rom_data, size_t size);
 bool sms_load_rom_file(struct sms_t *sms, const char *filename);
 void sms_reset(struct sms_t *sms);
 void sms_power_on(struct sms_t *sms);
 void sms_power_off(struct sms_t *sms);
+void sms_ports_init(struct sms_t *sms);
+void sms_map_port_read(struct sms_t *sms, uint8_t port, sms_port_read_fn read);
+void sms_map_port_write(struct sms_t *sms, uint8_t port, sms_port_write_fn write);
 uint8_t sms_port_read(struct sms_t *sms, uint8_t port);
 void sms_port_write(struct sms_t *sms, uint8_t port, uint8_t value);
+size_t sms_port_write_block(struct sms_t *sms, uint8_t port, const uint8_t *data, size_t size);
 void sms_run_frame(struct sms_t *sms);
 #endif
\ No newline at end of file
@@ -0,0 +1,229 @@
+#include <stdlib.h>
+#include <string.h>
+#include "sms_battery.h"
+
+#define PAGE_SIZE Z80_PAGE_SIZE
+#define ALL_PAGES (~0u >> (32 - MMU_CARTRIDGE_RAM_PAGES))
+
+// Copy the pages in dirty from src to dst
+static void copy_pages(uint8_t *dst, const uint8_t *src, uint32_t dirty)
+{
+    for (int page = 0; page < MMU_CARTRIDGE_RAM_PAGES; page++)
+    {
+        if (dirty & (1u << page))
+            memcpy(dst + page * PAGE_SIZE, src + page * PAGE_SIZE, PAGE_SIZE);
+    }
+}
+
+// Writer thread: read the saved RAM (if any) into the snapshot, before the
+// emulation thread may look at it
+static void load_file(struct sms_battery *battery)
+{
+    FILE *file = fopen(battery->path, "rb");
+    if (file)
+    {
+        size_t size = fread(battery->snapshot, 1, sizeof(battery->snapshot), file);
+        fclose(file);
+        printf("Loaded %zu bytes of cartridge RAM from %s\n", size, battery->path);
+    }
+}
+
+// Writer thread: put pages of out into the file. The first call is handed
+// every page, so a file it has to create gets the whole RAM.
+static void write_pages(struct sms_battery *battery, uint32_t pages)
+{
+    if (battery->failed || !pages)
+        return;
+
+    if (!battery->file)
+    {
+        battery->file = fopen(battery->path, "r+b");
+        if (!battery->file)
+        {
+            battery->file = fopen(battery->path, "w+b");
+        }
+        if (!battery->file)
+        {
+            printf("Failed to open battery save: %s\n", battery->path);
+            battery->failed = true;
+            return;
+        }
+    }
+
+    bool ok = true;
+    for (int page = 0; page < MMU_CARTRIDGE_RAM_PAGES && ok; page++)
+    {
+        if (!(pages & (1u << page)))
+            continue;
+        ok = fseek(battery->file, page * PAGE_SIZE, SEEK_SET) == 0 &&
+             fwrite(battery->out + page * PAGE_SIZE, PAGE_SIZE, 1, battery->file) == 1;
+    }
+    if (!ok || fflush(battery->file) != 0)
+    {
+        printf("Failed to write battery save: %s\n", battery->path);
+        battery->failed = true;
+    }
+}
+
+// Writer thread, with the lock held: take the pending pages out of the
+// snapshot so they can be written with the lock released
+static uint32_t take_pending(struct sms_battery *battery)
+{
+    uint32_t pages = battery->file ? battery->pending : ALL_PAGES;
+    if (!battery->pending)
+        return 0;
+
+    copy_pages(battery->out, battery->snapshot, pages);
+    battery->pending = 0;
+    return pages;
+}
+
+// Wait for the previous save of this file to be finished, load it, then
+// sleep until there is something to write, let more writes gather for up
+// to SMS_BATTERY_FLUSH_MS and write them. The lock is only held to move
+// pages between the snapshot and out, so the emulation thread never waits
+// on the disk.
+static int SDLCALL battery_writer(void *data)
+{
+    struct sms_battery *battery = data;
+
+    if (battery->previous)
+    {
+        sms_battery_wait(battery->previous);
+        battery->previous = NULL;
+    }
+    load_file(battery);
+
+    SDL_LockMutex(battery->lock);
+    battery->loaded = true;
+    while (!battery->quit)
+    {
+        if (!battery->pending)
+        {
+            SDL_WaitCondition(battery->wake, battery->lock);
+            continue;
+        }
+
+        Uint64 due = SDL_GetTicks() + SMS_BATTERY_FLUSH_MS;
+        Uint64 now;
+        while (!battery->quit && (now = SDL_GetTicks()) < due)
+        {
+            SDL_WaitConditionTimeout(battery->wake, battery->lock, (Sint32)(due - now));
+        }
+        uint32_t pages = take_pending(battery);
+        SDL_UnlockMutex(battery->lock);
+        write_pages(battery, pages);
+        SDL_LockMutex(battery->lock);
+    }
+    // Whatever sms_battery_close() handed over last
+    uint32_t pages = take_pending(battery);
+    SDL_UnlockMutex(battery->lock);
+    write_pages(battery, pages);
+    if (battery->file)
+    {
+        fclose(battery->file);
+        battery->file = NULL;
+    }
+    return 0;
+}
+
+// Start the writer for the cartridge RAM saved in path. It first waits for
+// previous (a closed battery, or NULL) to finish and frees it, then loads
+// the file; see sms_battery_ready(). Returns NULL, leaving the RAM unsaved
+// and previous to the caller, if the thread can't start.
+struct sms_battery *sms_battery_open(const char *path, struct sms_battery *previous)
+{
+    struct sms_battery *battery = calloc(1, sizeof(*battery));
+    if (!battery)
+    {
+        printf("Failed to allocate the battery save\n");
+        return NULL;
+    }
+    snprintf(battery->path, sizeof(battery->path), "%s", path);
+    battery->previous = previous;
+
+    battery->lock = SDL_CreateMutex();
+    battery->wake = SDL_CreateCondition();
+    if (battery->lock && battery->wake)
+    {
+        battery->thread = SDL_CreateThread(battery_writer, "battery", battery);
+    }
+    if (!battery->thread)
+    {
+        printf("Failed to start the battery writer: %s\n", SDL_GetError());
+        SDL_DestroyCondition(battery->wake);
+        SDL_DestroyMutex(battery->lock);
+        free(battery);
+        return NULL;
+    }
+    return battery;
+}
+
+// Emulation thread, before each frame: false until the writer has loaded
+// the save, then (once) copy it into the cartridge RAM. The game must not
+// run before that, or it would find its RAM blank.
+bool sms_battery_ready(struct sms_battery *battery, struct mmu_t *mem)
+{
+    if (!battery || battery->applied)
+        return true;
+    if (!SDL_TryLockMutex(battery->lock))
+        return false;
+
+    if (battery->loaded)
+    {
+        memcpy(mem->cartridge_ram, battery->snapshot, sizeof(mem->cartridge_ram));
+        mem->cartridge_ram_dirty = 0;
+        battery->applied = true;
+    }
+    SDL_UnlockMutex(battery->lock);
+    return battery->applied;
+}
+
+// Emulation thread, once a frame: hand the RAM pages written since the last
+// call to the writer. Never waits; if the writer is busy the pages stay
+// dirty and go with a later frame.
+void sms_battery_update(struct sms_battery *battery, struct mmu_t *mem)
+{
+    uint32_t dirty = mem->cartridge_ram_dirty;
+    if (!battery || !battery->applied || !dirty || !SDL_TryLockMutex(battery->lock))
+        return;
+
+    copy_pages(battery->snapshot, mem->cartridge_ram, dirty);
+    battery->pending |= dirty;
+    mem->cartridge_ram_dirty = 0;
+    SDL_SignalCondition(battery->wake);
+    SDL_UnlockMutex(battery->lock);
+}
+
+// Hand over the last writes and tell the writer to stop once they are on
+// disk. Does not wait for it: the battery must then go to the next
+// sms_battery_open() as previous, or to sms_battery_wait().
+void sms_battery_close(struct sms_battery *battery, struct mmu_t *mem)
+{
+    if (!battery)
+        return;
+
+    // Only ever held by the writer to move pages, never across file I/O
+    SDL_LockMutex(battery->lock);
+    if (battery->applied)
+    {
+        copy_pages(battery->snapshot, mem->cartridge_ram, mem->cartridge_ram_dirty);
+        battery->pending |= mem->cartridge_ram_dirty;
+        mem->cartridge_ram_dirty = 0;
+    }
+    battery->quit = true;
+    SDL_SignalCondition(battery->wake);
+    SDL_UnlockMutex(battery->lock);
+}
+
+// Wait for a closed battery's writer to finish and free it
+void sms_battery_wait(struct sms_battery *battery)
+{
+    if (!battery)
+        return;
+
+    SDL_WaitThread(battery->thread, NULL);
+    SDL_DestroyCondition(battery->wake);
+    SDL_DestroyMutex(battery->lock);
+    free(battery);
+}
@@ -0,0 +1,48 @@
+#ifndef SMS_BATTERY_H_
+#define SMS_BATTERY_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "../mmu/mmu.h"
+#include "SDL3/SDL.h"
+
+#define SMS_BATTERY_FLUSH_MS 1000   // longest a write to cartridge RAM waits for the disk
+
+// Battery-backed cartridge RAM. No file I/O happens on the emulation
+// thread. The writer thread reads the .sav file first and publishes it;
+// sms_battery_ready() copies it into the cartridge RAM and holds the game
+// back until then. After that the emulation thread only copies the RAM
+// pages written since the last frame into a snapshot, and the writer puts
+// the snapshot's dirty pages into the file at most once per
+// SMS_BATTERY_FLUSH_MS. Closing hands the last pages over without waiting;
+// the next battery's writer (or sms_battery_wait() at exit) waits for that
+// final flush, so a save is never read back before it is complete. The
+// file is only created once the game writes its RAM.
+struct sms_battery
+{
+    SDL_Thread *thread;
+    SDL_Mutex *lock;
+    SDL_Condition *wake;
+    // Shared with the writer, under lock
+    uint8_t snapshot[MMU_CARTRIDGE_RAM_SIZE];
+    uint32_t pending;          // snapshot pages not yet in the file
+    bool loaded;               // snapshot holds the file's contents
+    bool quit;
+    // Emulation thread only
+    bool applied;              // snapshot copied into the cartridge RAM
+    // Writer thread only
+    struct sms_battery *previous;  // closed battery to wait for before loading
+    uint8_t out[MMU_CARTRIDGE_RAM_SIZE];  // pages being written
+    FILE *file;
+    bool failed;
+    char path[512];
+};
+
+struct sms_battery *sms_battery_open(const char *path, struct sms_battery *previous);
+bool sms_battery_ready(struct sms_battery *battery, struct mmu_t *mem);
+void sms_battery_update(struct sms_battery *battery, struct mmu_t *mem);
+void sms_battery_close(struct sms_battery *battery, struct mmu_t *mem);
+void sms_battery_wait(struct sms_battery *battery);
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef SMS_BUS_H_
+#define SMS_BUS_H_
+
+#include <stddef.h>
+#include "sms.h"
+#include "sms_profile.h"
+
+// The SMS owns its Z80, so the rest of the machine is reachable from the
+// CPU pointer without going through z80_t's context pointers
+static inline struct sms_t *sms_from_cpu(struct z80_t *cpu)
+{
+    return (struct sms_t *)((char *)cpu - offsetof(struct sms_t, cpu));
+}
+
+// Ports go through the table sms_ports_init() filled, mirrors included
+static inline uint8_t sms_port_read_inline(struct sms_t *sms, uint8_t port)
+{
+    return sms->ports[port].read(sms, port);
+}
+
+static inline void sms_port_write_inline(struct sms_t *sms, uint8_t port, uint8_t value)
+{
+    sms->ports[port].write(sms, port, value);
+}
+
+// A run of writes to one port (OTIR); returns the bytes written. VDP data
+// uploads go through as one span. Other ports take one byte at a time and
+// stop after one whose handler asked the CPU for control back (e.g. a
+// register write raising the VDP IRQ), as the per-byte path would.
+static inline size_t sms_port_write_block_inline(struct sms_t *sms, uint8_t port, const uint8_t *data, size_t size)
+{
+    if (((port ^ SMS_PORT_VDP_DATA) & SMS_PORT_DECODE_MASK) == 0)
+    {
+        if (sms->profile)
+            sms_profile_vdp_data(sms->profile, &sms->vdp, true, size);
+        vdp_data_port_write_block(&sms->vdp, data, size);
+        return size;
+    }
+    for (size_t i = 0; i < size; i++)
+    {
+        sms_port_write_inline(sms, port, data[i]);
+        if (sms->cpu.exit_reason)
+            return i + 1;
+    }
+    return size;
+}
+
+// Z80 bus binding for the SMS build (Z80_BUS_HEADER, see cpu/z80.c)
+static inline uint8_t z80_bus_read8(struct z80_t *cpu, uint16_t addr)
+{
+    return mmu_read8_inline(&sms_from_cpu(cpu)->mem, addr);
+}
+
+static inline void z80_bus_write8(struct z80_t *cpu, uint16_t addr, uint8_t value)
+{
+    mmu_write8_inline(&sms_from_cpu(cpu)->mem, addr, value);
+}
+
+static inline uint8_t z80_bus_in(struct z80_t *cpu, uint8_t port)
+{
+    return sms_port_read_inline(sms_from_cpu(cpu), port);
+}
+
+static inline void z80_bus_out(struct z80_t *cpu, uint8_t port, uint8_t value)
+{
+    sms_port_write_inline(sms_from_cpu(cpu), port, value);
+}
+
+static inline size_t z80_bus_out_block(struct z80_t *cpu, uint8_t port, const uint8_t *data, size_t size)
+{
+    return sms_port_write_block_inline(sms_from_cpu(cpu), port, data, size);
+}
+
+#endif
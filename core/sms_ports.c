@@ -0,0 +1,150 @@
+#include "sms.h"
+#include "sms_profile.h"
+#include "input.h"
+
+// I/O port decoding. The SMS only looks at A7, A6 and A0 of the port
+// number, so each device answers on 64 ports. Rather than decode on every
+// IN and OUT, devices register on one port number and sms_map_port_read()/
+// sms_map_port_write() fill in the handler of every mirror, leaving a plain
+// 256-entry table: an access is one indirect call.
+//
+//   A7 A6  read                   write
+//    0  0  open bus               memory control (even), I/O control (odd)
+//    0  1  V counter / H counter  PSG
+//    1  0  VDP data / control     VDP data / control
+//    1  1  I/O port A / B         -
+
+static uint8_t open_bus_read(struct sms_t *sms, uint8_t port)
+{
+    (void)sms;
+    (void)port;
+    return 0xFF;
+}
+
+static void ignored_write(struct sms_t *sms, uint8_t port, uint8_t value)
+{
+    (void)sms;
+    (void)port;
+    (void)value;
+}
+
+static bool same_port(uint8_t a, uint8_t b)
+{
+    return ((a ^ b) & SMS_PORT_DECODE_MASK) == 0;
+}
+
+// Route reads of port, and every mirror of it, to read
+void sms_map_port_read(struct sms_t *sms, uint8_t port, sms_port_read_fn read)
+{
+    for (int mirror = 0; mirror < 256; mirror++)
+    {
+        if (same_port((uint8_t)mirror, port))
+            sms->ports[mirror].read = read;
+    }
+}
+
+void sms_map_port_write(struct sms_t *sms, uint8_t port, sms_port_write_fn write)
+{
+    for (int mirror = 0; mirror < 256; mirror++)
+    {
+        if (same_port((uint8_t)mirror, port))
+            sms->ports[mirror].write = write;
+    }
+}
+
+// VDP. The port protocol (control latch, read buffer) lives in vdp.c; the
+// data port handlers are where the access profiler sees VRAM.
+static uint8_t vdp_v_counter_read(struct sms_t *sms, uint8_t port)
+{
+    (void)port;
+    return sms->vdp.v_counter;
+}
+
+static uint8_t vdp_h_counter_read(struct sms_t *sms, uint8_t port)
+{
+    (void)port;
+    return sms->vdp.h_counter;
+}
+
+static uint8_t vdp_data_read(struct sms_t *sms, uint8_t port)
+{
+    (void)port;
+    if (sms->profile)
+        sms_profile_vdp_data(sms->profile, &sms->vdp, false, 1);
+    return vdp_data_port_read(&sms->vdp);
+}
+
+// Status reads and register writes can move the VDP's IRQ output. The CPU
+// only samples its line between run slices, so hand control back to
+// sms_run_frame() to update it before the next instruction.
+static void vdp_irq_changed(struct sms_t *sms, bool was_pending)
+{
+    if (vdp_interrupt_pending(&sms->vdp) != was_pending)
+        z80_request_exit(&sms->cpu);
+}
+
+static uint8_t vdp_control_read(struct sms_t *sms, uint8_t port)
+{
+    (void)port;
+    bool irq = vdp_interrupt_pending(&sms->vdp);
+    uint8_t status = vdp_control_port_read(&sms->vdp);
+    vdp_irq_changed(sms, irq);
+    return status;
+}
+
+static void vdp_data_write(struct sms_t *sms, uint8_t port, uint8_t value)
+{
+    (void)port;
+    if (sms->profile)
+        sms_profile_vdp_data(sms->profile, &sms->vdp, true, 1);
+    vdp_data_port_write(&sms->vdp, value);
+}
+
+static void vdp_control_write(struct sms_t *sms, uint8_t port, uint8_t value)
+{
+    (void)port;
+    bool irq = vdp_interrupt_pending(&sms->vdp);
+    vdp_control_port_write(&sms->vdp, value);
+    vdp_irq_changed(sms, irq);
+}
+
+static void sms_register_vdp(struct sms_t *sms)
+{
+    sms_map_port_read(sms, SMS_PORT_VDP_V_COUNTER, vdp_v_counter_read);
+    sms_map_port_read(sms, SMS_PORT_VDP_H_COUNTER, vdp_h_counter_read);
+    sms_map_port_read(sms, SMS_PORT_VDP_DATA, vdp_data_read);
+    sms_map_port_read(sms, SMS_PORT_VDP_CONTROL, vdp_control_read);
+    sms_map_port_write(sms, SMS_PORT_VDP_DATA, vdp_data_write);
+    sms_map_port_write(sms, SMS_PORT_VDP_CONTROL, vdp_control_write);
+}
+
+// PSG. There is no sound yet: its writes are decoded, so they no longer
+// land on the counters' ports, and dropped here.
+static void psg_write(struct sms_t *sms, uint8_t port, uint8_t value)
+{
+    (void)sms;
+    (void)port;
+    (void)value;
+}
+
+static void memory_control_write(struct sms_t *sms, uint8_t port, uint8_t value)
+{
+    mmu_port_write(&sms->mem, port, value);
+}
+
+// Fill the whole table: open bus everywhere, then each device on its ports
+void sms_ports_init(struct sms_t *sms)
+{
+    for (int port = 0; port < 256; port++)
+    {
+        sms->ports[port].read = open_bus_read;
+        sms->ports[port].write = ignored_write;
+    }
+
+    sms_map_port_write(sms, SMS_PORT_MEMORY_CONTROL, memory_control_write);
+    sms_register_vdp(sms);
+    // Both PSG ports, the even one being the V counter's
+    sms_map_port_write(sms, SMS_PORT_VDP_V_COUNTER, psg_write);
+    sms_map_port_write(sms, SMS_PORT_PSG, psg_write);
+    input_register_ports(sms);
+}
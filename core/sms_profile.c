@@ -0,0 +1,153 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sms_profile.h"
+
+#define PROFILE_MAGIC "CSTPROF1"
+
+static const char *const region_names[SMS_PROFILE_REGIONS] =
+{
+    [MMU_PROFILE_CARTRIDGE] = "cartridge",
+    [MMU_PROFILE_CARTRIDGE_RAM] = "cartridge_ram",
+    [MMU_PROFILE_SYSTEM_RAM] = "system_ram",
+    [SMS_PROFILE_VRAM] = "vram",
+};
+
+// Counters for a cartridge of cartridge_size bytes (whole banks)
+struct sms_profile *sms_profile_create(size_t cartridge_size)
+{
+    struct sms_profile *profile = calloc(1, sizeof(*profile));
+    struct mmu_access_counts *cartridge = calloc(cartridge_size ? cartridge_size : 1, sizeof(*cartridge));
+    struct mmu_access_counts *cartridge_ram = calloc(MMU_CARTRIDGE_RAM_SIZE, sizeof(*cartridge_ram));
+    struct mmu_access_counts *system_ram = calloc(MMU_RAM_SIZE, sizeof(*system_ram));
+    if (!profile || !cartridge || !cartridge_ram || !system_ram)
+    {
+        printf("Failed to allocate the access profile\n");
+        free(profile);
+        free(cartridge);
+        free(cartridge_ram);
+        free(system_ram);
+        return NULL;
+    }
+
+    profile->mem.counts[MMU_PROFILE_CARTRIDGE] = cartridge;
+    profile->mem.size[MMU_PROFILE_CARTRIDGE] = cartridge_size;
+    profile->mem.counts[MMU_PROFILE_CARTRIDGE_RAM] = cartridge_ram;
+    profile->mem.size[MMU_PROFILE_CARTRIDGE_RAM] = MMU_CARTRIDGE_RAM_SIZE;
+    profile->mem.counts[MMU_PROFILE_SYSTEM_RAM] = system_ram;
+    profile->mem.size[MMU_PROFILE_SYSTEM_RAM] = MMU_RAM_SIZE;
+    return profile;
+}
+
+void sms_profile_destroy(struct sms_profile *profile)
+{
+    if (!profile)
+        return;
+    for (int region = 0; region < MMU_PROFILE_REGIONS; region++)
+    {
+        free(profile->mem.counts[region]);
+    }
+    free(profile);
+}
+
+void sms_profile_reset(struct sms_profile *profile)
+{
+    for (int region = 0; region < MMU_PROFILE_REGIONS; region++)
+    {
+        memset(profile->mem.counts[region], 0, profile->mem.size[region] * sizeof(struct mmu_access_counts));
+    }
+    memset(profile->vram, 0, sizeof(profile->vram));
+}
+
+const char *sms_profile_region_name(int region)
+{
+    return region >= 0 && region < SMS_PROFILE_REGIONS ? region_names[region] : "";
+}
+
+// Counts of one region (enum mmu_profile_region or enum sms_profile_region)
+// and its size in bytes
+const struct mmu_access_counts *sms_profile_region(const struct sms_profile *profile, int region, size_t *size)
+{
+    if (region == SMS_PROFILE_VRAM)
+    {
+        *size = SMS_PROFILE_VRAM_SIZE;
+        return profile->vram;
+    }
+    *size = profile->mem.size[region];
+    return profile->mem.counts[region];
+}
+
+static bool close_dump(FILE *file, const char *path)
+{
+    bool ok = !ferror(file);
+    if (fclose(file) != 0)
+    {
+        ok = false;
+    }
+    if (!ok)
+    {
+        printf("Failed to write %s\n", path);
+        return false;
+    }
+    printf("Wrote access profile to %s\n", path);
+    return true;
+}
+
+// One line per byte that was accessed, by region, bank and offset in the bank
+bool sms_profile_dump_csv(const struct sms_profile *profile, const char *path)
+{
+    FILE *file = fopen(path, "w");
+    if (!file)
+    {
+        printf("Failed to open %s for writing\n", path);
+        return false;
+    }
+
+    fprintf(file, "region,bank,offset,reads,writes,executes\n");
+    for (int region = 0; region < SMS_PROFILE_REGIONS; region++)
+    {
+        size_t size;
+        const struct mmu_access_counts *counts = sms_profile_region(profile, region, &size);
+        for (size_t i = 0; i < size; i++)
+        {
+            if (counts[i].read || counts[i].write || counts[i].execute)
+            {
+                fprintf(file, "%s,%zu,%04zX,%u,%u,%u\n", region_names[region],
+                        i / SMS_PROFILE_BANK_SIZE, i % SMS_PROFILE_BANK_SIZE,
+                        counts[i].read, counts[i].write, counts[i].execute);
+            }
+        }
+    }
+    return close_dump(file, path);
+}
+
+// The whole profile in host byte order: magic, ROM hash and region count,
+// then per region its name (16 bytes), its size and size {read, write,
+// execute} triples of uint32_t
+bool sms_profile_dump_binary(const struct sms_profile *profile, uint64_t rom_hash, const char *path)
+{
+    FILE *file = fopen(path, "wb");
+    if (!file)
+    {
+        printf("Failed to open %s for writing\n", path);
+        return false;
+    }
+
+    uint32_t regions = SMS_PROFILE_REGIONS;
+    fwrite(PROFILE_MAGIC, 8, 1, file);
+    fwrite(&rom_hash, sizeof(rom_hash), 1, file);
+    fwrite(&regions, sizeof(regions), 1, file);
+    for (int region = 0; region < SMS_PROFILE_REGIONS; region++)
+    {
+        char name[16] = {0};
+        size_t size;
+        const struct mmu_access_counts *counts = sms_profile_region(profile, region, &size);
+        uint32_t size32 = (uint32_t)size;
+
+        strncpy(name, region_names[region], sizeof(name) - 1);
+        fwrite(name, sizeof(name), 1, file);
+        fwrite(&size32, sizeof(size32), 1, file);
+        fwrite(counts, sizeof(*counts), size, file);
+    }
+    return close_dump(file, path);
+}
@@ -0,0 +1,55 @@
+#ifndef SMS_PROFILE_H_
+#define SMS_PROFILE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "../mmu/mmu.h"
+#include "../vdp/vdp.h"
+
+#define SMS_PROFILE_VRAM_SIZE 0x4000
+#define SMS_PROFILE_BANK_SIZE MMU_SLOT_SIZE   // rows of the CSV and the heatmap
+
+// The MMU's regions, then VRAM
+enum sms_profile_region
+{
+    SMS_PROFILE_VRAM = MMU_PROFILE_REGIONS,
+    SMS_PROFILE_REGIONS
+};
+
+// Access heatmap: reads, writes and executes of every byte of the
+// cartridge (per bank), cartridge RAM and system RAM, counted by the MMU
+// (see mmu_profile_start()), and of VRAM through the VDP data port. While
+// it runs every memory access takes the MMU's slow path and the CPU runs
+// in the debug loop; stopped, nothing of it is left in the access path.
+struct sms_profile
+{
+    struct mmu_profile mem;
+    struct mmu_access_counts vram[SMS_PROFILE_VRAM_SIZE];
+};
+
+struct sms_profile *sms_profile_create(size_t cartridge_size);
+void sms_profile_destroy(struct sms_profile *profile);
+void sms_profile_reset(struct sms_profile *profile);
+const char *sms_profile_region_name(int region);
+const struct mmu_access_counts *sms_profile_region(const struct sms_profile *profile, int region, size_t *size);
+bool sms_profile_dump_csv(const struct sms_profile *profile, const char *path);
+bool sms_profile_dump_binary(const struct sms_profile *profile, uint64_t rom_hash, const char *path);
+
+// size bytes going through the VDP data port: reads prefetch VRAM at the
+// VDP address, writes reach it unless they are aimed at CRAM
+static inline void sms_profile_vdp_data(struct sms_profile *profile, const struct vdp_t *vdp, bool write, size_t size)
+{
+    if (write && vdp->code != 0x1)
+        return;
+    for (size_t i = 0; i < size; i++)
+    {
+        struct mmu_access_counts *counts = &profile->vram[(vdp->address + i) & (SMS_PROFILE_VRAM_SIZE - 1)];
+        if (write)
+            counts->write++;
+        else
+            counts->read++;
+    }
+}
+
+#endif
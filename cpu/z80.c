@@ -4,6 +4,194 @@
 #include "z80.h"
 #include "z80_flags.h"
 #include "z80_opcode_table.h"
+#include "z80_block.h"
+#include "z80_jit.h"
+#include "z80_trace.h"
+#include "z80_stats.h"
+#include "z80_timing_tables.h"
+
+// Bus binding. By default the core goes through the callbacks in z80_t so any
+// host (e.g. the z80_test harness) can plug in its own memory and ports. A
+// machine build can instead set Z80_BUS_HEADER to a header that defines
+// z80_bus_read8/write8/in/out against its own hardware, letting the compiler
+// inline the whole path.
+#ifdef Z80_BUS_HEADER
+#include Z80_BUS_HEADER
+#else
+static inline uint8_t z80_bus_read8(struct z80_t *cpu, uint16_t addr)
+{
+    return cpu->read8(cpu->memory_ctx, addr);
+}
+
+static inline void z80_bus_write8(struct z80_t *cpu, uint16_t addr, uint8_t value)
+{
+    cpu->write8(cpu->memory_ctx, addr, value);
+}
+
+static inline uint8_t z80_bus_in(struct z80_t *cpu, uint8_t port)
+{
+    return cpu->io_read8(cpu->io_ctx, port);
+}
+
+static inline void z80_bus_out(struct z80_t *cpu, uint8_t port, uint8_t value)
+{
+    cpu->io_write8(cpu->io_ctx, port, value);
+}
+
+static inline size_t z80_bus_out_block(struct z80_t *cpu, uint8_t port, const uint8_t *data, size_t size)
+{
+    if (cpu->io_write_block)
+        return cpu->io_write_block(cpu->io_ctx, port, data, size);
+
+    for (size_t i = 0; i < size; i++)
+    {
+        cpu->io_write8(cpu->io_ctx, port, data[i]);
+        if (cpu->exit_reason)
+            return i + 1;
+    }
+    return size;
+}
+#endif
+
+// Build fails if the hot and warm sections of struct z80_t outgrow their
+// cache lines (see z80.h)
+typedef char z80_hot_fits_a_line[offsetof(struct z80_t, code_pages) <= Z80_CACHE_LINE ? 1 : -1];
+typedef char z80_warm_fits_a_line[offsetof(struct z80_t, interrupt_line) <= 2 * Z80_CACHE_LINE ? 1 : -1];
+
+// No page mapped directly: every access goes through the bus
+static uint8_t *const z80_unmapped_pages[Z80_PAGE_COUNT];
+
+// JIT verification (z80_jit.c) unmaps the page tables while it checks a
+// block, so every access lands here. The interpreter's pass goes to the real
+// bus and is journaled; the recompiled pass is served from the journal.
+static uint8_t bus_log_read8(struct z80_t *cpu, uint16_t addr)
+{
+    struct z80_bus_log *log = cpu->bus_log;
+    if (log->replay)
+    {
+        return z80_bus_log_replay(cpu, Z80_BUS_READ, addr, 0);
+    }
+
+    uint8_t *page = log->read_pages[addr >> Z80_PAGE_SHIFT];
+    uint8_t value = page ? page[addr & Z80_PAGE_MASK] : z80_bus_read8(cpu, addr);
+    z80_bus_log_record(cpu, Z80_BUS_READ, addr, value);
+    return value;
+}
+
+static void bus_log_write8(struct z80_t *cpu, uint16_t addr, uint8_t value)
+{
+    struct z80_bus_log *log = cpu->bus_log;
+    uint8_t kind = Z80_BUS_WRITE;
+    if (log->replay)
+    {
+        z80_bus_log_replay(cpu, kind, addr, value);
+        return;
+    }
+
+    if ((cpu->code_pages >> (addr >> Z80_PAGE_SHIFT)) & 1)
+    {
+        z80_block_invalidate_page(cpu, addr >> Z80_PAGE_SHIFT);
+        kind |= Z80_BUS_INVALIDATE;
+    }
+    z80_bus_log_record(cpu, kind, addr, value);
+
+    uint8_t *page = log->write_pages[addr >> Z80_PAGE_SHIFT];
+    if (page)
+    {
+        page[addr & Z80_PAGE_MASK] = value;
+        return;
+    }
+    z80_bus_write8(cpu, addr, value);
+}
+
+// Accesses that miss the page tables. Kept out of line so the page-table
+// fast paths below stay small enough to inline everywhere. A read that
+// misses may be one the memory owner trapped (a watchpoint, the profiler)
+// and wants to see every time, so it counts as a bus event like a write.
+static uint8_t bus_read8_unmapped(struct z80_t *cpu, uint16_t addr)
+{
+    cpu->bus_events++;
+    if (cpu->bus_log)
+    {
+        return bus_log_read8(cpu, addr);
+    }
+    return z80_bus_read8(cpu, addr);
+}
+
+static uint8_t bus_fetch8_unmapped(struct z80_t *cpu, uint16_t addr)
+{
+    cpu->bus_events++;
+    if (cpu->bus_log)
+    {
+        if (cpu->bus_log->replay)
+        {
+            return z80_bus_log_fetch(cpu, addr);
+        }
+        uint8_t *page = cpu->bus_log->read_pages[addr >> Z80_PAGE_SHIFT];
+        if (page)
+        {
+            return page[addr & Z80_PAGE_MASK];
+        }
+    }
+    return z80_bus_read8(cpu, addr);
+}
+
+static void bus_write8_unmapped(struct z80_t *cpu, uint16_t addr, uint8_t value)
+{
+    if (cpu->bus_log)
+    {
+        bus_log_write8(cpu, addr, value);
+        return;
+    }
+    // Pages holding decoded blocks are unmapped for writes, so self-modifying
+    // code lands here and drops them before the write goes through
+    if ((cpu->code_pages >> (addr >> Z80_PAGE_SHIFT)) & 1)
+    {
+        z80_block_invalidate_page(cpu, addr >> Z80_PAGE_SHIFT);
+        uint8_t *page = cpu->write_pages[addr >> Z80_PAGE_SHIFT];
+        if (page)
+        {
+            page[addr & Z80_PAGE_MASK] = value;
+            return;
+        }
+    }
+    z80_bus_write8(cpu, addr, value);
+}
+
+static inline uint8_t bus_read8(struct z80_t *cpu, uint16_t addr)
+{
+    uint8_t *page = cpu->read_pages[addr >> Z80_PAGE_SHIFT];
+    if (page)
+    {
+        return page[addr & Z80_PAGE_MASK];
+    }
+    return bus_read8_unmapped(cpu, addr);
+}
+
+// Instruction stream reads. JIT verification leaves them out of the journal,
+// since a translation has its immediates built in and never fetches them;
+// the recompiled pass is served the bytes the block was decoded from.
+static inline uint8_t bus_fetch8(struct z80_t *cpu, uint16_t addr)
+{
+    uint8_t *page = cpu->read_pages[addr >> Z80_PAGE_SHIFT];
+    if (page)
+    {
+        return page[addr & Z80_PAGE_MASK];
+    }
+    return bus_fetch8_unmapped(cpu, addr);
+}
+
+static inline void bus_write8(struct z80_t *cpu, uint16_t addr, uint8_t value)
+{
+    uint8_t *page = cpu->write_pages[addr >> Z80_PAGE_SHIFT];
+    cpu->bus_events++;
+    if (page)
+    {
+        page[addr & Z80_PAGE_MASK] = value;
+        return;
+    }
+    bus_write8_unmapped(cpu, addr, value);
+}
 
 // Stack operations
 void z80_stack_push8(struct z80_t *cpu, uint8_t value)
@@ -15,9 +203,9 @@ void z80_stack_push8(struct z80_t *cpu, uint8_t value)
 void z80_stack_push16(struct z80_t *cpu, uint16_t value)
 {
     cpu->registers.SP--;
-    z80_write8(cpu, cpu->registers.SP, (value >> 8) & 0xFF);
+    bus_write8(cpu, cpu->registers.SP, (value >> 8) & 0xFF);
     cpu->registers.SP--;
-    z80_write8(cpu, cpu->registers.SP, value & 0xFF);
+    bus_write8(cpu, cpu->registers.SP, value & 0xFF);
 }
 
 uint8_t z80_stack_pop8(struct z80_t *cpu)
@@ -29,9 +217,9 @@ uint8_t z80_stack_pop8(struct z80_t *cpu)
 
 uint16_t z80_stack_pop16(struct z80_t *cpu)
 {
-    uint8_t low = z80_read8(cpu, cpu->registers.SP);
+    uint8_t low = bus_read8(cpu, cpu->registers.SP);
     cpu->registers.SP++;
-    uint8_t high = z80_read8(cpu, cpu->registers.SP);
+    uint8_t high = bus_read8(cpu, cpu->registers.SP);
     cpu->registers.SP++;
     
     return (high << 8) | low;
@@ -40,25 +228,188 @@ uint16_t z80_stack_pop16(struct z80_t *cpu)
 // Memory access functions
 uint8_t z80_read8(struct z80_t *cpu, uint16_t addr)
 {
-    uint8_t byte = cpu->read8(cpu->memory_ctx, addr);
-    cpu->cycle_count += 3; // Memory read cycle (3 T-states)
-    return byte;
+    return bus_read8(cpu, addr);
 }
 
 void z80_write8(struct z80_t *cpu, uint16_t addr, uint8_t value)
 {
-    cpu->write8(cpu->memory_ctx, addr, value);
-    cpu->cycle_count += 3;
+    bus_write8(cpu, addr, value);
 }
 
 uint8_t z80_port_in(struct z80_t *cpu, uint8_t port)
 {
-    return cpu->io_read8(cpu->io_ctx, port);
+    if (!(cpu->idle_ports[port >> 3] & (1 << (port & 7))))
+    {
+        cpu->bus_events++;
+    }
+    if (cpu->bus_log)
+    {
+        if (cpu->bus_log->replay)
+        {
+            return z80_bus_log_replay(cpu, Z80_BUS_IN, port, 0);
+        }
+        uint8_t value = z80_bus_in(cpu, port);
+        z80_bus_log_record(cpu, Z80_BUS_IN, port, value);
+        return value;
+    }
+    return z80_bus_in(cpu, port);
 }
 
 void z80_port_out(struct z80_t *cpu, uint8_t port, uint8_t value)
 {
-    cpu->io_write8(cpu->io_ctx, port, value);
+    cpu->bus_events++;
+    if (cpu->bus_log)
+    {
+        if (cpu->bus_log->replay)
+        {
+            z80_bus_log_replay(cpu, Z80_BUS_OUT, port, value);
+            return;
+        }
+        z80_bus_log_record(cpu, Z80_BUS_OUT, port, value);
+    }
+    z80_bus_out(cpu, port, value);
+}
+
+// Bulk execution of the repeating block instructions. Inside a slice nothing
+// outside the CPU changes and the interrupt line stays where it was, so the
+// per-iteration path can only stop at the slice deadline. The ED executors
+// ask how many iterations that would be, run all but the last one through
+// the helpers below and finish with one ordinary iteration, which leaves the
+// flags, PC and cycle_count exactly as the per-iteration path would.
+
+// Iterations the per-iteration path would run from here before returning:
+// at least 1, at most remaining
+uint32_t z80_bulk_iterations(struct z80_t *cpu, uint32_t remaining, uint32_t cycles_per_iteration)
+{
+    if (cpu->debug || cpu->trace || cpu->stats || cpu->on_execute || cpu->breakpoint_count ||
+        cpu->bus_log || cpu->int_pending || cpu->cycles >= cpu->slice_end)
+    {
+        return 1;
+    }
+
+    uint64_t fit = (cpu->slice_end - cpu->cycles + cycles_per_iteration - 1) / cycles_per_iteration;
+    return fit < remaining ? (uint32_t)fit : remaining;
+}
+
+// Shorten a run of n bytes starting at addr (moving by step) so it stops
+// short of the two bytes of the block instruction itself, which the
+// per-iteration path fetches again on every pass
+static uint32_t bulk_clip(uint16_t insn, uint16_t addr, int step, uint32_t n)
+{
+    for (int i = 0; i < 2; i++)
+    {
+        uint16_t distance = step > 0 ? (uint16_t)(insn + i - addr) : (uint16_t)(addr - insn - i);
+        if (distance < n)
+        {
+            n = distance;
+        }
+    }
+    return n;
+}
+
+// LDIR (step 1) / LDDR (step -1): copy up to count bytes from (HL) to (DE)
+// through directly mapped pages, updating HL, DE, BC and cycles as count
+// iterations would. Stops early at a page that needs the bus (I/O, code
+// under the block cache) and returns the iterations done.
+uint32_t z80_bulk_copy(struct z80_t *cpu, uint32_t count, int step, uint32_t cycles_per_iteration)
+{
+    uint16_t insn = cpu->registers.PC - 2;
+    uint32_t done = 0;
+
+    while (done < count)
+    {
+        uint16_t src = cpu->registers.HL;
+        uint16_t dst = cpu->registers.DE;
+        uint8_t *src_page = cpu->read_pages[src >> Z80_PAGE_SHIFT];
+        uint8_t *dst_page = cpu->write_pages[dst >> Z80_PAGE_SHIFT];
+        if (!src_page || !dst_page)
+        {
+            break;
+        }
+
+        uint16_t src_offset = src & Z80_PAGE_MASK;
+        uint16_t dst_offset = dst & Z80_PAGE_MASK;
+        uint32_t n;
+        if (step > 0)
+        {
+            n = Z80_PAGE_SIZE - (src_offset > dst_offset ? src_offset : dst_offset);
+        }
+        else
+        {
+            n = (src_offset < dst_offset ? src_offset : dst_offset) + 1;
+        }
+        if (n > count - done)
+        {
+            n = count - done;
+        }
+        n = bulk_clip(insn, dst, step, n);
+        if (n == 0)
+        {
+            break;
+        }
+
+        const uint8_t *s = src_page + src_offset;
+        uint8_t *d = dst_page + dst_offset;
+        if (step > 0 && (d <= s || d >= s + n))
+        {
+            memcpy(d, s, n);
+        }
+        else
+        {
+            // Overlapping (e.g. the DE = HL + 1 fill idiom) or descending:
+            // byte by byte, in the order the CPU would do it
+            for (uint32_t i = 0; i < n; i++)
+            {
+                *d = *s;
+                d += step;
+                s += step;
+            }
+        }
+
+        cpu->registers.HL += step * (int)n;
+        cpu->registers.DE += step * (int)n;
+        cpu->registers.BC -= n;
+        cpu->cycles += (uint64_t)n * cycles_per_iteration;
+        cpu->bus_events += n;
+        done += n;
+    }
+    return done;
+}
+
+// OTIR: send up to count bytes from (HL) upwards to port C as one span per
+// directly mapped page, updating HL, B and cycles. Stops after a byte whose
+// port handler called z80_request_exit(). Returns the iterations done.
+uint32_t z80_bulk_out(struct z80_t *cpu, uint32_t count, uint32_t cycles_per_iteration)
+{
+    uint32_t done = 0;
+
+    while (done < count)
+    {
+        uint16_t src = cpu->registers.HL;
+        const uint8_t *page = cpu->read_pages[src >> Z80_PAGE_SHIFT];
+        if (!page)
+        {
+            break;
+        }
+
+        uint32_t n = Z80_PAGE_SIZE - (src & Z80_PAGE_MASK);
+        if (n > count - done)
+        {
+            n = count - done;
+        }
+        n = (uint32_t)z80_bus_out_block(cpu, cpu->registers.C, page + (src & Z80_PAGE_MASK), n);
+
+        cpu->registers.HL += n;
+        cpu->registers.B -= n;
+        cpu->cycles += (uint64_t)n * cycles_per_iteration;
+        cpu->bus_events += n;
+        done += n;
+        if (cpu->exit_reason)
+        {
+            break;
+        }
+    }
+    return done;
 }
 
 uint16_t z80_read16(struct z80_t *cpu, uint16_t addr)
@@ -76,29 +427,29 @@ void z80_write16(struct z80_t *cpu, uint16_t addr, uint16_t value)
 
 uint8_t z80_fetch8(struct z80_t *cpu)
 {
-    uint8_t byte = z80_read8(cpu, cpu->registers.PC);
+    uint8_t byte = bus_fetch8(cpu, cpu->registers.PC);
     cpu->registers.PC++;
     return byte;
 }
 
 uint16_t z80_fetch16(struct z80_t *cpu)
 {
-    uint16_t word = z80_read16(cpu, cpu->registers.PC);
+    uint8_t low = bus_fetch8(cpu, cpu->registers.PC);
+    uint8_t high = bus_fetch8(cpu, cpu->registers.PC + 1);
     cpu->registers.PC += 2;
-    return word;
+    return (high << 8) | low;
 }
 
 uint8_t z80_fetch_opcode(struct z80_t *cpu)
 {
-    uint8_t opcode = z80_read8(cpu, cpu->registers.PC++);
-    cpu->cycle_count += 1; // Extra T-state for opcode fetch
-    return opcode;
+    return bus_fetch8(cpu, cpu->registers.PC++);
 }
 
 // Z80 interrupt functions
 void z80_set_interrupt_line(struct z80_t *cpu, bool state)
 {
     cpu->interrupt_line = state;
+    z80_update_int_pending(cpu);
 }
 
 void z80_handle_interrupt(struct z80_t *cpu)
@@ -122,7 +473,9 @@ void z80_handle_interrupt(struct z80_t *cpu)
             cpu->registers.PC = 0x0038;
             cpu->iff1 = false;
             cpu->iff2 = false;
-            cpu->cycles += 13;  // Interrupt acknowledge cycles
+            // Charged like an instruction of its own, between two others
+            cpu->cycle_count = Z80_TIMING_IM1_ACK;
+            cpu->cycles += cpu->cycle_count;
             break;
             
         case 2:
@@ -133,6 +486,7 @@ void z80_handle_interrupt(struct z80_t *cpu)
     
     // Clear interrupt line after acknowledgment
     cpu->interrupt_line = false;
+    cpu->int_pending = false;
 }
 
 void z80_check_interrupts(struct z80_t *cpu)
@@ -140,6 +494,82 @@ void z80_check_interrupts(struct z80_t *cpu)
     z80_handle_interrupt(cpu);
 }
 
+// A halted Z80 keeps running NOPs, 4 T-states and one R refresh each, until
+// an interrupt is accepted. Charge all of those up to the deadline at once.
+void z80_halt_until(struct z80_t *cpu, uint64_t deadline)
+{
+    if (cpu->cycles >= deadline)
+    {
+        return;
+    }
+
+    uint64_t nops = (deadline - cpu->cycles + 3) / 4;
+    cpu->cycles += nops * 4;
+    cpu->registers.R = (cpu->registers.R & 0x80) | ((cpu->registers.R + nops) & 0x7F);
+    cpu->halted_cycles += nops * 4;
+}
+
+// Mark a port whose reads have no side effects, or only ones that settle
+// after the first read, until the rest of the machine next runs
+void z80_idle_port(struct z80_t *cpu, uint8_t port)
+{
+    cpu->idle_ports[port >> 3] |= 1 << (port & 7);
+}
+
+// Called after every taken backward jump while idle_skip is set. Memory and
+// the idle ports only change between z80_run_cycles() slices, so once the
+// loop has come back to the same head twice in a row with the same
+// registers, the same iteration length and no writes, OUTs, other port
+// reads or reads that missed the page tables in between, every further
+// iteration in this slice is identical.
+// Those are skipped in one go, charging their cycles, up to the last
+// iteration that would still have started before the slice ends.
+void z80_idle_check(struct z80_t *cpu)
+{
+    uint64_t now = cpu->cycles; // the jump's own cycles are not added yet
+    uint64_t period = now - cpu->idle.arrived;
+    bool same = cpu->idle.head == cpu->registers.PC &&
+                cpu->idle.bus_events == cpu->bus_events &&
+                (cpu->idle.repeats == 0 || cpu->idle.period == period) &&
+#if Z80_LAZY_FLAGS
+                memcmp(cpu->idle.lazy_flags, &cpu->lazy_flags, sizeof(cpu->idle.lazy_flags)) == 0 &&
+#endif
+                memcmp(&cpu->idle.registers, &cpu->registers, sizeof(cpu->registers)) == 0;
+
+    cpu->idle.arrived = now;
+    if (!same)
+    {
+        cpu->idle.head = cpu->registers.PC;
+        cpu->idle.repeats = 0;
+        cpu->idle.bus_events = cpu->bus_events;
+        cpu->idle.registers = cpu->registers;
+#if Z80_LAZY_FLAGS
+        memcpy(cpu->idle.lazy_flags, &cpu->lazy_flags, sizeof(cpu->idle.lazy_flags));
+#endif
+        return;
+    }
+
+    cpu->idle.period = period;
+    if (cpu->idle.repeats < 2)
+    {
+        cpu->idle.repeats++;
+        if (cpu->idle.repeats < 2)
+            return;
+    }
+
+    // A pending interrupt would end the loop; verification, the debugger,
+    // the trace, the opcode histogram, the execute hook and breakpoints
+    // need every instruction to run
+    if (cpu->int_pending || cpu->bus_log || cpu->debug || cpu->trace || cpu->stats ||
+        cpu->on_execute || cpu->breakpoint_count || period == 0 || now + period >= cpu->slice_end)
+        return;
+
+    uint64_t skip = (cpu->slice_end - now - 1) / period * period;
+    cpu->cycles += skip;
+    cpu->idle.arrived += skip;
+    cpu->idle_skipped += skip;
+}
+
 int z80_step(struct z80_t *cpu)
 {
     if (cpu->halted || !cpu->running)
@@ -149,21 +579,24 @@ int z80_step(struct z80_t *cpu)
 
     cpu->cycle_count = 0; // Reset cycle counter
 
-    uint8_t opcode = z80_fetch_opcode(cpu); // 4 cycles (opcode fetch)
+    uint8_t opcode = z80_fetch_opcode(cpu);
+    z80_stats_count(cpu, Z80_STATS_BASE, opcode);
 
     z80_execute_instruction(cpu, opcode);
+    z80_sync_flags(cpu); // callers inspect F between steps
 
     cpu->cycles += cpu->cycle_count;
+    z80_stats_retire(cpu);
     return cpu->cycle_count;
 }
 
 void z80_init(struct z80_t *cpu)
 {
-    init_parity_table();
     // Initialize all registers to 0
     cpu->registers.PC = 0x0000;
     cpu->registers.SP = 0xFFFF; // Stack typically starts at top of memory
     cpu->registers.AF = 0x0000;
+    z80_flags_written(cpu);
     cpu->registers.BC = 0x0000;
     cpu->registers.DE = 0x0000;
     cpu->registers.HL = 0x0000;
@@ -179,6 +612,28 @@ void z80_init(struct z80_t *cpu)
     cpu->int_mode = 0;
     cpu->cycles = 0;
     cpu->running = true;
+    cpu->read_pages = z80_unmapped_pages;
+    cpu->write_pages = z80_unmapped_pages;
+    cpu->page_banks = NULL;
+    cpu->block_cache = NULL;
+    cpu->code_pages = 0;
+    cpu->jit = NULL;
+    cpu->bus_log = NULL;
+    cpu->trace = NULL;
+    cpu->stats = NULL;
+    cpu->on_execute = NULL;
+    cpu->io_write_block = NULL;
+    cpu->idle_skip = false;
+    memset(cpu->idle_ports, 0, sizeof(cpu->idle_ports));
+    cpu->bus_events = 0;
+    cpu->slice_end = 0;
+    cpu->idle_skipped = 0;
+    cpu->halted_cycles = 0;
+    cpu->idle.head = 0;
+    cpu->idle.repeats = 0;
+    cpu->int_pending = false;
+    cpu->exit_reason = 0;
+    cpu->breakpoint_count = 0;
     // cpu->debug = true;
 }
 
@@ -191,23 +646,183 @@ void z80_reset(struct z80_t *cpu)
     cpu->iff2 = false;
     cpu->int_mode = 0;
     cpu->running = true;
+    z80_update_int_pending(cpu);
 }
 
 
 void z80_run_cycles(struct z80_t *cpu, uint64_t target_cycles)
 {
-    uint64_t start_cycles = cpu->cycles;
+    z80_run_until(cpu, cpu->cycles + target_cycles);
+}
+
+// Ask the running loop to hand control back after the current instruction,
+// e.g. from a port handler whose write the rest of the machine must see now.
+// Block runners notice through the cache's dirty flag.
+void z80_request_exit(struct z80_t *cpu)
+{
+    cpu->exit_reason = Z80_RUN_IO_EVENT;
+    if (cpu->block_cache)
+    {
+        cpu->block_cache->dirty = true;
+    }
+}
+
+bool z80_set_breakpoint(struct z80_t *cpu, uint16_t addr)
+{
+    return z80_set_breakpoint_range(cpu, addr, addr);
+}
 
-    while ((cpu->cycles - start_cycles) < target_cycles && cpu->running && !cpu->halted)
+// Stop whenever PC is within start..end
+bool z80_set_breakpoint_range(struct z80_t *cpu, uint16_t start, uint16_t end)
+{
+    if (cpu->breakpoint_count >= Z80_MAX_BREAKPOINTS)
     {
-        z80_check_interrupts(cpu);
-        if (cpu->debug)
+        return false;
+    }
+    cpu->breakpoints[cpu->breakpoint_count].start = start;
+    cpu->breakpoints[cpu->breakpoint_count].end = end;
+    cpu->breakpoint_count++;
+    return true;
+}
+
+// Remove one breakpoint set with exactly this range
+void z80_clear_breakpoint_range(struct z80_t *cpu, uint16_t start, uint16_t end)
+{
+    for (int i = 0; i < cpu->breakpoint_count; i++)
+    {
+        if (cpu->breakpoints[i].start == start && cpu->breakpoints[i].end == end)
         {
-            z80_disassemble_instruction(cpu);
+            cpu->breakpoints[i] = cpu->breakpoints[--cpu->breakpoint_count];
+            return;
         }
-        // Check for interrupts
+    }
+}
+
+void z80_clear_breakpoints(struct z80_t *cpu)
+{
+    cpu->breakpoint_count = 0;
+}
+
+static bool at_breakpoint(struct z80_t *cpu)
+{
+    uint16_t pc = cpu->registers.PC;
+    for (int i = 0; i < cpu->breakpoint_count; i++)
+    {
+        if (pc >= cpu->breakpoints[i].start && pc <= cpu->breakpoints[i].end)
+            return true;
+    }
+    return false;
+}
+
+// Debug/trace variant of z80_run_until(): one instruction at a time with
+// the trace recorder, the opcode histogram, the execute hook, the disassembler
+// and breakpoints. A breakpoint at the starting PC does not fire, so the
+// caller can resume from it.
+static enum z80_run_reason run_until_debug(struct z80_t *cpu, uint64_t deadline)
+{
+    bool first = true;
+
+    while (cpu->cycles < deadline)
+    {
+        if (!cpu->running)
+            return Z80_RUN_STOPPED;
+        if (cpu->int_pending)
+            z80_check_interrupts(cpu);
+        if (cpu->halted)
+        {
+            z80_halt_until(cpu, deadline);
+            return Z80_RUN_HALT;
+        }
+        if (!first && at_breakpoint(cpu))
+            return Z80_RUN_BREAKPOINT;
+        first = false;
+
+        if (cpu->trace)
+            z80_trace_record(cpu);
+        if (cpu->on_execute)
+            cpu->on_execute(cpu->memory_ctx, cpu->registers.PC);
+        if (cpu->debug)
+            z80_disassemble_instruction(cpu);
         z80_step(cpu);
+        if (cpu->exit_reason)
+            return cpu->exit_reason;
+    }
+    return Z80_RUN_DEADLINE;
+}
+
+#if !Z80_COMPUTED_GOTO
+// Switch-dispatch counterpart of z80_run_threaded()
+static void run_switch(struct z80_t *cpu, uint64_t deadline)
+{
+    do
+    {
+        cpu->cycle_count = 0;
+        z80_execute_instruction(cpu, z80_fetch_opcode(cpu));
+        cpu->cycles += cpu->cycle_count;
+    } while (cpu->cycles < deadline && cpu->running && !cpu->halted &&
+             !cpu->exit_reason && !cpu->int_pending);
+}
+#endif
+
+// Run until the absolute cycle count deadline and say why it stopped. The
+// interrupt line only changes between calls or through the few places that
+// update int_pending, so the inner loops never poll the interrupt logic.
+enum z80_run_reason z80_run_until(struct z80_t *cpu, uint64_t deadline)
+{
+    enum z80_run_reason reason = Z80_RUN_DEADLINE;
+
+    z80_update_int_pending(cpu);
+    cpu->slice_end = deadline;
+    cpu->exit_reason = 0;
+    if (cpu->debug || cpu->trace || cpu->stats || cpu->on_execute || cpu->breakpoint_count)
+    {
+        reason = run_until_debug(cpu, deadline);
+        cpu->exit_reason = 0;
+        z80_sync_flags(cpu);
+        return reason;
+    }
+
+    while (cpu->cycles < deadline)
+    {
+        if (!cpu->running)
+        {
+            reason = Z80_RUN_STOPPED;
+            break;
+        }
+        if (cpu->int_pending)
+            z80_check_interrupts(cpu);
+        if (cpu->halted)
+        {
+            // Still halted after the interrupt check: nothing can wake the
+            // CPU before the line next changes, which is after this call
+            z80_halt_until(cpu, deadline);
+            reason = Z80_RUN_HALT;
+            break;
+        }
+
+        if (cpu->jit)
+            z80_jit_run(cpu, deadline);
+        else if (cpu->block_cache)
+            // Decoded blocks through the interpreter handlers: what the
+            // recompiler is checked against, slower than either dispatcher
+            z80_run_blocks(cpu, deadline);
+        else
+#if Z80_COMPUTED_GOTO
+            // Runs handler-to-handler until the deadline or an event
+            z80_run_threaded(cpu, deadline);
+#else
+            run_switch(cpu, deadline);
+#endif
+
+        if (cpu->exit_reason)
+        {
+            reason = cpu->exit_reason;
+            break;
+        }
     }
+    cpu->exit_reason = 0;
+    z80_sync_flags(cpu);
+    return reason;
 }
 
 void z80_print_state(struct z80_t *cpu)
@@ -224,6 +839,7 @@ void z80_print_state(struct z80_t *cpu)
     //        cpu->running ? "ACTIVE" : "STOPPED",
     //        cpu->int_mode);
 
+    z80_sync_flags(cpu);
     printf("SP:%04X CYC:%llu AF:%04X BC:%04X DE:%04X HL:%04X "
         "IX:%04X IY:%04X I:%02X R:%02X\n",
         cpu->registers.SP, cpu->cycles,
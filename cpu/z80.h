@@ -4,6 +4,56 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include "z80_timing.h"
+
+// Threaded (computed-goto) dispatch relies on the GCC/Clang "labels as
+// values" extension; other compilers fall back to the switch dispatcher.
+#if defined(Z80_THREADED_DISPATCH) && (defined(__GNUC__) || defined(__clang__))
+#define Z80_COMPUTED_GOTO 1
+#else
+#define Z80_COMPUTED_GOTO 0
+#endif
+
+// Lazy flags: the common ALU ops record their inputs instead of building F,
+// and F is only rebuilt when something reads it. Off by default.
+#ifndef Z80_LAZY_FLAGS
+#define Z80_LAZY_FLAGS 0
+#endif
+
+// Direct memory map: the address space is split into 1KB pages, each either
+// a host pointer the core reads/writes in place or NULL to use the callbacks
+#define Z80_PAGE_SHIFT 10
+#define Z80_PAGE_SIZE  (1 << Z80_PAGE_SHIFT)
+#define Z80_PAGE_MASK  (Z80_PAGE_SIZE - 1)
+#define Z80_PAGE_COUNT (0x10000 >> Z80_PAGE_SHIFT)
+
+#define Z80_MAX_BREAKPOINTS 8
+
+// struct z80_t starts on a cache line so its hot section is one line
+#define Z80_CACHE_LINE 64
+#if defined(__GNUC__) || defined(__clang__)
+#define Z80_CACHE_ALIGNED __attribute__((aligned(Z80_CACHE_LINE)))
+#elif defined(_MSC_VER)
+#define Z80_CACHE_ALIGNED __declspec(align(Z80_CACHE_LINE))
+#else
+#define Z80_CACHE_ALIGNED
+#endif
+
+// Why z80_run_until() returned
+enum z80_run_reason
+{
+    Z80_RUN_DEADLINE,    // reached the deadline
+    Z80_RUN_HALT,        // halted, slept up to the deadline
+    Z80_RUN_BREAKPOINT,  // PC reached a breakpoint (debug loop)
+    Z80_RUN_IO_EVENT,    // a device asked for control back, see z80_request_exit()
+    Z80_RUN_STOPPED,     // CPU stopped on an unimplemented opcode
+};
+
+struct z80_block_cache;
+struct z80_jit;
+struct z80_bus_log;
+struct z80_trace;
+struct z80_opcode_stats;
 
 struct registers
 {
@@ -104,20 +154,49 @@ struct registers
     };
 };
 
-struct z80_t
+// The struct is grouped by how often the run loops touch it. The first cache
+// line is the state every instruction reads or writes; the second what
+// unmapped accesses, I/O and the slice loop touch. Everything after that is
+// set up once or only consulted by the debug paths.
+struct Z80_CACHE_ALIGNED z80_t
 {
+    // --- Hot: every instruction ---
     struct registers registers;
-    // CPU state
     bool halted;
     bool iff1, iff2;
-    uint8_t int_mode;
-    // Execution
-    uint64_t cycles;
-    uint8_t cycle_count;
     bool running;
+    // interrupt_line && iff1, updated wherever either changes so the run
+    // loops test a single flag between instructions
+    bool int_pending;
+    uint8_t exit_reason;     // enum z80_run_reason requested by a device, 0 = none
+    uint64_t cycles;
+    uint32_t cycle_count;    // T-states of the current instruction, see z80_timing.h
+#if Z80_LAZY_FLAGS
+    // Last flag-producing op and its inputs; registers.F is stale while
+    // op != Z80_FLAGS_NONE (see z80_flags.h)
+    struct
+    {
+        uint8_t op;
+        uint8_t a, b, c;
+    } lazy_flags;
+#endif
+    // Page tables published by the memory owner (Z80_PAGE_COUNT entries)
+    uint8_t *const *read_pages;
+    uint8_t *const *write_pages;
+
+    // --- Warm: unmapped accesses, I/O and once per z80_run_until() slice ---
+    uint64_t code_pages;     // pages holding decoded code, one bit per page
+    struct z80_bus_log *bus_log;
+    uint32_t bus_events;     // memory writes, reads missing the page tables, OUTs and reads of other ports
+    uint8_t idle_ports[32];  // ports whose reads repeat until the next event, one bit each
+    bool idle_skip;          // idle-loop fast-forward, see z80_idle_check()
     bool debug;
-    bool interrupt_line;
+    uint8_t breakpoint_count;
+    uint8_t int_mode;
+    uint64_t slice_end;      // deadline of the current z80_run_until() call
 
+    // --- Cold ---
+    bool interrupt_line;
     // Memory interface function pointers
     uint8_t (*read8)(void* context, uint16_t addr);
     uint16_t (*read16)(void* context, uint16_t addr);
@@ -125,8 +204,47 @@ struct z80_t
     void (*write16)(void* context, uint16_t addr, uint16_t value);
     uint8_t (*io_read8)(void* context, uint8_t port);
     void (*io_write8)(void* context, uint8_t port, uint8_t value);
+    // Optional: write a span to one port (OTIR) and return the bytes taken,
+    // fewer if one of them called z80_request_exit(); NULL = one io_write8 per byte
+    size_t (*io_write_block)(void* context, uint8_t port, const uint8_t *data, size_t size);
     void *io_ctx;
     void *memory_ctx;
+    // Bank id per page for keying decoded blocks (NULL = flat memory)
+    const uint16_t *page_banks;
+
+    // Decoded block cache, the recompiler's front end (NULL = none), see
+    // z80_block.h; attached together with jit
+    struct z80_block_cache *block_cache;
+    // Recompiler (NULL = interpreter), see z80_jit.h; bus_log above is its
+    // verification journal
+    struct z80_jit *jit;
+    // Instruction trace (NULL = off), recorded by the debug loop, see z80_trace.h
+    struct z80_trace *trace;
+    // Opcode histogram (NULL = off), counted by the debug loop, see z80_stats.h
+    struct z80_opcode_stats *stats;
+    // Called with memory_ctx before each instruction the debug loop runs
+    // (NULL = off), e.g. mmu_profile_execute()
+    void (*on_execute)(void *context, uint16_t pc);
+
+    uint64_t idle_skipped;   // cycles fast-forwarded so far
+    uint64_t halted_cycles;  // cycles spent in HALT so far
+    // PC ranges at which z80_run_until() stops; any set selects the debug loop
+    struct
+    {
+        uint16_t start, end;  // inclusive
+    } breakpoints[Z80_MAX_BREAKPOINTS];
+    struct
+    {
+        uint16_t head;       // target of the backward jump being watched
+        uint8_t repeats;     // identical iterations seen in a row
+        uint32_t bus_events;
+        uint64_t arrived;    // cycles at the last arrival
+        uint64_t period;     // cycles per iteration
+        struct registers registers;
+#if Z80_LAZY_FLAGS
+        uint8_t lazy_flags[4];
+#endif
+    } idle;
 };
 
 void z80_init(struct z80_t* cpu);
@@ -137,15 +255,23 @@ void z80_execute_cb_instruction(struct z80_t *cpu, uint8_t opcode);
 void z80_execute_ed_instruction(struct z80_t *cpu, uint8_t opcode);
 void z80_execute_fd_instruction(struct z80_t *cpu, uint8_t opcode);
 void z80_execute_dd_instruction(struct z80_t *cpu, uint8_t opcode);
-void z80_execute_dd_cb_instruction(struct z80_t *cpu, int8_t d);
-void z80_execute_fd_cb_instruction(struct z80_t *cpu, int8_t d);
 void z80_run_cycles(struct z80_t* cpu, uint64_t target_cycles);
+enum z80_run_reason z80_run_until(struct z80_t *cpu, uint64_t deadline);
+void z80_request_exit(struct z80_t *cpu);
+bool z80_set_breakpoint(struct z80_t *cpu, uint16_t addr);
+bool z80_set_breakpoint_range(struct z80_t *cpu, uint16_t start, uint16_t end);
+void z80_clear_breakpoint_range(struct z80_t *cpu, uint16_t start, uint16_t end);
+void z80_clear_breakpoints(struct z80_t *cpu);
+#if Z80_COMPUTED_GOTO
+void z80_run_threaded(struct z80_t *cpu, uint64_t deadline);
+#endif
 void z80_print_state(struct z80_t* cpu);
 void z80_write8(struct z80_t *cpu, uint16_t addr, uint8_t  data);
 void z80_write16(struct z80_t *cpu, uint16_t addr, uint16_t data);
 uint8_t z80_read8(struct z80_t* cpu, uint16_t addr);
 uint16_t z80_read16(struct z80_t* cpu, uint16_t addr);
 void z80_disassemble_instruction(struct z80_t *cpu);
+int z80_dasm_format(const uint8_t *bytes, char *buffer, size_t buffer_size);
 void z80_disassemble_instruction_verbose(struct z80_t *cpu, char *buffer, size_t buffer_size);
 void z80_stack_push8(struct z80_t *cpu, uint8_t value);
 void z80_stack_push16(struct z80_t *cpu, uint16_t value);
@@ -163,4 +289,16 @@ uint8_t z80_fetch_opcode(struct z80_t *cpu);
 void z80_set_interrupt_line(struct z80_t *cpu, bool state);
 void z80_handle_interrupt(struct z80_t *cpu);
 void z80_check_interrupts(struct z80_t *cpu);
+void z80_sync_flags(struct z80_t *cpu);
+uint32_t z80_bulk_iterations(struct z80_t *cpu, uint32_t remaining, uint32_t cycles_per_iteration);
+uint32_t z80_bulk_copy(struct z80_t *cpu, uint32_t count, int step, uint32_t cycles_per_iteration);
+uint32_t z80_bulk_out(struct z80_t *cpu, uint32_t count, uint32_t cycles_per_iteration);
+void z80_halt_until(struct z80_t *cpu, uint64_t deadline);
+void z80_idle_port(struct z80_t *cpu, uint8_t port);
+void z80_idle_check(struct z80_t *cpu);
+
+static inline void z80_update_int_pending(struct z80_t *cpu)
+{
+    cpu->int_pending = cpu->interrupt_line && cpu->iff1;
+}
 #endif
\ No newline at end of file
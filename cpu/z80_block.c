@@ -0,0 +1,652 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "z80_block.h"
+#include "z80_op.h"
+#include "z80_flags.h"
+#include "z80_opcode_table.h"
+
+// Unprefixed opcodes after which a block must end: anything that can move
+// PC (jumps, calls, returns, RST, DJNZ), HALT, and EI/DI, which change
+// whether an interrupt may be taken before the next instruction
+static const bool base_ends_block[256] =
+{
+    [0x10] = true, [0x18] = true, [0x20] = true, [0x28] = true,
+    [0x30] = true, [0x38] = true, [0x76] = true,
+    [0xC0] = true, [0xC2] = true, [0xC3] = true, [0xC4] = true, [0xC7] = true,
+    [0xC8] = true, [0xC9] = true, [0xCA] = true, [0xCC] = true, [0xCD] = true, [0xCF] = true,
+    [0xD0] = true, [0xD2] = true, [0xD4] = true, [0xD7] = true,
+    [0xD8] = true, [0xDA] = true, [0xDC] = true, [0xDF] = true,
+    [0xE0] = true, [0xE2] = true, [0xE4] = true, [0xE7] = true,
+    [0xE8] = true, [0xE9] = true, [0xEA] = true, [0xEC] = true, [0xEF] = true,
+    [0xF0] = true, [0xF2] = true, [0xF3] = true, [0xF4] = true, [0xF7] = true,
+    [0xF8] = true, [0xFA] = true, [0xFB] = true, [0xFC] = true, [0xFF] = true,
+};
+
+// ED opcodes that end a block: RETN/RETI and their mirrors, and the
+// repeating block instructions, which loop by rewinding PC
+static bool ed_ends_block(uint8_t opcode)
+{
+    if ((opcode & 0xC7) == 0x45)
+        return true;
+    return (opcode & 0xF4) == 0xB0;
+}
+
+static inline uint16_t block_bank(struct z80_t *cpu, uint16_t pc)
+{
+    return cpu->page_banks ? cpu->page_banks[pc >> Z80_PAGE_SHIFT] : 0;
+}
+
+static inline uint32_t block_index(uint32_t key)
+{
+    return (key ^ (key >> 13)) & (Z80_BLOCK_CACHE_SIZE - 1);
+}
+
+// Bytes are read straight from the page tables or the read callback so
+// decoding neither costs T-states nor disturbs cycle_count
+static uint8_t block_peek(struct z80_t *cpu, uint16_t addr)
+{
+    uint8_t *page = cpu->read_pages[addr >> Z80_PAGE_SHIFT];
+    if (page)
+    {
+        return page[addr & Z80_PAGE_MASK];
+    }
+    return cpu->read8(cpu->memory_ctx, addr);
+}
+
+// Decode one instruction at pc from its raw bytes (at least four, read
+// ahead of the instruction) into op; returns true if it ends the block
+static bool block_decode_op(const uint8_t *raw, uint16_t pc, struct z80_block_op *op)
+{
+    uint8_t opcode = raw[0];
+    uint8_t next = raw[1];
+    bool ends = false;
+
+    op->pc = pc;
+    switch (opcode)
+    {
+    case 0xCB:
+        op->execute = z80_execute_cb_instruction;
+        op->opcode = next;
+        op->length = 2;
+        break;
+
+    case 0xED:
+        op->execute = z80_execute_ed_instruction;
+        op->opcode = next;
+        op->length = ed_opcode_table[next].length;
+        ends = ed_ends_block(next);
+        break;
+
+    case 0xDD:
+    case 0xFD:
+        op->execute = opcode == 0xDD ? z80_execute_dd_instruction : z80_execute_fd_instruction;
+        op->opcode = next;
+        op->length = next == 0xCB ? 4 : (opcode == 0xDD ? dd_opcode_table : fd_opcode_table)[next].length;
+        // JP (IX)/(IY), chained prefixes and unprefixed flow opcodes behind a
+        // prefix all go back to the plain interpreter
+        ends = base_ends_block[next] || next == 0xDD || next == 0xED || next == 0xFD;
+        break;
+
+    default:
+        op->execute = z80_execute_instruction;
+        op->opcode = opcode;
+        op->length = opcode_table[opcode].length;
+        op->fetch_length = 1;
+        ends = base_ends_block[opcode];
+        break;
+    }
+
+    if (opcode == 0xCB || opcode == 0xED || opcode == 0xDD || opcode == 0xFD)
+    {
+        op->fetch_length = 2;
+    }
+    if (op->length < op->fetch_length || op->length > sizeof(op->bytes))
+    {
+        op->length = op->fetch_length;
+        ends = true;
+    }
+
+    memcpy(op->bytes, raw, op->length);
+    return ends;
+}
+
+// Superinstruction handlers. Each runs its ops the way z80_block_execute()
+// would run them one after the other: PC steps over every opcode byte, the
+// T-states come from the same tables and the cycles of an op are committed
+// before the next one starts, so flags, timing and idle-loop detection are
+// unchanged. They also stop between ops at the slice deadline or on
+// z80_request_exit(); PC then no longer matches the op after the fused run
+// and the block ends there.
+
+static const size_t fuse_reg8_offset[8] =
+{
+    offsetof(struct z80_t, registers.B), offsetof(struct z80_t, registers.C),
+    offsetof(struct z80_t, registers.D), offsetof(struct z80_t, registers.E),
+    offsetof(struct z80_t, registers.H), offsetof(struct z80_t, registers.L),
+    0, offsetof(struct z80_t, registers.A),
+};
+
+static inline uint8_t *fuse_reg8(struct z80_t *cpu, uint8_t r)
+{
+    return (uint8_t *)cpu + fuse_reg8_offset[r];
+}
+
+// Retire the op that just ran and start the next one, unless the slice is
+// over or a port handler asked for control back
+static inline bool fuse_next(struct z80_t *cpu, uint8_t opcode)
+{
+    cpu->cycles += cpu->cycle_count;
+    cpu->cycle_count = 0;
+    if (cpu->cycles >= cpu->slice_end || cpu->exit_reason)
+        return false;
+    cpu->registers.PC++;
+    cpu->cycle_count = z80_timing_base[opcode];
+    return true;
+}
+
+static inline bool fuse_jr_condition(struct z80_t *cpu, uint8_t jr)
+{
+    return jr == 0x28 ? IS_Z_SET(cpu) : IS_Z_UNSET(cpu);
+}
+
+// DEC r / JR NZ,e; opcode is the DEC
+static void fused_dec_jr(struct z80_t *cpu, uint8_t opcode)
+{
+    uint8_t *r = fuse_reg8(cpu, opcode >> 3);
+
+    cpu->cycle_count += z80_timing_base[opcode];
+    *r = z80_op_dec8(cpu, *r);
+    if (fuse_next(cpu, 0x20))
+        z80_op_jr(cpu, IS_Z_UNSET(cpu));
+}
+
+// LD A,(nn) / AND n / JR Z|NZ,e; opcode is the JR
+static void fused_ld_and_jr(struct z80_t *cpu, uint8_t opcode)
+{
+    cpu->cycle_count += z80_timing_base[0x3A];
+    cpu->registers.A = z80_read8(cpu, z80_fetch16(cpu));
+    if (!fuse_next(cpu, 0xE6))
+        return;
+    z80_op_and(cpu, z80_fetch8(cpu));
+    if (fuse_next(cpu, opcode))
+        z80_op_jr(cpu, fuse_jr_condition(cpu, opcode));
+}
+
+// IN A,(n) / AND n / JR Z|NZ,e; opcode is the JR
+static void fused_in_and_jr(struct z80_t *cpu, uint8_t opcode)
+{
+    cpu->cycle_count += z80_timing_base[0xDB];
+    uint8_t port = z80_fetch8(cpu);
+    cpu->registers.A = z80_port_in(cpu, port);
+    if (!fuse_next(cpu, 0xE6))
+        return;
+    z80_op_and(cpu, z80_fetch8(cpu));
+    if (fuse_next(cpu, opcode))
+        z80_op_jr(cpu, fuse_jr_condition(cpu, opcode));
+}
+
+// IN A,(n) / CP n / JR Z|NZ,e; opcode is the JR
+static void fused_in_cp_jr(struct z80_t *cpu, uint8_t opcode)
+{
+    cpu->cycle_count += z80_timing_base[0xDB];
+    uint8_t port = z80_fetch8(cpu);
+    cpu->registers.A = z80_port_in(cpu, port);
+    if (!fuse_next(cpu, 0xFE))
+        return;
+    z80_op_cp(cpu, cpu->registers.A, z80_fetch8(cpu));
+    if (fuse_next(cpu, opcode))
+        z80_op_jr(cpu, fuse_jr_condition(cpu, opcode));
+}
+
+// LD A,(HL) / OUT (n),A / INC HL, the body of unrolled VRAM uploads
+static void fused_ld_out_inc(struct z80_t *cpu, uint8_t opcode)
+{
+    (void)opcode;
+    cpu->cycle_count += z80_timing_base[0x7E];
+    cpu->registers.A = z80_read8(cpu, cpu->registers.HL);
+    if (!fuse_next(cpu, 0xD3))
+        return;
+    uint8_t port = z80_fetch8(cpu);
+    z80_port_out(cpu, port, cpu->registers.A);
+    if (fuse_next(cpu, 0x23))
+        cpu->registers.HL++;
+}
+
+static inline bool is_base_op(const struct z80_block_op *op, const struct z80_block_op *end, uint8_t opcode)
+{
+    return op < end && op->execute == z80_execute_instruction && op->opcode == opcode;
+}
+
+static inline bool is_jr_z_nz(const struct z80_block_op *op, const struct z80_block_op *end)
+{
+    return is_base_op(op, end, 0x20) || is_base_op(op, end, 0x28);
+}
+
+// Mark the runs of a decoded block that match an enabled superinstruction
+static void block_fuse(struct z80_block_cache *cache, struct z80_block *block)
+{
+    struct z80_block_op *end = block->ops + block->count;
+
+    for (struct z80_block_op *op = block->ops; op < end; op++)
+    {
+        void (*handler)(struct z80_t *cpu, uint8_t opcode) = NULL;
+        enum z80_fusion kind = Z80_FUSION_COUNT;
+        uint8_t opcode = op->opcode;
+        uint8_t fused = 0;
+
+        op->fused = 0;
+        if (op->execute != z80_execute_instruction)
+            continue;
+
+        if ((opcode & 0xC7) == 0x05 && opcode != 0x35 && is_base_op(op + 1, end, 0x20))
+        {
+            kind = Z80_FUSE_DEC_JR;
+            handler = fused_dec_jr;
+            fused = 1;
+        }
+        else if (opcode == 0x3A && is_base_op(op + 1, end, 0xE6) && is_jr_z_nz(op + 2, end))
+        {
+            kind = Z80_FUSE_LD_AND_JR;
+            handler = fused_ld_and_jr;
+            opcode = op[2].opcode;
+            fused = 2;
+        }
+        else if (opcode == 0xDB && (is_base_op(op + 1, end, 0xE6) || is_base_op(op + 1, end, 0xFE)) &&
+                 is_jr_z_nz(op + 2, end))
+        {
+            kind = Z80_FUSE_IN_TEST_JR;
+            handler = op[1].opcode == 0xE6 ? fused_in_and_jr : fused_in_cp_jr;
+            opcode = op[2].opcode;
+            fused = 2;
+        }
+        else if (opcode == 0x7E && is_base_op(op + 1, end, 0xD3) && is_base_op(op + 2, end, 0x23))
+        {
+            kind = Z80_FUSE_LD_OUT_INC;
+            handler = fused_ld_out_inc;
+            fused = 2;
+        }
+
+        if (!handler || !(cache->fusions & (1u << kind)))
+            continue;
+
+        op->execute = handler;
+        op->opcode = opcode;
+        op->fused = fused;
+        cache->fused[kind]++;
+        op += fused;
+    }
+}
+
+// Publish a freshly built block: record the page generations and the bank
+// of its tail page it is valid under, and route writes to its pages through
+// the invalidating slow path
+static void block_commit(struct z80_t *cpu, struct z80_block *block, uint8_t first_page, uint8_t last_page)
+{
+    struct z80_block_cache *cache = cpu->block_cache;
+
+    block->first_page = first_page;
+    block->last_page = last_page;
+    block->last_bank = last_page == first_page ? block->key >> 16
+                                               : block_bank(cpu, last_page << Z80_PAGE_SHIFT);
+    block->first_gen = cache->page_gen[first_page];
+    block->last_gen = cache->page_gen[last_page];
+    block->valid = true;
+    cpu->code_pages |= (1ULL << first_page) | (1ULL << last_page);
+    cache->write_pages[first_page] = NULL;
+    cache->write_pages[last_page] = NULL;
+}
+
+static void block_decode(struct z80_t *cpu, struct z80_block *block, uint32_t key, uint16_t pc)
+{
+    struct z80_block_cache *cache = cpu->block_cache;
+    uint8_t first_page = pc >> Z80_PAGE_SHIFT;
+    uint8_t last_page = first_page;
+
+    block->key = key;
+    block->count = 0;
+    block->native = NULL;
+    while (block->count < Z80_BLOCK_MAX_OPS)
+    {
+        struct z80_block_op *op = &block->ops[block->count++];
+        uint8_t raw[4];
+        for (int i = 0; i < 4; i++)
+        {
+            raw[i] = block_peek(cpu, pc + i);
+        }
+        bool ends = block_decode_op(raw, pc, op);
+
+        last_page = (uint16_t)(pc + op->length - 1) >> Z80_PAGE_SHIFT;
+        pc += op->length;
+        // Stay within one page (plus the tail of the last instruction) so a
+        // write only has to invalidate the pages it touches
+        if (ends || (pc >> Z80_PAGE_SHIFT) != first_page)
+            break;
+    }
+
+    block_fuse(cache, block);
+    block_commit(cpu, block, first_page, last_page);
+    cache->decodes++;
+}
+
+struct z80_block_cache *z80_block_cache_create(void)
+{
+    struct z80_block_cache *cache = calloc(1, sizeof(struct z80_block_cache));
+    if (cache)
+    {
+        cache->fusions = Z80_FUSE_ALL;
+    }
+    return cache;
+}
+
+void z80_block_cache_destroy(struct z80_block_cache *cache)
+{
+    free(cache);
+}
+
+// Attach a cache to the CPU (or detach with NULL). The host page tables must
+// be in place first; the CPU's write table is swapped for the cache's copy.
+void z80_block_cache_attach(struct z80_t *cpu, struct z80_block_cache *cache)
+{
+    if (cpu->block_cache)
+    {
+        cpu->write_pages = cpu->block_cache->host_write_pages;
+    }
+    cpu->block_cache = cache;
+    cpu->code_pages = 0;
+    if (cache)
+    {
+        cache->host_write_pages = cpu->write_pages;
+        cpu->write_pages = cache->write_pages;
+        z80_block_cache_flush(cpu);
+    }
+}
+
+// Drop every block, e.g. after a new ROM is loaded
+void z80_block_cache_flush(struct z80_t *cpu)
+{
+    struct z80_block_cache *cache = cpu->block_cache;
+    if (!cache)
+        return;
+
+    for (int i = 0; i < Z80_BLOCK_CACHE_SIZE; i++)
+    {
+        cache->blocks[i].valid = false;
+    }
+    for (int page = 0; page < Z80_PAGE_COUNT; page++)
+    {
+        cache->write_pages[page] = cache->host_write_pages[page];
+    }
+    cache->dirty = true;
+    cpu->code_pages = 0;
+}
+
+// Called from the write path when a page holding decoded code is written
+void z80_block_invalidate_page(struct z80_t *cpu, uint8_t page)
+{
+    struct z80_block_cache *cache = cpu->block_cache;
+
+    cpu->code_pages &= ~(1ULL << page);
+    if (!cache)
+        return;
+
+    cache->page_gen[page]++;
+    cache->write_pages[page] = cache->host_write_pages[page];
+    cache->dirty = true;
+}
+
+struct z80_block *z80_block_lookup(struct z80_t *cpu, uint16_t pc)
+{
+    struct z80_block_cache *cache = cpu->block_cache;
+    uint32_t key = ((uint32_t)block_bank(cpu, pc) << 16) | pc;
+    struct z80_block *block = &cache->blocks[block_index(key)];
+
+    // The key holds the first page's bank; a block whose last instruction
+    // runs into the next page also needs that page's bank unchanged
+    if (block->valid && block->key == key &&
+        block->first_gen == cache->page_gen[block->first_page] &&
+        block->last_gen == cache->page_gen[block->last_page] &&
+        block->last_bank == block_bank(cpu, block->last_page << Z80_PAGE_SHIFT))
+    {
+        cache->hits++;
+        return block;
+    }
+
+    block_decode(cpu, block, key, pc);
+    return block;
+}
+
+// Run one block through the interpreter handlers, stopping early at the
+// deadline, on HALT/stop, or when a write invalidated decoded code
+void z80_block_execute(struct z80_t *cpu, const struct z80_block *block, uint64_t deadline)
+{
+    struct z80_block_cache *cache = cpu->block_cache;
+    const struct z80_block_op *op = block->ops;
+    const struct z80_block_op *end = op + block->count;
+
+    cache->dirty = false;
+    do
+    {
+        cpu->registers.PC += op->fetch_length;
+        cpu->cycle_count = 0;
+        op->execute(cpu, op->opcode);
+        cpu->cycles += cpu->cycle_count;
+
+        if (cpu->cycles >= deadline || cpu->halted || !cpu->running || cache->dirty)
+            break;
+        op += op->fused;
+    } while (++op < end && cpu->registers.PC == op->pc);
+}
+
+// Block-at-a-time interpreter, the reference for the recompiled blocks (see
+// jit_verify()). It is slower than plain dispatch, since the handlers still
+// fetch their own operands, so only a cache without a JIT ever runs it.
+// Interrupts are only sampled between blocks:
+// the line only changes outside z80_run_cycles and every instruction that
+// touches IFF1 ends its block, so this matches per-instruction sampling.
+void z80_run_blocks(struct z80_t *cpu, uint64_t deadline)
+{
+    while (cpu->cycles < deadline && cpu->running && !cpu->halted && !cpu->exit_reason)
+    {
+        if (cpu->int_pending)
+            z80_check_interrupts(cpu);
+
+        z80_block_execute(cpu, z80_block_lookup(cpu, cpu->registers.PC), deadline);
+    }
+}
+
+// FNV-1a, used for the ROM key and the core fingerprint of the block file
+uint64_t z80_block_hash(const void *data, size_t size, uint64_t hash)
+{
+    const uint8_t *bytes = data;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash = (hash ^ bytes[i]) * 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+// Fingerprint of everything a stored block depends on besides the ROM: the
+// format version and the tables the decoder derives lengths and block ends
+// from, so a core that decodes differently never picks up a stale file
+static uint64_t block_core_id(void)
+{
+    uint64_t hash = z80_block_hash(NULL, 0, Z80_BLOCK_HASH_SEED);
+    uint32_t version = Z80_BLOCK_FILE_VERSION;
+    uint8_t lengths[4][256];
+
+    for (int i = 0; i < 256; i++)
+    {
+        lengths[0][i] = opcode_table[i].length;
+        lengths[1][i] = ed_opcode_table[i].length | (ed_ends_block(i) << 7);
+        lengths[2][i] = dd_opcode_table[i].length | (base_ends_block[i] << 7);
+        lengths[3][i] = fd_opcode_table[i].length;
+    }
+    hash = z80_block_hash(&version, sizeof(version), hash);
+    return z80_block_hash(lengths, sizeof(lengths), hash);
+}
+
+struct z80_block_file_header
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t core_id;
+    uint64_t rom_hash;
+    uint32_t count;
+    uint32_t max_ops;
+};
+
+// Only blocks that live in one ROM page are stored: their key names the bank
+// and the ROM hash pins its contents. RAM blocks and blocks straddling two
+// pages (which may belong to different banks) are decoded again at run time.
+static bool block_persistent(const struct z80_block_cache *cache, const struct z80_block *block)
+{
+    return block->valid &&
+           (block->key >> 16) < Z80_BANK_RAM_FIRST &&
+           block->first_page == block->last_page &&
+           block->first_gen == cache->page_gen[block->first_page];
+}
+
+// Write every storable block to path. The file is written under a temporary
+// name and renamed over the old one so concurrent instances never read a
+// partial file.
+bool z80_block_cache_save(struct z80_t *cpu, const char *path, uint64_t rom_hash)
+{
+    struct z80_block_cache *cache = cpu->block_cache;
+    if (!cache || !path)
+        return false;
+
+    char temp_path[1024];
+    snprintf(temp_path, sizeof(temp_path), "%s.tmp", path);
+    FILE *file = fopen(temp_path, "wb");
+    if (!file)
+    {
+        printf("Failed to write block cache: %s\n", temp_path);
+        return false;
+    }
+
+    struct z80_block_file_header header =
+    {
+        .magic = Z80_BLOCK_FILE_MAGIC,
+        .version = Z80_BLOCK_FILE_VERSION,
+        .core_id = block_core_id(),
+        .rom_hash = rom_hash,
+        .count = 0,
+        .max_ops = Z80_BLOCK_MAX_OPS,
+    };
+    for (int i = 0; i < Z80_BLOCK_CACHE_SIZE; i++)
+    {
+        header.count += block_persistent(cache, &cache->blocks[i]);
+    }
+
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+    for (int i = 0; i < Z80_BLOCK_CACHE_SIZE && ok; i++)
+    {
+        const struct z80_block *block = &cache->blocks[i];
+        if (!block_persistent(cache, block))
+            continue;
+
+        // Record: key, op count, byte count, then the block's raw bytes
+        uint8_t record[4 + 2 + Z80_BLOCK_MAX_OPS * 4];
+        size_t size = 6;
+        memcpy(record, &block->key, 4);
+        for (int j = 0; j < block->count; j++)
+        {
+            memcpy(&record[size], block->ops[j].bytes, block->ops[j].length);
+            size += block->ops[j].length;
+        }
+        record[4] = block->count;
+        record[5] = (uint8_t)(size - 6);
+        ok = fwrite(record, size, 1, file) == 1;
+    }
+
+    if (fclose(file) != 0 || !ok)
+    {
+        printf("Failed to write block cache: %s\n", temp_path);
+        remove(temp_path);
+        return false;
+    }
+    if (rename(temp_path, path) != 0)
+    {
+        // Windows refuses to rename over an existing file
+        remove(path);
+        if (rename(temp_path, path) != 0)
+        {
+            printf("Failed to replace block cache: %s\n", path);
+            remove(temp_path);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Rebuild the blocks stored in path for the ROM with the given hash. A file
+// from another ROM or another core version is ignored; nothing is loaded
+// from a file that turns out to be damaged past its header.
+bool z80_block_cache_load(struct z80_t *cpu, const char *path, uint64_t rom_hash)
+{
+    struct z80_block_cache *cache = cpu->block_cache;
+    if (!cache || !path)
+        return false;
+
+    FILE *file = fopen(path, "rb");
+    if (!file)
+        return false;
+
+    struct z80_block_file_header header;
+    if (fread(&header, sizeof(header), 1, file) != 1 ||
+        header.magic != Z80_BLOCK_FILE_MAGIC ||
+        header.version != Z80_BLOCK_FILE_VERSION ||
+        header.core_id != block_core_id() ||
+        header.max_ops != Z80_BLOCK_MAX_OPS ||
+        header.rom_hash != rom_hash)
+    {
+        printf("Ignoring stale block cache: %s\n", path);
+        fclose(file);
+        return false;
+    }
+
+    uint32_t loaded = 0;
+    for (uint32_t n = 0; n < header.count; n++)
+    {
+        uint8_t record[6 + Z80_BLOCK_MAX_OPS * 4 + 4] = {0};
+        uint32_t key;
+        if (fread(record, 6, 1, file) != 1 ||
+            record[4] == 0 || record[4] > Z80_BLOCK_MAX_OPS ||
+            record[5] > Z80_BLOCK_MAX_OPS * 4 ||
+            fread(&record[6], record[5], 1, file) != 1)
+            break;
+        memcpy(&key, record, 4);
+
+        // Decode straight from the stored bytes; the ops must use them up
+        // exactly and stay on the block's page or the record is rejected
+        struct z80_block *block = &cache->blocks[block_index(key)];
+        uint16_t pc = key & 0xFFFF;
+        uint8_t page = pc >> Z80_PAGE_SHIFT;
+        size_t offset = 6;
+        bool ends = false;
+
+        block->valid = false;
+        block->native = NULL;
+        block->count = 0;
+        while (block->count < record[4] && offset < 6u + record[5] && !ends)
+        {
+            struct z80_block_op *op = &block->ops[block->count++];
+            ends = block_decode_op(&record[offset], pc, op);
+            offset += op->length;
+            pc += op->length;
+        }
+        if (block->count != record[4] || offset != 6u + record[5] ||
+            (uint16_t)(pc - 1) >> Z80_PAGE_SHIFT != page)
+            break;
+
+        block->key = key;
+        block_fuse(cache, block);
+        block_commit(cpu, block, page, page);
+        loaded++;
+    }
+    fclose(file);
+
+    cache->loaded += loaded;
+    return loaded == header.count;
+}
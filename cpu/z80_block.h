@@ -0,0 +1,97 @@
+#ifndef Z80_BLOCK_H_
+#define Z80_BLOCK_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "z80.h"
+
+#define Z80_BLOCK_MAX_OPS     16
+#define Z80_BLOCK_CACHE_SIZE  4096  // direct-mapped, power of two
+#define Z80_BANK_RAM          0xFFFF  // system RAM
+#define Z80_BANK_RAM_FIRST    0xFF00  // bank ids from here up are RAM, never stored
+
+// On-disk block file (see z80_block_cache_save). Bump the version whenever
+// the layout or the meaning of a stored block changes.
+#define Z80_BLOCK_FILE_MAGIC    0x4B4C4243u  // "CBLK"
+#define Z80_BLOCK_FILE_VERSION  1
+#define Z80_BLOCK_HASH_SEED     0xCBF29CE484222325ULL
+
+// Superinstructions: short idioms the decoder hands to a single handler
+// that runs them back to back, see block_fuse(). Each can be turned off
+// through z80_block_cache.fusions. They exist only in decoded blocks, so
+// the default switch and threaded loops never see them: they need the block
+// cache, which ships as the front end of the recompiler (z80_jit.h). The
+// same idioms fused in the interpreter loops measured no faster, the extra
+// peek at the next opcode costing what the saved dispatch wins.
+enum z80_fusion
+{
+    Z80_FUSE_DEC_JR,       // DEC r / JR NZ,e
+    Z80_FUSE_LD_AND_JR,    // LD A,(nn) / AND n / JR Z|NZ,e
+    Z80_FUSE_IN_TEST_JR,   // IN A,(n) / AND n|CP n / JR Z|NZ,e
+    Z80_FUSE_LD_OUT_INC,   // LD A,(HL) / OUT (n),A / INC HL
+    Z80_FUSION_COUNT
+};
+
+#define Z80_FUSE_ALL ((1u << Z80_FUSION_COUNT) - 1)
+
+// One decoded instruction. The opcode and prefix bytes are consumed at
+// decode time; execute() is the executor the last of them would dispatch to
+// and charges the whole instruction from its timing table. A fused op keeps
+// its own fields but execute() also runs the next `fused` ops.
+struct z80_block_op
+{
+    void (*execute)(struct z80_t *cpu, uint8_t opcode);
+    uint16_t pc;
+    uint8_t opcode;        // byte handed to execute()
+    uint8_t fetch_length;  // opcode/prefix bytes skipped before execute()
+    uint8_t length;        // full instruction length
+    uint8_t fused;         // following ops run by execute(), 0 = not fused
+    uint8_t bytes[4];      // raw instruction bytes, immediates included
+};
+
+// A straight-line run of instructions ending at the first one that can
+// change PC, the interrupt state or the CPU state
+struct z80_block
+{
+    uint32_t key;          // bank << 16 | start PC
+    uint32_t first_gen;    // page generations the decode was made under
+    uint32_t last_gen;
+    uint16_t last_bank;    // bank of last_page, which may lie in another slot
+    uint8_t first_page;
+    uint8_t last_page;
+    uint8_t count;
+    bool valid;
+    void *native;          // recompiled code for this decode, see z80_jit.h
+    struct z80_block_op ops[Z80_BLOCK_MAX_OPS];
+};
+
+struct z80_block_cache
+{
+    // Copy of the host write table handed to the CPU while attached, with
+    // pages holding decoded code cleared so writes to them reach the slow path
+    uint8_t *write_pages[Z80_PAGE_COUNT];
+    uint8_t *const *host_write_pages;
+    uint32_t page_gen[Z80_PAGE_COUNT];
+    bool dirty;            // a write hit the pages of a cached block
+    uint32_t fusions;      // enabled superinstructions, one bit per enum z80_fusion
+    uint64_t fused[Z80_FUSION_COUNT]; // sites fused so far, by kind
+    uint64_t hits;
+    uint64_t decodes;
+    uint64_t loaded;       // blocks restored from a block file
+    struct z80_block blocks[Z80_BLOCK_CACHE_SIZE];
+};
+
+struct z80_block_cache *z80_block_cache_create(void);
+void z80_block_cache_destroy(struct z80_block_cache *cache);
+void z80_block_cache_attach(struct z80_t *cpu, struct z80_block_cache *cache);
+void z80_block_cache_flush(struct z80_t *cpu);
+void z80_block_invalidate_page(struct z80_t *cpu, uint8_t page);
+struct z80_block *z80_block_lookup(struct z80_t *cpu, uint16_t pc);
+void z80_block_execute(struct z80_t *cpu, const struct z80_block *block, uint64_t deadline);
+void z80_run_blocks(struct z80_t *cpu, uint64_t deadline);
+uint64_t z80_block_hash(const void *data, size_t size, uint64_t hash);
+bool z80_block_cache_save(struct z80_t *cpu, const char *path, uint64_t rom_hash);
+bool z80_block_cache_load(struct z80_t *cpu, const char *path, uint64_t rom_hash);
+
+#endif
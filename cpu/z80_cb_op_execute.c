@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include "z80_op.h"
 #include "z80_flags.h"
+#include "z80_stats.h"
 
 // Z80 CB-prefixed Opcode enumeration (complete set)
 enum z80_cb_opcodes
@@ -328,6 +329,8 @@ enum z80_cb_opcodes
 
 void z80_execute_cb_instruction(struct z80_t *cpu, uint8_t opcode)
 {
+    cpu->cycle_count += z80_timing_cb[opcode];
+    z80_stats_count(cpu, Z80_STATS_CB, opcode);
     switch (opcode)
     {
    // ROTATE LEFT CIRCULAR (RLC) - 8-bit registers
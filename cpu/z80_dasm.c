@@ -3,181 +3,121 @@
 #include <stdio.h>
 #include "z80.h"
 #include "z80_opcode_table.h"
+#ifndef Z80_DASM_OFFLINE
 #include <SDL3/SDL.h>
+#endif
 
-static char disasm_buffer[128];
-
-// Table lookup function
-const opcode_info_t *get_opcode_info(struct z80_t *cpu, uint16_t pc, int *total_length, char *prefix_bytes, size_t prefix_size)
+// Table entry for the instruction starting with bytes (at least two)
+static const opcode_info_t *dasm_info(const uint8_t *bytes)
 {
-    uint8_t opcode = z80_read8(cpu, pc);
-    const opcode_info_t *info;
-
-    // Clear prefix bytes buffer
-    memset(prefix_bytes, 0, prefix_size);
-
-    switch (opcode)
+    switch (bytes[0])
     {
     case 0xED: // Extended instructions
-    {
-        if (prefix_size >= 2)
-        {
-            prefix_bytes[0] = opcode;
-            uint8_t sub_opcode = z80_read8(cpu, pc + 1);
-            prefix_bytes[1] = sub_opcode;
-        }
-        info = &ed_opcode_table[z80_read8(cpu, pc + 1)];
-        break;
-    }
-
+        return &ed_opcode_table[bytes[1]];
     case 0xCB: // Bit operations (for future implementation)
-    {
-        if (prefix_size >= 2)
-        {
-            prefix_bytes[0] = opcode;
-            uint8_t sub_opcode = z80_read8(cpu, pc + 1);
-            prefix_bytes[1] = sub_opcode;
-        }
-        // info = &bit_opcode_table[z80_read8(cpu, pc + 1)];  // Uncomment when CB table is ready
-        info = &opcode_table[opcode]; // Fallback for now
-        break;
-    }
-
+        // return &bit_opcode_table[bytes[1]];  // Uncomment when CB table is ready
+        return &opcode_table[bytes[0]]; // Fallback for now
     case 0xDD: // IX prefix
-    {
-        if (prefix_size >= 2)
-        {
-            prefix_bytes[0] = opcode;
-            uint8_t sub_opcode = z80_read8(cpu, pc + 1);
-            prefix_bytes[1] = sub_opcode;
-        }
-        info = &dd_opcode_table[z80_read8(cpu, pc + 1)]; // Use the sub-opcode
-        break;
-    }
+        return &dd_opcode_table[bytes[1]]; // Use the sub-opcode
     case 0xFD: // IY prefix
-    {
-        if (prefix_size >= 2)
-        {
-            prefix_bytes[0] = opcode;
-            uint8_t sub_opcode = z80_read8(cpu, pc + 1);
-            prefix_bytes[1] = sub_opcode;
-        }
-        info = &fd_opcode_table[z80_read8(cpu, pc + 1)]; // Use the sub-opcode
-        break;
-    }
-
+        return &fd_opcode_table[bytes[1]]; // Use the sub-opcode
     default: // Standard instructions
-        if (prefix_size >= 1)
-        {
-            prefix_bytes[0] = opcode;
-        }
-        info = &opcode_table[opcode];
-        break;
+        return &opcode_table[bytes[0]];
     }
-
-    *total_length = info->length;
-    return info;
 }
 
-void z80_disassemble_instruction(struct z80_t *cpu)
+// Disassemble the instruction in bytes (four, read ahead of it) as
+// "XX XX XX XX MNEMONIC" into buffer. Needs no CPU, so the offline trace
+// decoder shares it. Returns the instruction length.
+int z80_dasm_format(const uint8_t *bytes, char *buffer, size_t buffer_size)
 {
-    uint16_t start_pc = cpu->registers.PC;
-    int      total_length;
-    char     prefix_bytes[4] = {0}; // Support up to 4 prefix bytes
-    
-    // Get the appropriate opcode info
-    const opcode_info_t *info = get_opcode_info(cpu, start_pc, &total_length, prefix_bytes, sizeof(prefix_bytes));
-    
+    const opcode_info_t *info = dasm_info(bytes);
+    int         total_length = info->length;
     const char *mnemonic = info->name;
     char        formatted_mnemonic[64];
     char        hex_bytes[32] = "";
-    
+
     // Build hex byte representation with fixed width
     for (int i = 0; i < total_length && i < 4; i++) {
         char    byte_str[4];
-        uint8_t byte_val = z80_read8(cpu, start_pc + i);
-        snprintf(byte_str, sizeof(byte_str), "%02X ", byte_val);
+        snprintf(byte_str, sizeof(byte_str), "%02X ", bytes[i]);
         strcat(hex_bytes, byte_str);
     }
-    
+
     // Remove trailing space and pad to exactly 11 characters for alignment
     if (strlen(hex_bytes) > 0) {
         hex_bytes[strlen(hex_bytes) - 1] = '\0'; // Remove trailing space
     }
-    
-    // Format hex bytes with consistent width (11 chars total: "XX XX XX XX")
-    char aligned_hex[16];
-    snprintf(aligned_hex, sizeof(aligned_hex), "%-11s", hex_bytes);
-    
+
     // Format the instruction based on length and operand requirements
     switch (total_length) {
         case 1: {
             snprintf(formatted_mnemonic, sizeof(formatted_mnemonic), "%s", mnemonic);
             break;
         }
-        
+
         case 2: {
-            if (prefix_bytes[0] == 0xED || prefix_bytes[0] == 0xCB) {
+            if (bytes[0] == 0xED || bytes[0] == 0xCB) {
                 // For 2-byte prefixed instructions, the mnemonic is already complete
                 snprintf(formatted_mnemonic, sizeof(formatted_mnemonic), "%s", mnemonic);
             } else {
                 // Standard 2-byte instruction with 8-bit operand
-                uint8_t operand = z80_read8(cpu, start_pc + 1);
-                snprintf(formatted_mnemonic, sizeof(formatted_mnemonic), mnemonic, operand);
+                snprintf(formatted_mnemonic, sizeof(formatted_mnemonic), mnemonic, bytes[1]);
             }
             break;
         }
-        
+
         case 3: {
-            if (prefix_bytes[0] == 0xED) {
+            if (bytes[0] == 0xED) {
                 // 3-byte ED instruction - mnemonic is complete, no operand formatting needed
                 snprintf(formatted_mnemonic, sizeof(formatted_mnemonic), "%s", mnemonic);
             } else {
                 // Standard 3-byte instruction with 16-bit operand
-                uint16_t operand = z80_read16(cpu, start_pc + 1);
+                uint16_t operand = bytes[1] | (bytes[2] << 8);
                 snprintf(formatted_mnemonic, sizeof(formatted_mnemonic), mnemonic, operand);
             }
             break;
         }
-        
+
         case 4: {
-            if (prefix_bytes[0] == 0xED) {
-                // 4-byte ED prefixed instruction with 16-bit operand
-                // The operand is at bytes 2-3 (after ED prefix and opcode)
-                uint16_t operand = z80_read16(cpu, start_pc + 2);
-                snprintf(formatted_mnemonic, sizeof(formatted_mnemonic), mnemonic, operand);
-            } else {
-                // Other 4-byte instructions (if any)
-                uint16_t operand = z80_read16(cpu, start_pc + 2);
-                snprintf(formatted_mnemonic, sizeof(formatted_mnemonic), mnemonic, operand);
-            }
+            // 4-byte prefixed instruction with a 16-bit operand after the
+            // prefix and opcode
+            uint16_t operand = bytes[2] | (bytes[3] << 8);
+            snprintf(formatted_mnemonic, sizeof(formatted_mnemonic), mnemonic, operand);
             break;
         }
-        
+
         default: {
             snprintf(formatted_mnemonic, sizeof(formatted_mnemonic), "UNKNOWN");
             break;
         }
     }
 
-    SDL_Log("PC: %04X: %s %s \t SP:%04X CYC:%llu AF:%04X BC:%04X DE:%04X HL:%04X IX:%04X IY:%04X I:%02X R:%02X",
-        start_pc, aligned_hex, formatted_mnemonic,
+    // Hex bytes padded to 11 characters ("XX XX XX XX") for alignment
+    snprintf(buffer, buffer_size, "%-11s %s", hex_bytes, formatted_mnemonic);
+    return total_length;
+}
+
+#ifndef Z80_DASM_OFFLINE
+void z80_disassemble_instruction(struct z80_t *cpu)
+{
+    uint16_t start_pc = cpu->registers.PC;
+    uint8_t  bytes[4];
+    char     text[96];
+
+    for (int i = 0; i < 4; i++) {
+        bytes[i] = z80_read8(cpu, start_pc + i);
+    }
+    z80_dasm_format(bytes, text, sizeof(text));
+
+    z80_sync_flags(cpu);
+    SDL_Log("PC: %04X: %s \t SP:%04X CYC:%llu AF:%04X BC:%04X DE:%04X HL:%04X IX:%04X IY:%04X I:%02X R:%02X",
+        start_pc, text,
         cpu->registers.SP, cpu->cycles,
         cpu->registers.AF, cpu->registers.BC,
         cpu->registers.DE, cpu->registers.HL,
         cpu->registers.IX, cpu->registers.IY,
         cpu->registers.I, cpu->registers.R);
-
-    // snprintf(disasm_buffer, sizeof(disasm_buffer), "PC: %04X: %s %s", start_pc, aligned_hex, formatted_mnemonic);
-    // // Final output formatting with proper alignment
-    // SDL_Log(disasm_buffer);
-    // SDL_Log("SP:%04X CYC:%llu AF:%04X BC:%04X DE:%04X HL:%04X "
-    //         "IX:%04X IY:%04X I:%02X R:%02X\n",
-    //         cpu->registers.SP, cpu->cycles,
-    //         cpu->registers.AF, cpu->registers.BC,
-    //         cpu->registers.DE, cpu->registers.HL,
-    //         cpu->registers.IX, cpu->registers.IY,
-    //         cpu->registers.I, cpu->registers.R);
 }
 
 // Helper function for debugging - shows which table was used
@@ -210,4 +150,5 @@ void z80_disassemble_instruction_verbose(struct z80_t *cpu, char *buffer, size_t
     // Append table info
     size_t len = strlen(buffer);
     snprintf(buffer + len, buffer_size - len, " [%s]", table_name);
-}
\ No newline at end of file
+}
+#endif
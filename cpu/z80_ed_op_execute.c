@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include "z80_op.h"
 #include "z80_flags.h"
+#include "z80_stats.h"
 
 // Z80 ED-prefixed Opcode enumeration (corrected)
 enum z80_ed_opcodes
@@ -80,6 +81,8 @@ enum z80_ed_opcodes
 
 void z80_execute_ed_instruction(struct z80_t *cpu, uint8_t opcode)
 {
+    cpu->cycle_count += z80_timing_ed[opcode];
+    z80_stats_count(cpu, Z80_STATS_ED, opcode);
     switch (opcode)
     {
     // INPUT/OUTPUT INSTRUCTIONS
@@ -179,6 +182,10 @@ void z80_execute_ed_instruction(struct z80_t *cpu, uint8_t opcode)
         
     case ED_LDIR:
         {
+            uint32_t repeat_cycles = z80_timing_ed[opcode] + Z80_TIMING_REPEAT;
+            uint32_t count = z80_bulk_iterations(cpu, cpu->registers.BC ? cpu->registers.BC : 0x10000, repeat_cycles);
+            z80_bulk_copy(cpu, count - 1, 1, repeat_cycles);
+
             uint8_t value = z80_read8(cpu, cpu->registers.HL);
             z80_write8(cpu, cpu->registers.DE, value);
             cpu->registers.HL++;
@@ -189,7 +196,7 @@ void z80_execute_ed_instruction(struct z80_t *cpu, uint8_t opcode)
             if (cpu->registers.BC != 0)
             {
                 cpu->registers.PC -= 2;
-                cpu->cycle_count += 5;
+                cpu->cycle_count += Z80_TIMING_REPEAT;
             }
         }
         break;
@@ -203,13 +210,17 @@ void z80_execute_ed_instruction(struct z80_t *cpu, uint8_t opcode)
             if (cpu->registers.BC != 0 && !(cpu->registers.F & MASK_Z))
             {
                 cpu->registers.PC -= 2;
-                cpu->cycle_count += 5;
+                cpu->cycle_count += Z80_TIMING_REPEAT;
             }
         }
         break;
         
     case ED_LDDR:
         {
+            uint32_t repeat_cycles = z80_timing_ed[opcode] + Z80_TIMING_REPEAT;
+            uint32_t count = z80_bulk_iterations(cpu, cpu->registers.BC ? cpu->registers.BC : 0x10000, repeat_cycles);
+            z80_bulk_copy(cpu, count - 1, -1, repeat_cycles);
+
             uint8_t value = z80_read8(cpu, cpu->registers.HL);
             z80_write8(cpu, cpu->registers.DE, value);
             cpu->registers.HL--;
@@ -220,7 +231,7 @@ void z80_execute_ed_instruction(struct z80_t *cpu, uint8_t opcode)
             if (cpu->registers.BC != 0)
             {
                 cpu->registers.PC -= 2;
-                cpu->cycle_count += 5;
+                cpu->cycle_count += Z80_TIMING_REPEAT;
             }
         }
         break;
@@ -234,7 +245,7 @@ void z80_execute_ed_instruction(struct z80_t *cpu, uint8_t opcode)
             if (cpu->registers.BC != 0 && !(cpu->registers.F & MASK_Z))
             {
                 cpu->registers.PC -= 2;
-                cpu->cycle_count += 5;
+                cpu->cycle_count += Z80_TIMING_REPEAT;
             }
         }
         break;
@@ -306,7 +317,7 @@ void z80_execute_ed_instruction(struct z80_t *cpu, uint8_t opcode)
     //         if (cpu->registers.B != 0)
     //         {
     //             cpu->registers.PC -= 2;
-    //             cpu->cycle_count += 5;
+    //             cpu->cycle_count += Z80_TIMING_REPEAT;
     //         }
     //     }
     //     break;
@@ -322,13 +333,27 @@ void z80_execute_ed_instruction(struct z80_t *cpu, uint8_t opcode)
     //         if (cpu->registers.B != 0)
     //         {
     //             cpu->registers.PC -= 2;
-    //             cpu->cycle_count += 5;
+    //             cpu->cycle_count += Z80_TIMING_REPEAT;
     //         }
     //     }
     //     break;
         
     case ED_OTIR:
         {
+            uint32_t repeat_cycles = z80_timing_ed[opcode] + Z80_TIMING_REPEAT;
+            uint32_t count = z80_bulk_iterations(cpu, cpu->registers.B ? cpu->registers.B : 0x100, repeat_cycles);
+            if (z80_bulk_out(cpu, count - 1, repeat_cycles) && cpu->exit_reason)
+            {
+                // A port handler wants control back: stop where the
+                // per-iteration path would, after the repeat of the
+                // iteration that wrote that byte, charged as this one
+                cpu->cycles -= repeat_cycles;
+                cpu->cycle_count += Z80_TIMING_REPEAT;
+                set_flags_block_io(cpu);
+                cpu->registers.PC -= 2;
+                break;
+            }
+
             uint8_t value = z80_read8(cpu, cpu->registers.HL);
             z80_port_out(cpu, cpu->registers.C, value); // the correct address is BC ????
             // z80_write8(cpu, cpu->registers.C, value);
@@ -339,7 +364,7 @@ void z80_execute_ed_instruction(struct z80_t *cpu, uint8_t opcode)
             if (cpu->registers.B != 0)
             {
                 cpu->registers.PC -= 2;
-                cpu->cycle_count += 5;
+                cpu->cycle_count += Z80_TIMING_REPEAT;
             }
         }
         break;
@@ -355,7 +380,7 @@ void z80_execute_ed_instruction(struct z80_t *cpu, uint8_t opcode)
     //         if (cpu->registers.B != 0)
     //         {
     //             cpu->registers.PC -= 2;
-    //             cpu->cycle_count += 5;
+    //             cpu->cycle_count += Z80_TIMING_REPEAT;
     //         }
     //     }
     //     break;
@@ -1,9 +1,19 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include "z80_flags.h"
+#include "z80_flags_tables.h"
+
+// Undocumented bits that shifts, RLD/RRD, DAA and CPI/CPD leave as they were
+#define MASK_KEEP_53 (MASK_5 | MASK_3)
+
+const struct z80_flag_tables z80_flag_tables =
+{
+    z80_szp_table, z80_inc_table, z80_dec_table, z80_adc_table, z80_sbc_table,
+};
 
 static inline void set_flag_if(struct z80_t *cpu, uint8_t flag, bool condition)
 {
+    z80_get_flags(cpu);
     if (condition)
         cpu->registers.F |= flag;
     else
@@ -12,128 +22,128 @@ static inline void set_flag_if(struct z80_t *cpu, uint8_t flag, bool condition)
 
 static inline void set_flag(struct z80_t *cpu, uint8_t flag)
 {
+    z80_get_flags(cpu);
     cpu->registers.F |= flag;
 }
 
 static inline void clear_flag(struct z80_t *cpu, uint8_t flag)
 {
+    z80_get_flags(cpu);
     cpu->registers.F &= ~flag;
 }
 
 static inline uint8_t get_flag(struct z80_t *cpu, uint8_t flag)
 {
-    return (cpu->registers.F & flag) ? 1 : 0;
+    return (z80_get_flags(cpu) & flag) ? 1 : 0;
 }
 
-static bool parity_table[256];
-
-// Check if a value has even parity
-static inline bool is_even_parity(uint8_t value)
+#if Z80_LAZY_FLAGS
+// Record an op's inputs; z80_flags_resolve() turns them into F on demand
+static inline void defer_flags(struct z80_t *cpu, uint8_t op, uint8_t a, uint8_t b, uint8_t c)
 {
-    return parity_table[value];
+    cpu->lazy_flags.op = op;
+    cpu->lazy_flags.a = a;
+    cpu->lazy_flags.b = b;
+    cpu->lazy_flags.c = c;
 }
 
-void init_parity_table(void)
+void z80_flags_resolve(struct z80_t *cpu)
 {
-    for (int i = 0; i < 256; i++)
+    uint8_t a = cpu->lazy_flags.a;
+    uint8_t b = cpu->lazy_flags.b;
+    uint8_t c = cpu->lazy_flags.c;
+
+    switch (cpu->lazy_flags.op)
     {
-        int count = 0;
-        int val = i;
+    case Z80_FLAGS_ADC:   cpu->registers.F = z80_adc_table[(c << 16) | (a << 8) | b]; break;
+    case Z80_FLAGS_SBC:   cpu->registers.F = z80_sbc_table[(c << 16) | (a << 8) | b]; break;
+    case Z80_FLAGS_INC:   cpu->registers.F = c | z80_inc_table[a]; break;
+    case Z80_FLAGS_DEC:   cpu->registers.F = c | z80_dec_table[a]; break;
+    case Z80_FLAGS_LOGIC: cpu->registers.F = c | z80_szp_table[a]; break;
+    default: break;
+    }
+    cpu->lazy_flags.op = Z80_FLAGS_NONE;
+}
+#endif
 
-        while (val)
-        {
-            count += val & 1;
-            val >>= 1;
-        }
+void z80_sync_flags(struct z80_t *cpu)
+{
+    z80_get_flags(cpu);
+}
 
-        parity_table[i] = (count & 1) == 0; // even number of 1s → even parity
-    }
+// Flags of a shift/rotate through the CB page: S, Z, P from the result,
+// H and N cleared, 5/3 kept, C from the bit shifted out
+static inline void set_flags_shift(struct z80_t *cpu, uint8_t result, uint8_t carry)
+{
+    cpu->registers.F = (z80_get_flags(cpu) & MASK_KEEP_53)
+                     | (z80_szp_table[result] & ~MASK_KEEP_53)
+                     | (carry ? MASK_C : 0);
 }
 
 // Set flags for 8-bit increment operations (INC)
 void set_flags_inc8(struct z80_t *cpu, uint8_t original, uint8_t result)
 {
-    clear_flag(cpu,  MASK_N);
-    set_flag_if(cpu, MASK_S, (result & 0x80));
-    set_flag_if(cpu, MASK_Z, (result == 0));
-    set_flag_if(cpu, MASK_H, (original & 0x0F) == 0x0F);
-    set_flag_if(cpu, MASK_PV, (original == 0x7F));
-
-    set_flag_if(cpu, MASK_3, result & MASK_3);
-    set_flag_if(cpu, MASK_5, result & MASK_5);
+    (void)original;
+#if Z80_LAZY_FLAGS
+    defer_flags(cpu, Z80_FLAGS_INC, result, 0, z80_get_flags(cpu) & MASK_C);
+#else
+    cpu->registers.F = (cpu->registers.F & MASK_C) | z80_inc_table[result];
+#endif
 }
 
 // Set flags for 8-bit decrement operations (DEC)
 void set_flags_dec8(struct z80_t *cpu, uint8_t original, uint8_t result)
 {
-    set_flag(cpu, MASK_N);
-    set_flag_if(cpu, MASK_S, (result & 0x80));
-    set_flag_if(cpu, MASK_Z, (result == 0));
-    set_flag_if(cpu, MASK_H, (original & 0x0F) == 0x00);
-    set_flag_if(cpu, MASK_PV, (original == 0x80));
-
-    set_flag_if(cpu, MASK_3, (result & MASK_3));
-    set_flag_if(cpu, MASK_5, (result & MASK_5));
+    (void)original;
+#if Z80_LAZY_FLAGS
+    defer_flags(cpu, Z80_FLAGS_DEC, result, 0, z80_get_flags(cpu) & MASK_C);
+#else
+    cpu->registers.F = (cpu->registers.F & MASK_C) | z80_dec_table[result];
+#endif
 }
 
 // Set flags for 8-bit arithmetic operations
 uint8_t set_flags_add8(struct z80_t *cpu, uint8_t a, uint8_t b)
 {
-    uint16_t result = a + b;
-    clear_flag(cpu,  MASK_N);
-    set_flag_if(cpu, MASK_S, (result & MASK_S));
-    set_flag_if(cpu, MASK_Z, (result & UINT8_MAX) == 0);
-    set_flag_if(cpu, MASK_H, ((a & NIBBLE_LOW) + (b & NIBBLE_LOW)) > NIBBLE_LOW);
-    set_flag_if(cpu, MASK_PV, ((a ^ result) & (b ^ result) & 0x80));
-    set_flag_if(cpu, MASK_C, (result > UINT8_MAX));
-    set_flag_if(cpu, MASK_3, (result & MASK_3));
-    set_flag_if(cpu, MASK_5, (result & MASK_5));
-    return result & UINT8_MAX;
+#if Z80_LAZY_FLAGS
+    defer_flags(cpu, Z80_FLAGS_ADC, a, b, 0);
+#else
+    cpu->registers.F = z80_adc_table[(a << 8) | b];
+#endif
+    return a + b;
 }
 
 // Set flags for 8-bit subtraction operations
 uint8_t set_flags_sub8(struct z80_t *cpu, uint8_t a, uint8_t b)
 {
-    uint16_t result = a - b;
-    set_flag(cpu,    MASK_N);
-    set_flag_if(cpu, MASK_S, (result & MASK_S));
-    set_flag_if(cpu, MASK_Z, (result & UINT8_MAX) == 0);
-    set_flag_if(cpu, MASK_H, (a & NIBBLE_LOW) < (b & NIBBLE_LOW));
-    set_flag_if(cpu, MASK_PV, ((a ^ b) & (a ^ result) & 0x80));
-    set_flag_if(cpu, MASK_C, (a < b));
-    set_flag_if(cpu, MASK_3, (result & MASK_3));
-    set_flag_if(cpu, MASK_5, (result & MASK_5));
-    return result & UINT8_MAX;
+#if Z80_LAZY_FLAGS
+    defer_flags(cpu, Z80_FLAGS_SBC, a, b, 0);
+#else
+    cpu->registers.F = z80_sbc_table[(a << 8) | b];
+#endif
+    return a - b;
 }
 
 uint8_t set_flags_adc8(struct z80_t *cpu, uint8_t a, uint8_t b)
 {
     uint8_t carry = IS_C_SET(cpu);
-    uint16_t result = a + b + carry;
-    clear_flag(cpu,  MASK_N);
-    set_flag_if(cpu, MASK_S, (result & MASK_S));
-    set_flag_if(cpu, MASK_Z, (result & UINT8_MAX) == 0);
-    set_flag_if(cpu, MASK_H, ((a & NIBBLE_LOW) + (b & NIBBLE_LOW) + carry) > NIBBLE_LOW);
-    set_flag_if(cpu, MASK_PV, ((a ^ result) & (b ^ result) & 0x80));
-    set_flag_if(cpu, MASK_C, (result > UINT8_MAX));
-    set_flag_if(cpu, MASK_3, (result & MASK_3));
-    set_flag_if(cpu, MASK_5, (result & MASK_5));
-    return result & UINT8_MAX;
+#if Z80_LAZY_FLAGS
+    defer_flags(cpu, Z80_FLAGS_ADC, a, b, carry);
+#else
+    cpu->registers.F = z80_adc_table[(carry << 16) | (a << 8) | b];
+#endif
+    return a + b + carry;
 }
 
 uint8_t set_flags_sbc8(struct z80_t *cpu, uint8_t a, uint8_t b)
 {
     uint8_t carry = IS_C_SET(cpu);
-    uint16_t result = a - b - carry;
-    set_flag(cpu,    MASK_N);
-    set_flag_if(cpu, MASK_S, (result & MASK_S));
-    set_flag_if(cpu, MASK_Z, (result & UINT8_MAX) == 0);
-    set_flag_if(cpu, MASK_H, (a & NIBBLE_LOW) < ((b & NIBBLE_LOW) + carry));
-    set_flag_if(cpu, MASK_PV, ((a ^ b) & (a ^ result) & 0x80));
-    set_flag_if(cpu, MASK_C, (a < (b + carry)));
-    set_flag_if(cpu, MASK_3, result & MASK_3); 
-    set_flag_if(cpu, MASK_5, result & MASK_5);  
-    return result & UINT8_MAX;
+#if Z80_LAZY_FLAGS
+    defer_flags(cpu, Z80_FLAGS_SBC, a, b, carry);
+#else
+    cpu->registers.F = z80_sbc_table[(carry << 16) | (a << 8) | b];
+#endif
+    return a - b - carry;
 }
 
 // Set flags for 16-bit addition operations (ADD HL,rr)
@@ -150,30 +160,21 @@ void set_flags_add16(struct z80_t *cpu, uint16_t a, uint16_t b, uint16_t result)
 // For OR and XOR operations
 void set_flags_logical_or_xor(struct z80_t *cpu, uint8_t result)
 {
-    clear_flag(cpu, MASK_N);
-    clear_flag(cpu, MASK_H);
-    clear_flag(cpu, MASK_C);
-    set_flag_if(cpu, MASK_S, result & 0x80);
-    set_flag_if(cpu, MASK_Z, result == 0);
-    set_flag_if(cpu, MASK_PV, is_even_parity(result));
-
-    set_flag_if(cpu, MASK_3, result & 0x0008);
-    set_flag_if(cpu, MASK_5, result & 0x0020);
+#if Z80_LAZY_FLAGS
+    defer_flags(cpu, Z80_FLAGS_LOGIC, result, 0, 0);
+#else
+    cpu->registers.F = z80_szp_table[result];
+#endif
 }
 
 // For AND operations
 void set_flags_logical_and(struct z80_t *cpu, uint8_t result)
 {
-    // Clear N and C flags
-    clear_flag(cpu, MASK_N);
-    clear_flag(cpu, MASK_C);
-    set_flag(cpu, MASK_H);
-    set_flag_if(cpu, MASK_S, result & 0x80);
-    set_flag_if(cpu, MASK_Z, result == 0);
-    set_flag_if(cpu, MASK_PV, is_even_parity(result));
-
-    set_flag_if(cpu, MASK_3, result & MASK_3);
-    set_flag_if(cpu, MASK_5, result & MASK_5);
+#if Z80_LAZY_FLAGS
+    defer_flags(cpu, Z80_FLAGS_LOGIC, result, 0, MASK_H);
+#else
+    cpu->registers.F = z80_szp_table[result] | MASK_H;
+#endif
 }
 
 // Set flags for comparison operations (same as subtraction but don't store result)
@@ -244,11 +245,11 @@ uint8_t set_flags_cpd(struct z80_t *cpu, uint8_t r)
     cpu->registers.HL--;
     cpu->registers.BC--;
 
-    set_flag_if(cpu, MASK_S, (result & 0x80));
-    set_flag_if(cpu, MASK_Z, (result == 0));
-    set_flag_if(cpu, MASK_H, (cpu->registers.A & NIBBLE_LOW) < (r & NIBBLE_LOW));
-    set_flag_if(cpu, MASK_PV, cpu->registers.BC != 0);
-    set_flag(cpu,  MASK_N);
+    cpu->registers.F = (z80_get_flags(cpu) & (MASK_KEEP_53 | MASK_C))
+                     | (z80_sz_table[result] & (MASK_S | MASK_Z))
+                     | (((cpu->registers.A & NIBBLE_LOW) < (r & NIBBLE_LOW)) ? MASK_H : 0)
+                     | ((cpu->registers.BC != 0) ? MASK_PV : 0)
+                     | MASK_N;
     return result;
 }
 
@@ -258,11 +259,11 @@ uint8_t set_flags_cpi(struct z80_t *cpu, uint8_t r)
     cpu->registers.HL++;
     cpu->registers.BC--;
 
-    set_flag_if(cpu, MASK_S, (result & 0x80));
-    set_flag_if(cpu, MASK_Z, (result == 0));
-    set_flag_if(cpu, MASK_H, (cpu->registers.A & NIBBLE_LOW) < (r & NIBBLE_LOW));
-    set_flag_if(cpu, MASK_PV, cpu->registers.BC != 0);
-    set_flag(cpu,  MASK_N);
+    cpu->registers.F = (z80_get_flags(cpu) & (MASK_KEEP_53 | MASK_C))
+                     | (z80_sz_table[result] & (MASK_S | MASK_Z))
+                     | (((cpu->registers.A & NIBBLE_LOW) < (r & NIBBLE_LOW)) ? MASK_H : 0)
+                     | ((cpu->registers.BC != 0) ? MASK_PV : 0)
+                     | MASK_N;
     return result;
 }
 
@@ -300,24 +301,14 @@ uint8_t set_flags_rlc(struct z80_t *cpu, uint8_t r)
 {
     uint8_t bit7 = r & 0x80;
     r = (r << 1) | (bit7 >> 7);
-    set_flag_if(cpu, MASK_S, (r & 0x80));
-    set_flag_if(cpu, MASK_Z, (r == 0));
-    clear_flag(cpu,  MASK_H);
-    set_flag_if(cpu, MASK_PV, is_even_parity(r));
-    clear_flag(cpu,  MASK_N);
-    set_flag_if(cpu, MASK_C, bit7);
+    set_flags_shift(cpu, r, bit7);
     return r;
 }
 
 uint8_t set_flags_rl(struct z80_t *cpu, uint8_t r)
 {
     uint8_t result = (r << 1) | (get_flag(cpu, MASK_C));
-    set_flag_if(cpu, MASK_S, (result & 0x80));
-    set_flag_if(cpu, MASK_Z, (result == 0));
-    clear_flag(cpu,  MASK_H);
-    set_flag_if(cpu, MASK_PV, is_even_parity(result));
-    clear_flag(cpu,  MASK_N);
-    set_flag_if(cpu, MASK_C, r & 0x80);
+    set_flags_shift(cpu, result, r & 0x80);
     return result;
 }
 
@@ -325,72 +316,42 @@ uint8_t set_flags_rrc(struct z80_t *cpu, uint8_t r)
 {
     uint8_t bit1 = r & 0x01;
     r = (r >> 1) | (bit1 << 7);
-    set_flag_if(cpu, MASK_S, (r & 0x80));
-    set_flag_if(cpu, MASK_Z, (r == 0));
-    clear_flag(cpu,  MASK_H);
-    set_flag_if(cpu, MASK_PV, is_even_parity(r));
-    clear_flag(cpu,  MASK_N);
-    set_flag_if(cpu, MASK_C, bit1);
+    set_flags_shift(cpu, r, bit1);
     return r;
 }
 
 uint8_t set_flags_rr(struct z80_t *cpu, uint8_t r)
 {
     uint8_t result = (r >> 1) | (get_flag(cpu, MASK_C)) << 7;
-    set_flag_if(cpu, MASK_S, (result & 0x80));
-    set_flag_if(cpu, MASK_Z, (result == 0));
-    clear_flag(cpu, MASK_H);
-    set_flag_if(cpu, MASK_PV, is_even_parity(result));
-    clear_flag(cpu, MASK_N);
-    set_flag_if(cpu, MASK_C, r & 0x1);
+    set_flags_shift(cpu, result, r & 0x1);
     return result;
 }
 
 uint8_t set_flags_sla(struct z80_t *cpu, uint8_t r)
 {
     uint8_t result = r << 1;
-    set_flag_if(cpu, MASK_S, (result & 0x80));
-    set_flag_if(cpu, MASK_Z, (result == 0));
-    clear_flag(cpu, MASK_H);
-    set_flag_if(cpu, MASK_PV, is_even_parity(result));
-    clear_flag(cpu, MASK_N);
-    set_flag_if(cpu, MASK_C, (r & 0x80));
+    set_flags_shift(cpu, result, r & 0x80);
     return result;
 }
 
 uint8_t set_flags_sra(struct z80_t *cpu, uint8_t r)
 {
     uint8_t result = (r >> 1) | (r & 0x80);
-    set_flag_if(cpu, MASK_S, (result & 0x80));
-    set_flag_if(cpu, MASK_Z, (result == 0));
-    clear_flag(cpu, MASK_H);
-    set_flag_if(cpu, MASK_PV, is_even_parity(result));
-    clear_flag(cpu, MASK_N);
-    set_flag_if(cpu, MASK_C, (r & 0x1));
+    set_flags_shift(cpu, result, r & 0x1);
     return result;
 }
 
 uint8_t set_flags_sll(struct z80_t *cpu, uint8_t r)
 {
     uint8_t result = (r << 1) | 0x1;
-    set_flag_if(cpu, MASK_S, (result & 0x80));
-    set_flag_if(cpu, MASK_Z, (result == 0));
-    clear_flag(cpu, MASK_H);
-    set_flag_if(cpu, MASK_PV, is_even_parity(result));
-    clear_flag(cpu, MASK_N);
-    set_flag_if(cpu, MASK_C, (r & 0x80));
+    set_flags_shift(cpu, result, r & 0x80);
     return result;
 }
 
 uint8_t set_flags_srl(struct z80_t *cpu, uint8_t r)
 {
     uint8_t result = (r >> 1);
-    set_flag_if(cpu, MASK_S, (result & 0x80));
-    set_flag_if(cpu, MASK_Z, (result == 0));
-    clear_flag(cpu, MASK_H);
-    set_flag_if(cpu, MASK_PV, is_even_parity(result));
-    clear_flag(cpu, MASK_N);
-    set_flag_if(cpu, MASK_C, (r & 0x1));
+    set_flags_shift(cpu, result, r & 0x1);
     return result;
 }
 
@@ -403,16 +364,13 @@ uint8_t set_flags_cpl(struct z80_t *cpu)
 
 void set_flags_rotate_digit(struct z80_t *cpu)
 {
-    set_flag_if(cpu, MASK_S, cpu->registers.A & 0x80);
-    set_flag_if(cpu, MASK_Z, cpu->registers.A == 0);
-    clear_flag(cpu, MASK_H);
-    set_flag_if(cpu, MASK_PV, is_even_parity(cpu->registers.A));
-    clear_flag(cpu, MASK_N);
+    cpu->registers.F = (z80_get_flags(cpu) & (MASK_KEEP_53 | MASK_C))
+                     | (z80_szp_table[cpu->registers.A] & ~MASK_KEEP_53);
 }
 
 void set_flags_ccf(struct z80_t *cpu)
 {
-    bool old_carry = (cpu->registers.F & MASK_C) != 0;
+    bool old_carry = (z80_get_flags(cpu) & MASK_C) != 0;
     clear_flag(cpu, MASK_N);
     set_flag_if(cpu, MASK_H, old_carry);
     set_flag_if(cpu, MASK_C, !old_carry);
@@ -452,7 +410,7 @@ uint8_t set_flags_rla(struct z80_t *cpu)
 uint8_t set_flags_daa(struct z80_t *cpu)
 {
     uint8_t old_A = cpu->registers.A;
-    uint8_t old_F = cpu->registers.F;
+    uint8_t old_F = z80_get_flags(cpu);
 
     uint8_t correction = 0x00;
     bool carry_out = false;
@@ -496,12 +454,11 @@ uint8_t set_flags_daa(struct z80_t *cpu)
         half_carry_out = ((old_A & 0x0F) + (correction & 0x0F)) > 0x0F;
     }
 
-    // Update flags
-    set_flag_if(cpu, MASK_C, carry_out);
-    set_flag_if(cpu, MASK_H, half_carry_out);
-    set_flag_if(cpu, MASK_S, (new_A & 0x80) != 0);
-    set_flag_if(cpu, MASK_Z, new_A == 0);
-    set_flag_if(cpu, MASK_PV, is_even_parity(new_A));
+    // Update flags (N and the 5/3 bits are kept)
+    cpu->registers.F = (old_F & (MASK_N | MASK_KEEP_53))
+                     | (z80_szp_table[new_A] & ~MASK_KEEP_53)
+                     | (half_carry_out ? MASK_H : 0)
+                     | (carry_out ? MASK_C : 0);
 
     return new_A;
 }
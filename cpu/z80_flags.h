@@ -26,13 +26,59 @@
 #define MASK_5      (1 << FLAG_5)
 #define MASK_3      (1 << FLAG_3)
 
+// Deferred flag producers (Z80_LAZY_FLAGS)
+enum z80_flags_op
+{
+    Z80_FLAGS_NONE,     // registers.F is up to date
+    Z80_FLAGS_ADC,      // ADD/ADC: a, b, c = carry in
+    Z80_FLAGS_SBC,      // SUB/SBC/CP: a, b, c = carry in
+    Z80_FLAGS_INC,      // a = result, c = carry kept from before
+    Z80_FLAGS_DEC,      // a = result, c = carry kept from before
+    Z80_FLAGS_LOGIC,    // AND/OR/XOR: a = result, c = H
+};
+
+void z80_flags_resolve(struct z80_t *cpu);
+
+// The generated flag tables, for code that builds F itself (the recompiler)
+struct z80_flag_tables
+{
+    const uint8_t *szp;   // [256] by result
+    const uint8_t *inc;   // [256] by result
+    const uint8_t *dec;   // [256] by result
+    const uint8_t *adc;   // [2 * 65536] by carry << 16 | a << 8 | b
+    const uint8_t *sbc;   // [2 * 65536] by carry << 16 | a << 8 | b
+};
+
+extern const struct z80_flag_tables z80_flag_tables;
+
+// Current F, rebuilding it first if an op left it pending
+static inline uint8_t z80_get_flags(struct z80_t *cpu)
+{
+#if Z80_LAZY_FLAGS
+    if (cpu->lazy_flags.op != Z80_FLAGS_NONE)
+        z80_flags_resolve(cpu);
+#endif
+    return cpu->registers.F;
+}
+
+// Call after storing F directly (POP AF, EX AF,AF') so a pending op does
+// not overwrite it later
+static inline void z80_flags_written(struct z80_t *cpu)
+{
+#if Z80_LAZY_FLAGS
+    cpu->lazy_flags.op = Z80_FLAGS_NONE;
+#else
+    (void)cpu;
+#endif
+}
+
 // Macros to test flags - return non-zero (true) if set, zero (false) if clear
-#define FLAG_IS_SET(cpu, flag)      ((cpu)->registers.F & (flag))
-#define FLAG_IS_CLEAR(cpu, flag)    (!((cpu)->registers.F & (flag)))
+#define FLAG_IS_SET(cpu, flag)      (z80_get_flags(cpu) & (flag))
+#define FLAG_IS_CLEAR(cpu, flag)    (!(z80_get_flags(cpu) & (flag)))
 
 // Macros to set/clear individual flags
-#define SET_FLAG(cpu, flag)         ((cpu)->registers.F |= (flag))
-#define CLEAR_FLAG(cpu, flag)       ((cpu)->registers.F &= ~(flag))
+#define SET_FLAG(cpu, flag)         ((void)z80_get_flags(cpu), (cpu)->registers.F |= (flag))
+#define CLEAR_FLAG(cpu, flag)       ((void)z80_get_flags(cpu), (cpu)->registers.F &= ~(flag))
 #define SET_FLAG_IF(cpu, flag, condition) \
     do { \
         if (condition) SET_FLAG(cpu, flag); \
@@ -54,12 +100,12 @@
 #define CLEAR_C(cpu)        CLEAR_FLAG(cpu, MASK_C)
 
 // Optimized flag test macros - return 1 if set, 0 if clear
-#define IS_S_SET(cpu)       ((((cpu)->registers.F) >> FLAG_S) & 1)
-#define IS_Z_SET(cpu)       ((((cpu)->registers.F) >> FLAG_Z) & 1)
-#define IS_H_SET(cpu)       ((((cpu)->registers.F) >> FLAG_H) & 1)
-#define IS_PV_SET(cpu)      ((((cpu)->registers.F) >> FLAG_PV) & 1)
-#define IS_N_SET(cpu)       ((((cpu)->registers.F) >> FLAG_N) & 1)
-#define IS_C_SET(cpu)       ((((cpu)->registers.F) >> FLAG_C) & 1)
+#define IS_S_SET(cpu)       ((z80_get_flags(cpu) >> FLAG_S) & 1)
+#define IS_Z_SET(cpu)       ((z80_get_flags(cpu) >> FLAG_Z) & 1)
+#define IS_H_SET(cpu)       ((z80_get_flags(cpu) >> FLAG_H) & 1)
+#define IS_PV_SET(cpu)      ((z80_get_flags(cpu) >> FLAG_PV) & 1)
+#define IS_N_SET(cpu)       ((z80_get_flags(cpu) >> FLAG_N) & 1)
+#define IS_C_SET(cpu)       ((z80_get_flags(cpu) >> FLAG_C) & 1)
 #define IS_S_UNSET(cpu)     (!IS_S_SET(cpu))
 #define IS_Z_UNSET(cpu)     (!IS_Z_SET(cpu))
 #define IS_H_UNSET(cpu)     (!IS_H_SET(cpu))
@@ -67,7 +113,6 @@
 #define IS_N_UNSET(cpu)     (!IS_N_SET(cpu))
 #define IS_C_UNSET(cpu)     (!IS_C_SET(cpu))
 
-void init_parity_table();
 void set_flags_inc8(struct z80_t *cpu, uint8_t original, uint8_t result);
 void set_flags_dec8(struct z80_t *cpu, uint8_t original, uint8_t result);
 void set_flags_logical_or_xor(struct z80_t *cpu, uint8_t result);
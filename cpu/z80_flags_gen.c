@@ -0,0 +1,136 @@
+// Build-time generator for the Z80 flag lookup tables.
+//
+// Writes z80_flags_tables.h, which z80_flags.c includes so the ALU helpers
+// can resolve F with one load instead of a chain of per-bit updates. The
+// formulas below are the reference definitions; the emulator never runs them.
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "z80_flags.h"
+
+static bool even_parity(uint8_t value)
+{
+    int count = 0;
+    while (value)
+    {
+        count += value & 1;
+        value >>= 1;
+    }
+    return (count & 1) == 0;
+}
+
+// S, Z and the undocumented 5/3 copies of the result
+static uint8_t sz_flags(uint8_t result)
+{
+    uint8_t f = result & (MASK_S | MASK_5 | MASK_3);
+    if (result == 0)
+        f |= MASK_Z;
+    return f;
+}
+
+static uint8_t szp_flags(uint8_t result)
+{
+    return sz_flags(result) | (even_parity(result) ? MASK_PV : 0);
+}
+
+// INC r: indexed by the result, carry is left to the caller
+static uint8_t inc_flags(uint8_t result)
+{
+    uint8_t f = sz_flags(result);
+    if ((result & NIBBLE_LOW) == 0x00)
+        f |= MASK_H;
+    if (result == 0x80)
+        f |= MASK_PV;
+    return f;
+}
+
+// DEC r: indexed by the result, carry is left to the caller
+static uint8_t dec_flags(uint8_t result)
+{
+    uint8_t f = sz_flags(result) | MASK_N;
+    if ((result & NIBBLE_LOW) == NIBBLE_LOW)
+        f |= MASK_H;
+    if (result == 0x7F)
+        f |= MASK_PV;
+    return f;
+}
+
+static uint8_t adc_flags(uint8_t a, uint8_t b, uint8_t carry)
+{
+    uint16_t result = a + b + carry;
+    uint8_t f = sz_flags(result & UINT8_MAX);
+    if (((a & NIBBLE_LOW) + (b & NIBBLE_LOW) + carry) > NIBBLE_LOW)
+        f |= MASK_H;
+    if ((a ^ result) & (b ^ result) & 0x80)
+        f |= MASK_PV;
+    if (result > UINT8_MAX)
+        f |= MASK_C;
+    return f;
+}
+
+static uint8_t sbc_flags(uint8_t a, uint8_t b, uint8_t carry)
+{
+    uint16_t result = a - b - carry;
+    uint8_t f = sz_flags(result & UINT8_MAX) | MASK_N;
+    if ((a & NIBBLE_LOW) < ((b & NIBBLE_LOW) + carry))
+        f |= MASK_H;
+    if ((a ^ b) & (a ^ result) & 0x80)
+        f |= MASK_PV;
+    if (a < (b + carry))
+        f |= MASK_C;
+    return f;
+}
+
+static void emit_table(FILE *out, const char *name, const char *comment, int size, uint8_t (*entry)(int))
+{
+    fprintf(out, "// %s\n", comment);
+    fprintf(out, "static const uint8_t %s[%d] = {", name, size);
+    for (int i = 0; i < size; i++)
+    {
+        fprintf(out, "%s0x%02X,", (i % 16) ? "" : "\n    ", entry(i));
+    }
+    fprintf(out, "\n};\n\n");
+}
+
+static uint8_t sz_entry(int i)   { return sz_flags(i); }
+static uint8_t szp_entry(int i)  { return szp_flags(i); }
+static uint8_t inc_entry(int i)  { return inc_flags(i); }
+static uint8_t dec_entry(int i)  { return dec_flags(i); }
+static uint8_t adc_entry(int i)  { return adc_flags((i >> 8) & 0xFF, i & 0xFF, (i >> 16) & 1); }
+static uint8_t sbc_entry(int i)  { return sbc_flags((i >> 8) & 0xFF, i & 0xFF, (i >> 16) & 1); }
+
+int main(int argc, char *argv[])
+{
+    if (argc != 2)
+    {
+        fprintf(stderr, "usage: %s <output header>\n", argv[0]);
+        return 1;
+    }
+
+    FILE *out = fopen(argv[1], "w");
+    if (!out)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+
+    fprintf(out, "// Generated by z80_flags_gen.c - do not edit.\n");
+    fprintf(out, "#ifndef Z80_FLAGS_TABLES_H_\n#define Z80_FLAGS_TABLES_H_\n\n");
+    fprintf(out, "#include <stdint.h>\n\n");
+
+    emit_table(out, "z80_sz_table", "S, Z, 5, 3 of an 8-bit result", 256, sz_entry);
+    emit_table(out, "z80_szp_table", "S, Z, 5, 3 and even parity of an 8-bit result", 256, szp_entry);
+    emit_table(out, "z80_inc_table", "INC: S, Z, 5, H, 3, V, N indexed by the result (C untouched)", 256, inc_entry);
+    emit_table(out, "z80_dec_table", "DEC: S, Z, 5, H, 3, V, N indexed by the result (C untouched)", 256, dec_entry);
+    emit_table(out, "z80_adc_table", "ADD/ADC: full F indexed by carry << 16 | a << 8 | b", 2 * 256 * 256, adc_entry);
+    emit_table(out, "z80_sbc_table", "SUB/SBC/CP: full F indexed by carry << 16 | a << 8 | b", 2 * 256 * 256, sbc_entry);
+
+    fprintf(out, "#endif\n");
+
+    if (fclose(out) != 0)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+    return 0;
+}
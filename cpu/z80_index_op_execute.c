@@ -0,0 +1,980 @@
+#include <stdio.h>
+#include "z80_op.h"
+#include "z80_flags.h"
+#include "z80_stats.h"
+
+// DD (IX) and FD (IY) prefixed instructions. Both prefixes decode the same
+// way and only differ in the index register, so the opcodes below are named
+// after a generic XY and the executors are built once per register from
+// z80_index_op_template.h. The DD-CB/FD-CB executor only needs the
+// effective address and is shared by both.
+
+// Z80 DD/FD-prefixed Opcode enumeration (complete 256 values)
+enum z80_index_opcodes
+{
+    // 0x00-0x0F - Most are NOP or same as unprefixed
+    XY_NOP_00 = 0x00,           // NOP (same as unprefixed)
+    XY_LD_BC_NN = 0x01,         // LD BC, NN (same as unprefixed)
+    XY_LD_BC_A = 0x02,          // LD (BC), A (same as unprefixed)
+    XY_INC_BC = 0x03,           // INC BC (same as unprefixed)
+    XY_INC_B = 0x04,            // INC B (same as unprefixed)
+    XY_DEC_B = 0x05,            // DEC B (same as unprefixed)
+    XY_LD_B_N = 0x06,           // LD B, n (same as unprefixed)
+    XY_RLCA = 0x07,             // RLCA (same as unprefixed)
+    XY_EX_AF_AF = 0x08,         // EX AF, AF' (same as unprefixed)
+    XY_ADD_XY_BC = 0x09,        // ADD XY, BC
+    XY_LD_A_BC = 0x0A,          // LD A, (BC) (same as unprefixed)
+    XY_DEC_BC = 0x0B,           // DEC BC (same as unprefixed)
+    XY_INC_C = 0x0C,            // INC C (same as unprefixed)
+    XY_DEC_C = 0x0D,            // DEC C (same as unprefixed)
+    XY_LD_C_N = 0x0E,           // LD C, n (same as unprefixed)
+    XY_RRCA = 0x0F,             // RRCA (same as unprefixed)
+    
+    // 0x10-0x1F
+    XY_DJNZ_E = 0x10,           // DJNZ e (same as unprefixed)
+    XY_LD_DE_NN = 0x11,         // LD DE, NN (same as unprefixed)
+    XY_LD_DE_A = 0x12,          // LD (DE), A (same as unprefixed)
+    XY_INC_DE = 0x13,           // INC DE (same as unprefixed)
+    XY_INC_D = 0x14,            // INC D (same as unprefixed)
+    XY_DEC_D = 0x15,            // DEC D (same as unprefixed)
+    XY_LD_D_N = 0x16,           // LD D, n (same as unprefixed)
+    XY_RLA = 0x17,              // RLA (same as unprefixed)
+    XY_JR_E = 0x18,             // JR e (same as unprefixed)
+    XY_ADD_XY_DE = 0x19,        // ADD XY, DE
+    XY_LD_A_DE = 0x1A,          // LD A, (DE) (same as unprefixed)
+    XY_DEC_DE = 0x1B,           // DEC DE (same as unprefixed)
+    XY_INC_E = 0x1C,            // INC E (same as unprefixed)
+    XY_DEC_E = 0x1D,            // DEC E (same as unprefixed)
+    XY_LD_E_N = 0x1E,           // LD E, n (same as unprefixed)
+    XY_RRA = 0x1F,              // RRA (same as unprefixed)
+    
+    // 0x20-0x2F
+    XY_JR_NZ_E = 0x20,          // JR NZ, e (same as unprefixed)
+    XY_LD_XY_NN = 0x21,         // LD XY, NN
+    XY_LD_NN_XY = 0x22,         // LD (NN), XY
+    XY_INC_XY = 0x23,           // INC XY
+    XY_INC_XYH = 0x24,          // INC XYH
+    XY_DEC_XYH = 0x25,          // DEC XYH
+    XY_LD_XYH_N = 0x26,         // LD XYH, n
+    XY_DAA = 0x27,              // DAA (same as unprefixed)
+    XY_JR_Z_E = 0x28,           // JR Z, e (same as unprefixed)
+    XY_ADD_XY_XY = 0x29,        // ADD XY, XY
+    XY_LD_XY_NN_ind = 0x2A,     // LD XY, (NN)
+    XY_DEC_XY = 0x2B,           // DEC XY
+    XY_INC_XYL = 0x2C,          // INC XYL
+    XY_DEC_XYL = 0x2D,          // DEC XYL
+    XY_LD_XYL_N = 0x2E,         // LD XYL, n
+    XY_CPL = 0x2F,              // CPL (same as unprefixed)
+    
+    // 0x30-0x3F
+    XY_JR_NC_E = 0x30,          // JR NC, e (same as unprefixed)
+    XY_LD_SP_NN = 0x31,         // LD SP, NN (same as unprefixed)
+    XY_LD_NN_A = 0x32,          // LD (NN), A (same as unprefixed)
+    XY_INC_SP = 0x33,           // INC SP (same as unprefixed)
+    XY_INC_XY_D = 0x34,         // INC (XY+d)
+    XY_DEC_XY_D = 0x35,         // DEC (XY+d)
+    XY_LD_XY_D_N = 0x36,        // LD (XY+d), n
+    XY_SCF = 0x37,              // SCF (same as unprefixed)
+    XY_JR_C_E = 0x38,           // JR C, e (same as unprefixed)
+    XY_ADD_XY_SP = 0x39,        // ADD XY, SP
+    XY_LD_A_NN = 0x3A,          // LD A, (NN) (same as unprefixed)
+    XY_DEC_SP = 0x3B,           // DEC SP (same as unprefixed)
+    XY_INC_A = 0x3C,            // INC A (same as unprefixed)
+    XY_DEC_A = 0x3D,            // DEC A (same as unprefixed)
+    XY_LD_A_N = 0x3E,           // LD A, n (same as unprefixed)
+    XY_CCF = 0x3F,              // CCF (same as unprefixed)
+    
+    // 0x40-0x4F - 8-bit load instructions
+    XY_LD_B_B = 0x40,           // LD B, B (same as unprefixed)
+    XY_LD_B_C = 0x41,           // LD B, C (same as unprefixed)
+    XY_LD_B_D = 0x42,           // LD B, D (same as unprefixed)
+    XY_LD_B_E = 0x43,           // LD B, E (same as unprefixed)
+    XY_LD_B_XYH = 0x44,         // LD B, XYH
+    XY_LD_B_XYL = 0x45,         // LD B, XYL
+    XY_LD_B_XY_D = 0x46,        // LD B, (XY+d)
+    XY_LD_B_A = 0x47,           // LD B, A (same as unprefixed)
+    XY_LD_C_B = 0x48,           // LD C, B (same as unprefixed)
+    XY_LD_C_C = 0x49,           // LD C, C (same as unprefixed)
+    XY_LD_C_D = 0x4A,           // LD C, D (same as unprefixed)
+    XY_LD_C_E = 0x4B,           // LD C, E (same as unprefixed)
+    XY_LD_C_XYH = 0x4C,         // LD C, XYH
+    XY_LD_C_XYL = 0x4D,         // LD C, XYL
+    XY_LD_C_XY_D = 0x4E,        // LD C, (XY+d)
+    XY_LD_C_A = 0x4F,           // LD C, A (same as unprefixed)
+    
+    // 0x50-0x5F
+    XY_LD_D_B = 0x50,           // LD D, B (same as unprefixed)
+    XY_LD_D_C = 0x51,           // LD D, C (same as unprefixed)
+    XY_LD_D_D = 0x52,           // LD D, D (same as unprefixed)
+    XY_LD_D_E = 0x53,           // LD D, E (same as unprefixed)
+    XY_LD_D_XYH = 0x54,         // LD D, XYH
+    XY_LD_D_XYL = 0x55,         // LD D, XYL
+    XY_LD_D_XY_D = 0x56,        // LD D, (XY+d)
+    XY_LD_D_A = 0x57,           // LD D, A (same as unprefixed)
+    XY_LD_E_B = 0x58,           // LD E, B (same as unprefixed)
+    XY_LD_E_C = 0x59,           // LD E, C (same as unprefixed)
+    XY_LD_E_D = 0x5A,           // LD E, D (same as unprefixed)
+    XY_LD_E_E = 0x5B,           // LD E, E (same as unprefixed)
+    XY_LD_E_XYH = 0x5C,         // LD E, XYH
+    XY_LD_E_XYL = 0x5D,         // LD E, XYL
+    XY_LD_E_XY_D = 0x5E,        // LD E, (XY+d)
+    XY_LD_E_A = 0x5F,           // LD E, A (same as unprefixed)
+    
+    // 0x60-0x6F
+    XY_LD_XYH_B = 0x60,         // LD XYH, B
+    XY_LD_XYH_C = 0x61,         // LD XYH, C
+    XY_LD_XYH_D = 0x62,         // LD XYH, D
+    XY_LD_XYH_E = 0x63,         // LD XYH, E
+    XY_LD_XYH_XYH = 0x64,       // LD XYH, XYH
+    XY_LD_XYH_XYL = 0x65,       // LD XYH, XYL
+    XY_LD_H_XY_D = 0x66,        // LD H, (XY+d)
+    XY_LD_XYH_A = 0x67,         // LD XYH, A
+    XY_LD_XYL_B = 0x68,         // LD XYL, B
+    XY_LD_XYL_C = 0x69,         // LD XYL, C
+    XY_LD_XYL_D = 0x6A,         // LD XYL, D
+    XY_LD_XYL_E = 0x6B,         // LD XYL, E
+    XY_LD_XYL_XYH = 0x6C,       // LD XYL, XYH
+    XY_LD_XYL_XYL = 0x6D,       // LD XYL, XYL
+    XY_LD_L_XY_D = 0x6E,        // LD L, (XY+d)
+    XY_LD_XYL_A = 0x6F,         // LD XYL, A
+    
+    // 0x70-0x7F
+    XY_LD_XY_D_B = 0x70,        // LD (XY+d), B
+    XY_LD_XY_D_C = 0x71,        // LD (XY+d), C
+    XY_LD_XY_D_D = 0x72,        // LD (XY+d), D
+    XY_LD_XY_D_E = 0x73,        // LD (XY+d), E
+    XY_LD_XY_D_H = 0x74,        // LD (XY+d), H
+    XY_LD_XY_D_L = 0x75,        // LD (XY+d), L
+    XY_HALT = 0x76,             // HALT (same as unprefixed)
+    XY_LD_XY_D_A = 0x77,        // LD (XY+d), A
+    XY_LD_A_B = 0x78,           // LD A, B (same as unprefixed)
+    XY_LD_A_C = 0x79,           // LD A, C (same as unprefixed)
+    XY_LD_A_D = 0x7A,           // LD A, D (same as unprefixed)
+    XY_LD_A_E = 0x7B,           // LD A, E (same as unprefixed)
+    XY_LD_A_XYH = 0x7C,         // LD A, XYH
+    XY_LD_A_XYL = 0x7D,         // LD A, XYL
+    XY_LD_A_XY_D = 0x7E,        // LD A, (XY+d)
+    XY_LD_A_A = 0x7F,           // LD A, A (same as unprefixed)
+    
+    // 0x80-0x8F - 8-bit arithmetic ADD/ADC
+    XY_ADD_A_B = 0x80,          // ADD A, B (same as unprefixed)
+    XY_ADD_A_C = 0x81,          // ADD A, C (same as unprefixed)
+    XY_ADD_A_D = 0x82,          // ADD A, D (same as unprefixed)
+    XY_ADD_A_E = 0x83,          // ADD A, E (same as unprefixed)
+    XY_ADD_A_XYH = 0x84,        // ADD A, XYH
+    XY_ADD_A_XYL = 0x85,        // ADD A, XYL
+    XY_ADD_A_XY_D = 0x86,       // ADD A, (XY+d)
+    XY_ADD_A_A = 0x87,          // ADD A, A (same as unprefixed)
+    XY_ADC_A_B = 0x88,          // ADC A, B (same as unprefixed)
+    XY_ADC_A_C = 0x89,          // ADC A, C (same as unprefixed)
+    XY_ADC_A_D = 0x8A,          // ADC A, D (same as unprefixed)
+    XY_ADC_A_E = 0x8B,          // ADC A, E (same as unprefixed)
+    XY_ADC_A_XYH = 0x8C,        // ADC A, XYH
+    XY_ADC_A_XYL = 0x8D,        // ADC A, XYL
+    XY_ADC_A_XY_D = 0x8E,       // ADC A, (XY+d)
+    XY_ADC_A_A = 0x8F,          // ADC A, A (same as unprefixed)
+    
+    // 0x90-0x9F - 8-bit arithmetic SUB/SBC
+    XY_SUB_A_B = 0x90,          // SUB A, B (same as unprefixed)
+    XY_SUB_A_C = 0x91,          // SUB A, C (same as unprefixed)
+    XY_SUB_A_D = 0x92,          // SUB A, D (same as unprefixed)
+    XY_SUB_A_E = 0x93,          // SUB A, E (same as unprefixed)
+    XY_SUB_A_XYH = 0x94,        // SUB A, XYH
+    XY_SUB_A_XYL = 0x95,        // SUB A, XYL
+    XY_SUB_A_XY_D = 0x96,       // SUB A, (XY+d)
+    XY_SUB_A_A = 0x97,          // SUB A, A (same as unprefixed)
+    XY_SBC_A_B = 0x98,          // SBC A, B (same as unprefixed)
+    XY_SBC_A_C = 0x99,          // SBC A, C (same as unprefixed)
+    XY_SBC_A_D = 0x9A,          // SBC A, D (same as unprefixed)
+    XY_SBC_A_E = 0x9B,          // SBC A, E (same as unprefixed)
+    XY_SBC_A_XYH = 0x9C,        // SBC A, XYH
+    XY_SBC_A_XYL = 0x9D,        // SBC A, XYL
+    XY_SBC_A_XY_D = 0x9E,       // SBC A, (XY+d)
+    XY_SBC_A_A = 0x9F,          // SBC A, A (same as unprefixed)
+    
+    // 0xA0-0xAF - 8-bit logical AND/XOR
+    XY_AND_A_B = 0xA0,          // AND A, B (same as unprefixed)
+    XY_AND_A_C = 0xA1,          // AND A, C (same as unprefixed)
+    XY_AND_A_D = 0xA2,          // AND A, D (same as unprefixed)
+    XY_AND_A_E = 0xA3,          // AND A, E (same as unprefixed)
+    XY_AND_A_XYH = 0xA4,        // AND A, XYH
+    XY_AND_A_XYL = 0xA5,        // AND A, XYL
+    XY_AND_A_XY_D = 0xA6,       // AND A, (XY+d)
+    XY_AND_A_A = 0xA7,          // AND A, A (same as unprefixed)
+    XY_XOR_A_B = 0xA8,          // XOR A, B (same as unprefixed)
+    XY_XOR_A_C = 0xA9,          // XOR A, C (same as unprefixed)
+    XY_XOR_A_D = 0xAA,          // XOR A, D (same as unprefixed)
+    XY_XOR_A_E = 0xAB,          // XOR A, E (same as unprefixed)
+    XY_XOR_A_XYH = 0xAC,        // XOR A, XYH
+    XY_XOR_A_XYL = 0xAD,        // XOR A, XYL
+    XY_XOR_A_XY_D = 0xAE,       // XOR A, (XY+d)
+    XY_XOR_A_A = 0xAF,          // XOR A, A (same as unprefixed)
+    
+    // 0xB0-0xBF - 8-bit logical OR/CP
+    XY_OR_A_B = 0xB0,           // OR A, B (same as unprefixed)
+    XY_OR_A_C = 0xB1,           // OR A, C (same as unprefixed)
+    XY_OR_A_D = 0xB2,           // OR A, D (same as unprefixed)
+    XY_OR_A_E = 0xB3,           // OR A, E (same as unprefixed)
+    XY_OR_A_XYH = 0xB4,         // OR A, XYH
+    XY_OR_A_XYL = 0xB5,         // OR A, XYL
+    XY_OR_A_XY_D = 0xB6,        // OR A, (XY+d)
+    XY_OR_A_A = 0xB7,           // OR A, A (same as unprefixed)
+    XY_CP_A_B = 0xB8,           // CP A, B (same as unprefixed)
+    XY_CP_A_C = 0xB9,           // CP A, C (same as unprefixed)
+    XY_CP_A_D = 0xBA,           // CP A, D (same as unprefixed)
+    XY_CP_A_E = 0xBB,           // CP A, E (same as unprefixed)
+    XY_CP_A_XYH = 0xBC,         // CP A, XYH
+    XY_CP_A_XYL = 0xBD,         // CP A, XYL
+    XY_CP_A_XY_D = 0xBE,        // CP A, (XY+d)
+    XY_CP_A_A = 0xBF,           // CP A, A (same as unprefixed)
+    
+    // 0xC0-0xCF - Conditional returns, jumps, calls
+    XY_RET_NZ = 0xC0,           // RET NZ (same as unprefixed)
+    XY_POP_BC = 0xC1,           // POP BC (same as unprefixed)
+    XY_JP_NZ_NN = 0xC2,         // JP NZ, NN (same as unprefixed)
+    XY_JP_NN = 0xC3,            // JP NN (same as unprefixed)
+    XY_CALL_NZ_NN = 0xC4,       // CALL NZ, NN (same as unprefixed)
+    XY_PUSH_BC = 0xC5,          // PUSH BC (same as unprefixed)
+    XY_ADD_A_N = 0xC6,          // ADD A, n (same as unprefixed)
+    XY_RST_00 = 0xC7,           // RST 00 (same as unprefixed)
+    XY_RET_Z = 0xC8,            // RET Z (same as unprefixed)
+    XY_RET = 0xC9,              // RET (same as unprefixed)
+    XY_JP_Z_NN = 0xCA,          // JP Z, NN (same as unprefixed)
+    XY_PREFIX_CB = 0xCB,        // CB prefix (bit operations on (XY+d))
+    XY_CALL_Z_NN = 0xCC,        // CALL Z, NN (same as unprefixed)
+    XY_CALL_NN = 0xCD,          // CALL NN (same as unprefixed)
+    XY_ADC_A_N = 0xCE,          // ADC A, n (same as unprefixed)
+    XY_RST_08 = 0xCF,           // RST 08 (same as unprefixed)
+    
+    // 0xD0-0xDF
+    XY_RET_NC = 0xD0,           // RET NC (same as unprefixed)
+    XY_POP_DE = 0xD1,           // POP DE (same as unprefixed)
+    XY_JP_NC_NN = 0xD2,         // JP NC, NN (same as unprefixed)
+    XY_OUT_N_A = 0xD3,          // OUT (n), A (same as unprefixed)
+    XY_CALL_NC_NN = 0xD4,       // CALL NC, NN (same as unprefixed)
+    XY_PUSH_DE = 0xD5,          // PUSH DE (same as unprefixed)
+    XY_SUB_A_N = 0xD6,          // SUB A, n (same as unprefixed)
+    XY_RST_10 = 0xD7,           // RST 10 (same as unprefixed)
+    XY_RET_C = 0xD8,            // RET C (same as unprefixed)
+    XY_EXX = 0xD9,              // EXX (same as unprefixed)
+    XY_JP_C_NN = 0xDA,          // JP C, NN (same as unprefixed)
+    XY_IN_A_N = 0xDB,           // IN A, (n) (same as unprefixed)
+    XY_CALL_C_NN = 0xDC,        // CALL C, NN (same as unprefixed)
+    XY_PREFIX_DD = 0xDD,        // DD prefix (same as unprefixed)
+    XY_SBC_A_N = 0xDE,          // SBC A, n (same as unprefixed)
+    XY_RST_18 = 0xDF,           // RST 18 (same as unprefixed)
+    
+    // 0xE0-0xEF
+    XY_RET_PO = 0xE0,           // RET PO (same as unprefixed)
+    XY_POP_XY = 0xE1,           // POP XY
+    XY_JP_PO_NN = 0xE2,         // JP PO, NN (same as unprefixed)
+    XY_EX_SP_XY = 0xE3,         // EX (SP), XY
+    XY_CALL_PO_NN = 0xE4,       // CALL PO, NN (same as unprefixed)
+    XY_PUSH_XY = 0xE5,          // PUSH XY
+    XY_AND_A_N = 0xE6,          // AND A, n (same as unprefixed)
+    XY_RST_20 = 0xE7,           // RST 20 (same as unprefixed)
+    XY_RET_PE = 0xE8,           // RET PE (same as unprefixed)
+    XY_JP_XY = 0xE9,            // JP (XY)
+    XY_JP_PE_NN = 0xEA,         // JP PE, NN (same as unprefixed)
+    XY_EX_DE_HL = 0xEB,         // EX DE, HL (same as unprefixed)
+    XY_CALL_PE_NN = 0xEC,       // CALL PE, NN (same as unprefixed)
+    XY_PREFIX_ED = 0xED,        // ED prefix (same as unprefixed)
+    XY_XOR_A_N = 0xEE,          // XOR A, n (same as unprefixed)
+    XY_RST_28 = 0xEF,           // RST 28 (same as unprefixed)
+    
+    // 0xF0-0xFF
+    XY_RET_P = 0xF0,            // RET P (same as unprefixed)
+    XY_POP_AF = 0xF1,           // POP AF (same as unprefixed)
+    XY_JP_P_NN = 0xF2,          // JP P, NN (same as unprefixed)
+    XY_DI = 0xF3,               // DI (same as unprefixed)
+    XY_CALL_P_NN = 0xF4,        // CALL P, NN (same as unprefixed)
+    XY_PUSH_AF = 0xF5,          // PUSH AF (same as unprefixed)
+    XY_OR_A_N = 0xF6,           // OR A, n (same as unprefixed)
+    XY_RST_30 = 0xF7,           // RST 30 (same as unprefixed)
+    XY_RET_M = 0xF8,            // RET M (same as unprefixed)
+    XY_LD_SP_XY = 0xF9,         // LD SP, XY
+    XY_JP_M_NN = 0xFA,          // JP M, NN (same as unprefixed)
+    XY_EI = 0xFB,               // EI (same as unprefixed)
+    XY_CALL_M_NN = 0xFC,        // CALL M, NN (same as unprefixed)
+    XY_PREFIX_FD = 0xFD,        // FD prefix (same as unprefixed)
+    XY_CP_A_N = 0xFE,           // CP A, n (same as unprefixed)
+    XY_RST_38 = 0xFF            // RST 38 (same as unprefixed)
+};
+
+// Z80 DD-CB/FD-CB Opcode enumeration (complete set)
+enum z80_index_cb_opcodes
+{
+    // ROTATE LEFT CIRCULAR (RLC) - 8-bit registers
+    XY_CB_RLC_B = 0x00,  // RLC B
+    XY_CB_RLC_C = 0x01,  // RLC C
+    XY_CB_RLC_D = 0x02,  // RLC D
+    XY_CB_RLC_E = 0x03,  // RLC E
+    XY_CB_RLC_H = 0x04,  // RLC H
+    XY_CB_RLC_L = 0x05,  // RLC L
+    XY_CB_RLC_HL = 0x06, // RLC (HL)
+    XY_CB_RLC_A = 0x07,  // RLC A
+
+    // ROTATE RIGHT CIRCULAR (RRC) - 8-bit registers
+    XY_CB_RRC_B = 0x08,  // RRC B
+    XY_CB_RRC_C = 0x09,  // RRC C
+    XY_CB_RRC_D = 0x0A,  // RRC D
+    XY_CB_RRC_E = 0x0B,  // RRC E
+    XY_CB_RRC_H = 0x0C,  // RRC H
+    XY_CB_RRC_L = 0x0D,  // RRC L
+    XY_CB_RRC_HL = 0x0E, // RRC (HL)
+    XY_CB_RRC_A = 0x0F,  // RRC A
+
+    // ROTATE LEFT (RL) - 8-bit registers
+    XY_CB_RL_B = 0x10,  // RL B
+    XY_CB_RL_C = 0x11,  // RL C
+    XY_CB_RL_D = 0x12,  // RL D
+    XY_CB_RL_E = 0x13,  // RL E
+    XY_CB_RL_H = 0x14,  // RL H
+    XY_CB_RL_L = 0x15,  // RL L
+    XY_CB_RL_HL = 0x16, // RL (HL)
+    XY_CB_RL_A = 0x17,  // RL A
+
+    // ROTATE RIGHT (RR) - 8-bit registers
+    XY_CB_RR_B = 0x18,  // RR B
+    XY_CB_RR_C = 0x19,  // RR C
+    XY_CB_RR_D = 0x1A,  // RR D
+    XY_CB_RR_E = 0x1B,  // RR E
+    XY_CB_RR_H = 0x1C,  // RR H
+    XY_CB_RR_L = 0x1D,  // RR L
+    XY_CB_RR_HL = 0x1E, // RR (HL)
+    XY_CB_RR_A = 0x1F,  // RR A
+
+    // SHIFT LEFT ARITHMETIC (SLA) - 8-bit registers
+    XY_CB_SLA_B = 0x20,  // SLA B
+    XY_CB_SLA_C = 0x21,  // SLA C
+    XY_CB_SLA_D = 0x22,  // SLA D
+    XY_CB_SLA_E = 0x23,  // SLA E
+    XY_CB_SLA_H = 0x24,  // SLA H
+    XY_CB_SLA_L = 0x25,  // SLA L
+    XY_CB_SLA_HL = 0x26, // SLA (HL)
+    XY_CB_SLA_A = 0x27,  // SLA A
+
+    // SHIFT RIGHT ARITHMETIC (SRA) - 8-bit registers
+    XY_CB_SRA_B = 0x28,  // SRA B
+    XY_CB_SRA_C = 0x29,  // SRA C
+    XY_CB_SRA_D = 0x2A,  // SRA D
+    XY_CB_SRA_E = 0x2B,  // SRA E
+    XY_CB_SRA_H = 0x2C,  // SRA H
+    XY_CB_SRA_L = 0x2D,  // SRA L
+    XY_CB_SRA_HL = 0x2E, // SRA (HL)
+    XY_CB_SRA_A = 0x2F,  // SRA A
+
+    // SHIFT LEFT LOGICAL (SLL) - 8-bit registers (undocumented)
+    XY_CB_SLL_B = 0x30,  // SLL B
+    XY_CB_SLL_C = 0x31,  // SLL C
+    XY_CB_SLL_D = 0x32,  // SLL D
+    XY_CB_SLL_E = 0x33,  // SLL E
+    XY_CB_SLL_H = 0x34,  // SLL H
+    XY_CB_SLL_L = 0x35,  // SLL L
+    XY_CB_SLL_HL = 0x36, // SLL (HL)
+    XY_CB_SLL_A = 0x37,  // SLL A
+
+    // SHIFT RIGHT LOGICAL (SRL) - 8-bit registers
+    XY_CB_SRL_B = 0x38,  // SRL B
+    XY_CB_SRL_C = 0x39,  // SRL C
+    XY_CB_SRL_D = 0x3A,  // SRL D
+    XY_CB_SRL_E = 0x3B,  // SRL E
+    XY_CB_SRL_H = 0x3C,  // SRL H
+    XY_CB_SRL_L = 0x3D,  // SRL L
+    XY_CB_SRL_HL = 0x3E, // SRL (HL)
+    XY_CB_SRL_A = 0x3F,  // SRL A
+
+    // BIT TEST - Bit 0
+    XY_CB_BIT_0_B = 0x40,  // BIT 0, B
+    XY_CB_BIT_0_C = 0x41,  // BIT 0, C
+    XY_CB_BIT_0_D = 0x42,  // BIT 0, D
+    XY_CB_BIT_0_E = 0x43,  // BIT 0, E
+    XY_CB_BIT_0_H = 0x44,  // BIT 0, H
+    XY_CB_BIT_0_L = 0x45,  // BIT 0, L
+    XY_CB_BIT_0_HL = 0x46, // BIT 0, (HL)
+    XY_CB_BIT_0_A = 0x47,  // BIT 0, A
+
+    // BIT TEST - Bit 1
+    XY_CB_BIT_1_B = 0x48,  // BIT 1, B
+    XY_CB_BIT_1_C = 0x49,  // BIT 1, C
+    XY_CB_BIT_1_D = 0x4A,  // BIT 1, D
+    XY_CB_BIT_1_E = 0x4B,  // BIT 1, E
+    XY_CB_BIT_1_H = 0x4C,  // BIT 1, H
+    XY_CB_BIT_1_L = 0x4D,  // BIT 1, L
+    XY_CB_BIT_1_HL = 0x4E, // BIT 1, (HL)
+    XY_CB_BIT_1_A = 0x4F,  // BIT 1, A
+
+    // BIT TEST - Bit 2
+    XY_CB_BIT_2_B = 0x50,  // BIT 2, B
+    XY_CB_BIT_2_C = 0x51,  // BIT 2, C
+    XY_CB_BIT_2_D = 0x52,  // BIT 2, D
+    XY_CB_BIT_2_E = 0x53,  // BIT 2, E
+    XY_CB_BIT_2_H = 0x54,  // BIT 2, H
+    XY_CB_BIT_2_L = 0x55,  // BIT 2, L
+    XY_CB_BIT_2_HL = 0x56, // BIT 2, (HL)
+    XY_CB_BIT_2_A = 0x57,  // BIT 2, A
+
+    // BIT TEST - Bit 3
+    XY_CB_BIT_3_B = 0x58,  // BIT 3, B
+    XY_CB_BIT_3_C = 0x59,  // BIT 3, C
+    XY_CB_BIT_3_D = 0x5A,  // BIT 3, D
+    XY_CB_BIT_3_E = 0x5B,  // BIT 3, E
+    XY_CB_BIT_3_H = 0x5C,  // BIT 3, H
+    XY_CB_BIT_3_L = 0x5D,  // BIT 3, L
+    XY_CB_BIT_3_HL = 0x5E, // BIT 3, (HL)
+    XY_CB_BIT_3_A = 0x5F,  // BIT 3, A
+
+    // BIT TEST - Bit 4
+    XY_CB_BIT_4_B = 0x60,  // BIT 4, B
+    XY_CB_BIT_4_C = 0x61,  // BIT 4, C
+    XY_CB_BIT_4_D = 0x62,  // BIT 4, D
+    XY_CB_BIT_4_E = 0x63,  // BIT 4, E
+    XY_CB_BIT_4_H = 0x64,  // BIT 4, H
+    XY_CB_BIT_4_L = 0x65,  // BIT 4, L
+    XY_CB_BIT_4_HL = 0x66, // BIT 4, (HL)
+    XY_CB_BIT_4_A = 0x67,  // BIT 4, A
+
+    // BIT TEST - Bit 5
+    XY_CB_BIT_5_B = 0x68,  // BIT 5, B
+    XY_CB_BIT_5_C = 0x69,  // BIT 5, C
+    XY_CB_BIT_5_D = 0x6A,  // BIT 5, D
+    XY_CB_BIT_5_E = 0x6B,  // BIT 5, E
+    XY_CB_BIT_5_H = 0x6C,  // BIT 5, H
+    XY_CB_BIT_5_L = 0x6D,  // BIT 5, L
+    XY_CB_BIT_5_HL = 0x6E, // BIT 5, (HL)
+    XY_CB_BIT_5_A = 0x6F,  // BIT 5, A
+
+    // BIT TEST - Bit 6
+    XY_CB_BIT_6_B = 0x70,  // BIT 6, B
+    XY_CB_BIT_6_C = 0x71,  // BIT 6, C
+    XY_CB_BIT_6_D = 0x72,  // BIT 6, D
+    XY_CB_BIT_6_E = 0x73,  // BIT 6, E
+    XY_CB_BIT_6_H = 0x74,  // BIT 6, H
+    XY_CB_BIT_6_L = 0x75,  // BIT 6, L
+    XY_CB_BIT_6_HL = 0x76, // BIT 6, (HL)
+    XY_CB_BIT_6_A = 0x77,  // BIT 6, A
+
+    // BIT TEST - Bit 7
+    XY_CB_BIT_7_B = 0x78,  // BIT 7, B
+    XY_CB_BIT_7_C = 0x79,  // BIT 7, C
+    XY_CB_BIT_7_D = 0x7A,  // BIT 7, D
+    XY_CB_BIT_7_E = 0x7B,  // BIT 7, E
+    XY_CB_BIT_7_H = 0x7C,  // BIT 7, H
+    XY_CB_BIT_7_L = 0x7D,  // BIT 7, L
+    XY_CB_BIT_7_HL = 0x7E, // BIT 7, (HL)
+    XY_CB_BIT_7_A = 0x7F,  // BIT 7, A
+
+    // BIT RESET - Bit 0
+    XY_CB_RES_0_B = 0x80,  // RES 0, B
+    XY_CB_RES_0_C = 0x81,  // RES 0, C
+    XY_CB_RES_0_D = 0x82,  // RES 0, D
+    XY_CB_RES_0_E = 0x83,  // RES 0, E
+    XY_CB_RES_0_H = 0x84,  // RES 0, H
+    XY_CB_RES_0_L = 0x85,  // RES 0, L
+    XY_CB_RES_0_HL = 0x86, // RES 0, (HL)
+    XY_CB_RES_0_A = 0x87,  // RES 0, A
+
+    // BIT RESET - Bit 1
+    XY_CB_RES_1_B = 0x88,  // RES 1, B
+    XY_CB_RES_1_C = 0x89,  // RES 1, C
+    XY_CB_RES_1_D = 0x8A,  // RES 1, D
+    XY_CB_RES_1_E = 0x8B,  // RES 1, E
+    XY_CB_RES_1_H = 0x8C,  // RES 1, H
+    XY_CB_RES_1_L = 0x8D,  // RES 1, L
+    XY_CB_RES_1_HL = 0x8E, // RES 1, (HL)
+    XY_CB_RES_1_A = 0x8F,  // RES 1, A
+
+    // BIT RESET - Bit 2
+    XY_CB_RES_2_B = 0x90,  // RES 2, B
+    XY_CB_RES_2_C = 0x91,  // RES 2, C
+    XY_CB_RES_2_D = 0x92,  // RES 2, D
+    XY_CB_RES_2_E = 0x93,  // RES 2, E
+    XY_CB_RES_2_H = 0x94,  // RES 2, H
+    XY_CB_RES_2_L = 0x95,  // RES 2, L
+    XY_CB_RES_2_HL = 0x96, // RES 2, (HL)
+    XY_CB_RES_2_A = 0x97,  // RES 2, A
+
+    // BIT RESET - Bit 3
+    XY_CB_RES_3_B = 0x98,  // RES 3, B
+    XY_CB_RES_3_C = 0x99,  // RES 3, C
+    XY_CB_RES_3_D = 0x9A,  // RES 3, D
+    XY_CB_RES_3_E = 0x9B,  // RES 3, E
+    XY_CB_RES_3_H = 0x9C,  // RES 3, H
+    XY_CB_RES_3_L = 0x9D,  // RES 3, L
+    XY_CB_RES_3_HL = 0x9E, // RES 3, (HL)
+    XY_CB_RES_3_A = 0x9F,  // RES 3, A
+
+    // BIT RESET - Bit 4
+    XY_CB_RES_4_B = 0xA0,  // RES 4, B
+    XY_CB_RES_4_C = 0xA1,  // RES 4, C
+    XY_CB_RES_4_D = 0xA2,  // RES 4, D
+    XY_CB_RES_4_E = 0xA3,  // RES 4, E
+    XY_CB_RES_4_H = 0xA4,  // RES 4, H
+    XY_CB_RES_4_L = 0xA5,  // RES 4, L
+    XY_CB_RES_4_HL = 0xA6, // RES 4, (HL)
+    XY_CB_RES_4_A = 0xA7,  // RES 4, A
+
+    // BIT RESET - Bit 5
+    XY_CB_RES_5_B = 0xA8,  // RES 5, B
+    XY_CB_RES_5_C = 0xA9,  // RES 5, C
+    XY_CB_RES_5_D = 0xAA,  // RES 5, D
+    XY_CB_RES_5_E = 0xAB,  // RES 5, E
+    XY_CB_RES_5_H = 0xAC,  // RES 5, H
+    XY_CB_RES_5_L = 0xAD,  // RES 5, L
+    XY_CB_RES_5_HL = 0xAE, // RES 5, (HL)
+    XY_CB_RES_5_A = 0xAF,  // RES 5, A
+
+    // BIT RESET - Bit 6
+    XY_CB_RES_6_B = 0xB0,  // RES 6, B
+    XY_CB_RES_6_C = 0xB1,  // RES 6, C
+    XY_CB_RES_6_D = 0xB2,  // RES 6, D
+    XY_CB_RES_6_E = 0xB3,  // RES 6, E
+    XY_CB_RES_6_H = 0xB4,  // RES 6, H
+    XY_CB_RES_6_L = 0xB5,  // RES 6, L
+    XY_CB_RES_6_HL = 0xB6, // RES 6, (HL)
+    XY_CB_RES_6_A = 0xB7,  // RES 6, A
+
+    // BIT RESET - Bit 7
+    XY_CB_RES_7_B = 0xB8,  // RES 7, B
+    XY_CB_RES_7_C = 0xB9,  // RES 7, C
+    XY_CB_RES_7_D = 0xBA,  // RES 7, D
+    XY_CB_RES_7_E = 0xBB,  // RES 7, E
+    XY_CB_RES_7_H = 0xBC,  // RES 7, H
+    XY_CB_RES_7_L = 0xBD,  // RES 7, L
+    XY_CB_RES_7_HL = 0xBE, // RES 7, (HL)
+    XY_CB_RES_7_A = 0xBF,  // RES 7, A
+
+    // BIT SET - Bit 0
+    XY_CB_SET_0_B = 0xC0,  // SET 0, B
+    XY_CB_SET_0_C = 0xC1,  // SET 0, C
+    XY_CB_SET_0_D = 0xC2,  // SET 0, D
+    XY_CB_SET_0_E = 0xC3,  // SET 0, E
+    XY_CB_SET_0_H = 0xC4,  // SET 0, H
+    XY_CB_SET_0_L = 0xC5,  // SET 0, L
+    XY_CB_SET_0_HL = 0xC6, // SET 0, (HL)
+    XY_CB_SET_0_A = 0xC7,  // SET 0, A
+
+    // BIT SET - Bit 1
+    XY_CB_SET_1_B = 0xC8,  // SET 1, B
+    XY_CB_SET_1_C = 0xC9,  // SET 1, C
+    XY_CB_SET_1_D = 0xCA,  // SET 1, D
+    XY_CB_SET_1_E = 0xCB,  // SET 1, E
+    XY_CB_SET_1_H = 0xCC,  // SET 1, H
+    XY_CB_SET_1_L = 0xCD,  // SET 1, L
+    XY_CB_SET_1_HL = 0xCE, // SET 1, (HL)
+    XY_CB_SET_1_A = 0xCF,  // SET 1, A
+
+    // BIT SET - Bit 2
+    XY_CB_SET_2_B = 0xD0,  // SET 2, B
+    XY_CB_SET_2_C = 0xD1,  // SET 2, C
+    XY_CB_SET_2_D = 0xD2,  // SET 2, D
+    XY_CB_SET_2_E = 0xD3,  // SET 2, E
+    XY_CB_SET_2_H = 0xD4,  // SET 2, H
+    XY_CB_SET_2_L = 0xD5,  // SET 2, L
+    XY_CB_SET_2_HL = 0xD6, // SET 2, (HL)
+    XY_CB_SET_2_A = 0xD7,  // SET 2, A
+
+    // BIT SET - Bit 3
+    XY_CB_SET_3_B = 0xD8,  // SET 3, B
+    XY_CB_SET_3_C = 0xD9,  // SET 3, C
+    XY_CB_SET_3_D = 0xDA,  // SET 3, D
+    XY_CB_SET_3_E = 0xDB,  // SET 3, E
+    XY_CB_SET_3_H = 0xDC,  // SET 3, H
+    XY_CB_SET_3_L = 0xDD,  // SET 3, L
+    XY_CB_SET_3_HL = 0xDE, // SET 3, (HL)
+    XY_CB_SET_3_A = 0xDF,  // SET 3, A
+
+    // BIT SET - Bit 4
+    XY_CB_SET_4_B = 0xE0,  // SET 4, B
+    XY_CB_SET_4_C = 0xE1,  // SET 4, C
+    XY_CB_SET_4_D = 0xE2,  // SET 4, D
+    XY_CB_SET_4_E = 0xE3,  // SET 4, E
+    XY_CB_SET_4_H = 0xE4,  // SET 4, H
+    XY_CB_SET_4_L = 0xE5,  // SET 4, L
+    XY_CB_SET_4_HL = 0xE6, // SET 4, (HL)
+    XY_CB_SET_4_A = 0xE7,  // SET 4, A
+
+    // BIT SET - Bit 5
+    XY_CB_SET_5_B = 0xE8,  // SET 5, B
+    XY_CB_SET_5_C = 0xE9,  // SET 5, C
+    XY_CB_SET_5_D = 0xEA,  // SET 5, D
+    XY_CB_SET_5_E = 0xEB,  // SET 5, E
+    XY_CB_SET_5_H = 0xEC,  // SET 5, H
+    XY_CB_SET_5_L = 0xED,  // SET 5, L
+    XY_CB_SET_5_HL = 0xEE, // SET 5, (HL)
+    XY_CB_SET_5_A = 0xEF,  // SET 5, A
+
+    // BIT SET - Bit 6
+    XY_CB_SET_6_B = 0xF0,  // SET 6, B
+    XY_CB_SET_6_C = 0xF1,  // SET 6, C
+    XY_CB_SET_6_D = 0xF2,  // SET 6, D
+    XY_CB_SET_6_E = 0xF3,  // SET 6, E
+    XY_CB_SET_6_H = 0xF4,  // SET 6, H
+    XY_CB_SET_6_L = 0xF5,  // SET 6, L
+    XY_CB_SET_6_HL = 0xF6, // SET 6, (HL)
+    XY_CB_SET_6_A = 0xF7,  // SET 6, A
+
+    // BIT SET - Bit 7
+    XY_CB_SET_7_B = 0xF8,  // SET 7, B
+    XY_CB_SET_7_C = 0xF9,  // SET 7, C
+    XY_CB_SET_7_D = 0xFA,  // SET 7, D
+    XY_CB_SET_7_E = 0xFB,  // SET 7, E
+    XY_CB_SET_7_H = 0xFC,  // SET 7, H
+    XY_CB_SET_7_L = 0xFD,  // SET 7, L
+    XY_CB_SET_7_HL = 0xFE, // SET 7, (HL)
+    XY_CB_SET_7_A = 0xFF   // SET 7, A
+};
+
+// DD CB d op / FD CB d op, with (XY+d) already resolved to addr
+static void execute_index_cb(struct z80_t *cpu, enum z80_stats_page page, uint16_t addr)
+{
+    uint8_t cb_opcode = z80_fetch8(cpu);
+    cpu->cycle_count += z80_timing_xycb[cb_opcode];
+    z80_stats_count(cpu, page, cb_opcode);
+    switch (cb_opcode)
+    {
+    // ROTATE LEFT CIRCULAR (RLC) - 8-bit registers
+    case XY_CB_RLC_B: cpu->registers.B = z80_op_rlc(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_RLC_C: cpu->registers.C = z80_op_rlc(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_RLC_D: cpu->registers.D = z80_op_rlc(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_RLC_E: cpu->registers.E = z80_op_rlc(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_RLC_H: cpu->registers.H = z80_op_rlc(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_RLC_L: cpu->registers.L = z80_op_rlc(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_RLC_HL: z80_write8(cpu, addr, z80_op_rlc(cpu, z80_read8(cpu, addr))); break;
+    case XY_CB_RLC_A: cpu->registers.A = z80_op_rlc(cpu, z80_read8(cpu, addr)); break;
+
+    // ROTATE RIGHT CIRCULAR (RRC) - 8-bit registers
+    case XY_CB_RRC_B: cpu->registers.B = z80_op_rrc(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_RRC_C: cpu->registers.C = z80_op_rrc(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_RRC_D: cpu->registers.D = z80_op_rrc(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_RRC_E: cpu->registers.E = z80_op_rrc(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_RRC_H: cpu->registers.H = z80_op_rrc(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_RRC_L: cpu->registers.L = z80_op_rrc(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_RRC_HL: z80_write8(cpu, addr, z80_op_rrc(cpu, z80_read8(cpu, addr))); break;
+    case XY_CB_RRC_A: cpu->registers.A = z80_op_rrc(cpu, z80_read8(cpu, addr)); break;
+
+    // ROTATE LEFT (RL) - 8-bit registers
+    case XY_CB_RL_B: cpu->registers.B = z80_op_rl(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_RL_C: cpu->registers.C = z80_op_rl(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_RL_D: cpu->registers.D = z80_op_rl(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_RL_E: cpu->registers.E = z80_op_rl(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_RL_H: cpu->registers.H = z80_op_rl(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_RL_L: cpu->registers.L = z80_op_rl(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_RL_HL: z80_write8(cpu, addr, z80_op_rl(cpu, z80_read8(cpu, addr))); break;
+    case XY_CB_RL_A: cpu->registers.A = z80_op_rl(cpu, z80_read8(cpu, addr)); break;
+
+    // ROTATE RIGHT (RR) - 8-bit registers
+    case XY_CB_RR_B: cpu->registers.B = z80_op_rr(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_RR_C: cpu->registers.C = z80_op_rr(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_RR_D: cpu->registers.D = z80_op_rr(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_RR_E: cpu->registers.E = z80_op_rr(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_RR_H: cpu->registers.H = z80_op_rr(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_RR_L: cpu->registers.L = z80_op_rr(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_RR_HL: z80_write8(cpu, addr, z80_op_rr(cpu, z80_read8(cpu, addr))); break;
+    case XY_CB_RR_A: cpu->registers.A = z80_op_rr(cpu, z80_read8(cpu, addr)); break;
+
+    // SHIFT LEFT ARITHMETIC (SLA) - 8-bit registers
+    case XY_CB_SLA_B: cpu->registers.B = z80_op_sla(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_SLA_C: cpu->registers.C = z80_op_sla(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_SLA_D: cpu->registers.D = z80_op_sla(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_SLA_E: cpu->registers.E = z80_op_sla(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_SLA_H: cpu->registers.H = z80_op_sla(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_SLA_L: cpu->registers.L = z80_op_sla(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_SLA_HL: z80_write8(cpu, addr, z80_op_sla(cpu, z80_read8(cpu, addr))); break;
+    case XY_CB_SLA_A: cpu->registers.A = z80_op_sla(cpu, z80_read8(cpu, addr)); break;
+
+    // SHIFT RIGHT ARITHMETIC (SRA) - 8-bit registers
+    case XY_CB_SRA_B: cpu->registers.B = z80_op_sra(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_SRA_C: cpu->registers.C = z80_op_sra(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_SRA_D: cpu->registers.D = z80_op_sra(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_SRA_E: cpu->registers.E = z80_op_sra(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_SRA_H: cpu->registers.H = z80_op_sra(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_SRA_L: cpu->registers.L = z80_op_sra(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_SRA_HL: z80_write8(cpu, addr, z80_op_sra(cpu, z80_read8(cpu, addr))); break;
+    case XY_CB_SRA_A: cpu->registers.A = z80_op_sra(cpu, z80_read8(cpu, addr)); break;
+
+    // SHIFT LEFT LOGICAL (SLL) - 8-bit registers (undocumented)
+    case XY_CB_SLL_B: cpu->registers.B = z80_op_sll(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_SLL_C: cpu->registers.C = z80_op_sll(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_SLL_D: cpu->registers.D = z80_op_sll(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_SLL_E: cpu->registers.E = z80_op_sll(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_SLL_H: cpu->registers.H = z80_op_sll(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_SLL_L: cpu->registers.L = z80_op_sll(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_SLL_HL: z80_write8(cpu, addr, z80_op_sll(cpu, z80_read8(cpu, addr))); break;
+    case XY_CB_SLL_A: cpu->registers.A = z80_op_sll(cpu, z80_read8(cpu, addr)); break;
+
+    // SHIFT RIGHT LOGICAL (SRL) - 8-bit registers
+    case XY_CB_SRL_B: cpu->registers.B = z80_op_srl(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_SRL_C: cpu->registers.C = z80_op_srl(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_SRL_D: cpu->registers.D = z80_op_srl(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_SRL_E: cpu->registers.E = z80_op_srl(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_SRL_H: cpu->registers.H = z80_op_srl(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_SRL_L: cpu->registers.L = z80_op_srl(cpu, z80_read8(cpu, addr)); break;
+    case XY_CB_SRL_HL: z80_write8(cpu, addr, z80_op_srl(cpu, z80_read8(cpu, addr))); break;
+    case XY_CB_SRL_A: cpu->registers.A = z80_op_srl(cpu, z80_read8(cpu, addr)); break;
+
+    // BIT TEST - Bit 0
+    case XY_CB_BIT_0_B: 
+    case XY_CB_BIT_0_C: 
+    case XY_CB_BIT_0_D: 
+    case XY_CB_BIT_0_E: 
+    case XY_CB_BIT_0_H: 
+    case XY_CB_BIT_0_L: 
+    case XY_CB_BIT_0_HL: 
+    case XY_CB_BIT_0_A: z80_op_bit(cpu, 0, z80_read8(cpu, (uint16_t)addr)); break;
+
+    // BIT TEST - Bit 1
+    case XY_CB_BIT_1_B: 
+    case XY_CB_BIT_1_C: 
+    case XY_CB_BIT_1_D: 
+    case XY_CB_BIT_1_E: 
+    case XY_CB_BIT_1_H: 
+    case XY_CB_BIT_1_L: 
+    case XY_CB_BIT_1_HL: 
+    case XY_CB_BIT_1_A: z80_op_bit(cpu, 1, z80_read8(cpu, (uint16_t)addr)); break;
+
+    // BIT TEST - Bit 2
+    case XY_CB_BIT_2_B: 
+    case XY_CB_BIT_2_C: 
+    case XY_CB_BIT_2_D: 
+    case XY_CB_BIT_2_E: 
+    case XY_CB_BIT_2_H: 
+    case XY_CB_BIT_2_L: 
+    case XY_CB_BIT_2_HL: 
+    case XY_CB_BIT_2_A: z80_op_bit(cpu, 2, z80_read8(cpu, (uint16_t)addr)); break;
+
+    // BIT TEST - Bit 3
+    case XY_CB_BIT_3_B: 
+    case XY_CB_BIT_3_C: 
+    case XY_CB_BIT_3_D: 
+    case XY_CB_BIT_3_E: 
+    case XY_CB_BIT_3_H: 
+    case XY_CB_BIT_3_L: 
+    case XY_CB_BIT_3_HL:
+    case XY_CB_BIT_3_A: z80_op_bit(cpu, 3, z80_read8(cpu, (uint16_t)addr)); break;
+
+    // BIT TEST - Bit 4
+    case XY_CB_BIT_4_B: 
+    case XY_CB_BIT_4_C: 
+    case XY_CB_BIT_4_D: 
+    case XY_CB_BIT_4_E: 
+    case XY_CB_BIT_4_H: 
+    case XY_CB_BIT_4_L: 
+    case XY_CB_BIT_4_HL: 
+    case XY_CB_BIT_4_A: z80_op_bit(cpu, 4, z80_read8(cpu, (uint16_t)addr)); break;
+
+    // BIT TEST - Bit 5
+    case XY_CB_BIT_5_B: 
+    case XY_CB_BIT_5_C: 
+    case XY_CB_BIT_5_D: 
+    case XY_CB_BIT_5_E: 
+    case XY_CB_BIT_5_H: 
+    case XY_CB_BIT_5_L: 
+    case XY_CB_BIT_5_HL: 
+    case XY_CB_BIT_5_A: z80_op_bit(cpu, 5, z80_read8(cpu, (uint16_t)addr)); break;
+
+    // BIT TEST - Bit 6
+    case XY_CB_BIT_6_B: 
+    case XY_CB_BIT_6_C: 
+    case XY_CB_BIT_6_D: 
+    case XY_CB_BIT_6_E: 
+    case XY_CB_BIT_6_H: 
+    case XY_CB_BIT_6_L: 
+    case XY_CB_BIT_6_HL: 
+    case XY_CB_BIT_6_A: z80_op_bit(cpu, 6, z80_read8(cpu, (uint16_t)addr)); break;
+
+    // BIT TEST - Bit 7
+    case XY_CB_BIT_7_B: 
+    case XY_CB_BIT_7_C: 
+    case XY_CB_BIT_7_D: 
+    case XY_CB_BIT_7_E: 
+    case XY_CB_BIT_7_H: 
+    case XY_CB_BIT_7_L: 
+    case XY_CB_BIT_7_HL: 
+    case XY_CB_BIT_7_A: z80_op_bit(cpu, 7, z80_read8(cpu, (uint16_t)addr)); break;
+
+    // BIT RESET - Bit 0
+    case XY_CB_RES_0_B: { z80_write8(cpu, addr, cpu->registers.B = z80_op_res(cpu, 0, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_0_C: { z80_write8(cpu, addr, cpu->registers.C = z80_op_res(cpu, 0, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_0_D: { z80_write8(cpu, addr, cpu->registers.D = z80_op_res(cpu, 0, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_0_E: { z80_write8(cpu, addr, cpu->registers.E = z80_op_res(cpu, 0, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_0_H: { z80_write8(cpu, addr, cpu->registers.H = z80_op_res(cpu, 0, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_0_L: { z80_write8(cpu, addr, cpu->registers.L = z80_op_res(cpu, 0, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_0_HL: { z80_write8(cpu, addr, z80_op_res(cpu, 0, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_0_A: { z80_write8(cpu, addr, cpu->registers.A = z80_op_res(cpu, 0, z80_read8(cpu, addr)));} break;
+
+    // BIT RESET - Bit 1
+    case XY_CB_RES_1_B: { z80_write8(cpu, addr, cpu->registers.B = z80_op_res(cpu, 1, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_1_C: { z80_write8(cpu, addr, cpu->registers.C = z80_op_res(cpu, 1, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_1_D: { z80_write8(cpu, addr, cpu->registers.D = z80_op_res(cpu, 1, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_1_E: { z80_write8(cpu, addr, cpu->registers.E = z80_op_res(cpu, 1, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_1_H: { z80_write8(cpu, addr, cpu->registers.H = z80_op_res(cpu, 1, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_1_L: { z80_write8(cpu, addr, cpu->registers.L = z80_op_res(cpu, 1, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_1_HL: { z80_write8(cpu, addr, z80_op_res(cpu, 1, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_1_A: { z80_write8(cpu, addr, cpu->registers.A = z80_op_res(cpu, 1, z80_read8(cpu, addr)));} break;
+
+    // BIT RESET - Bit 2
+    case XY_CB_RES_2_B: { z80_write8(cpu, addr, cpu->registers.B = z80_op_res(cpu, 2, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_2_C: { z80_write8(cpu, addr, cpu->registers.C = z80_op_res(cpu, 2, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_2_D: { z80_write8(cpu, addr, cpu->registers.D = z80_op_res(cpu, 2, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_2_E: { z80_write8(cpu, addr, cpu->registers.E = z80_op_res(cpu, 2, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_2_H: { z80_write8(cpu, addr, cpu->registers.H = z80_op_res(cpu, 2, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_2_L: { z80_write8(cpu, addr, cpu->registers.L = z80_op_res(cpu, 2, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_2_HL: { z80_write8(cpu, addr, z80_op_res(cpu, 2, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_2_A: { z80_write8(cpu, addr, cpu->registers.A = z80_op_res(cpu, 2, z80_read8(cpu, addr)));} break;
+
+    // BIT RESET - Bit 3
+    case XY_CB_RES_3_B: { z80_write8(cpu, addr, cpu->registers.B = z80_op_res(cpu, 3, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_3_C: { z80_write8(cpu, addr, cpu->registers.C = z80_op_res(cpu, 3, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_3_D: { z80_write8(cpu, addr, cpu->registers.D = z80_op_res(cpu, 3, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_3_E: { z80_write8(cpu, addr, cpu->registers.E = z80_op_res(cpu, 3, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_3_H: { z80_write8(cpu, addr, cpu->registers.H = z80_op_res(cpu, 3, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_3_L: { z80_write8(cpu, addr, cpu->registers.L = z80_op_res(cpu, 3, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_3_HL: { z80_write8(cpu, addr, z80_op_res(cpu, 3, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_3_A: { z80_write8(cpu, addr, cpu->registers.A = z80_op_res(cpu, 3, z80_read8(cpu, addr)));} break;
+
+    // BIT RESET - Bit 4
+    case XY_CB_RES_4_B: { z80_write8(cpu, addr, cpu->registers.B = z80_op_res(cpu, 4, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_4_C: { z80_write8(cpu, addr, cpu->registers.C = z80_op_res(cpu, 4, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_4_D: { z80_write8(cpu, addr, cpu->registers.D = z80_op_res(cpu, 4, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_4_E: { z80_write8(cpu, addr, cpu->registers.E = z80_op_res(cpu, 4, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_4_H: { z80_write8(cpu, addr, cpu->registers.H = z80_op_res(cpu, 4, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_4_L: { z80_write8(cpu, addr, cpu->registers.L = z80_op_res(cpu, 4, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_4_HL: { z80_write8(cpu, addr, z80_op_res(cpu, 4, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_4_A: { z80_write8(cpu, addr, cpu->registers.A = z80_op_res(cpu, 4, z80_read8(cpu, addr)));} break;
+
+    // BIT RESET - Bit 5
+    case XY_CB_RES_5_B: { z80_write8(cpu, addr, cpu->registers.B = z80_op_res(cpu, 5, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_5_C: { z80_write8(cpu, addr, cpu->registers.C = z80_op_res(cpu, 5, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_5_D: { z80_write8(cpu, addr, cpu->registers.D = z80_op_res(cpu, 5, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_5_E: { z80_write8(cpu, addr, cpu->registers.E = z80_op_res(cpu, 5, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_5_H: { z80_write8(cpu, addr, cpu->registers.H = z80_op_res(cpu, 5, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_5_L: { z80_write8(cpu, addr, cpu->registers.L = z80_op_res(cpu, 5, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_5_HL: { z80_write8(cpu, addr, z80_op_res(cpu, 5, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_5_A: { z80_write8(cpu, addr, cpu->registers.A = z80_op_res(cpu, 5, z80_read8(cpu, addr)));} break;
+
+    // BIT RESET - Bit 6
+    case XY_CB_RES_6_B: { z80_write8(cpu, addr, cpu->registers.B = z80_op_res(cpu, 6, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_6_C: { z80_write8(cpu, addr, cpu->registers.C = z80_op_res(cpu, 6, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_6_D: { z80_write8(cpu, addr, cpu->registers.D = z80_op_res(cpu, 6, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_6_E: { z80_write8(cpu, addr, cpu->registers.E = z80_op_res(cpu, 6, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_6_H: { z80_write8(cpu, addr, cpu->registers.H = z80_op_res(cpu, 6, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_6_L: { z80_write8(cpu, addr, cpu->registers.L = z80_op_res(cpu, 6, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_6_HL: { z80_write8(cpu, addr, z80_op_res(cpu, 6, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_6_A: { z80_write8(cpu, addr, cpu->registers.A = z80_op_res(cpu, 6, z80_read8(cpu, addr)));} break;
+
+    // BIT RESET - Bit 7
+    case XY_CB_RES_7_B: { z80_write8(cpu, addr, cpu->registers.B = z80_op_res(cpu, 7, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_7_C: { z80_write8(cpu, addr, cpu->registers.C = z80_op_res(cpu, 7, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_7_D: { z80_write8(cpu, addr, cpu->registers.D = z80_op_res(cpu, 7, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_7_E: { z80_write8(cpu, addr, cpu->registers.E = z80_op_res(cpu, 7, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_7_H: { z80_write8(cpu, addr, cpu->registers.H = z80_op_res(cpu, 7, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_7_L: { z80_write8(cpu, addr, cpu->registers.L = z80_op_res(cpu, 7, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_7_HL: { z80_write8(cpu, addr, z80_op_res(cpu, 7, z80_read8(cpu, addr)));} break;
+    case XY_CB_RES_7_A: { z80_write8(cpu, addr, cpu->registers.A = z80_op_res(cpu, 7, z80_read8(cpu, addr)));} break;
+
+    // BIT SET - Bit 0
+    case XY_CB_SET_0_B: { z80_write8(cpu, addr, cpu->registers.B = z80_op_set(cpu, 0, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_0_C: { z80_write8(cpu, addr, cpu->registers.C = z80_op_set(cpu, 0, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_0_D: { z80_write8(cpu, addr, cpu->registers.D = z80_op_set(cpu, 0, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_0_E: { z80_write8(cpu, addr, cpu->registers.E = z80_op_set(cpu, 0, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_0_H: { z80_write8(cpu, addr, cpu->registers.H = z80_op_set(cpu, 0, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_0_L: { z80_write8(cpu, addr, cpu->registers.L = z80_op_set(cpu, 0, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_0_HL: { z80_write8(cpu, addr, z80_op_set(cpu, 0, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_0_A: { z80_write8(cpu, addr, cpu->registers.A = z80_op_set(cpu, 0, z80_read8(cpu, addr)));} break;
+
+    // BIT SET - Bit 1
+    case XY_CB_SET_1_B: { z80_write8(cpu, addr, cpu->registers.B = z80_op_set(cpu, 1, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_1_C: { z80_write8(cpu, addr, cpu->registers.C = z80_op_set(cpu, 1, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_1_D: { z80_write8(cpu, addr, cpu->registers.D = z80_op_set(cpu, 1, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_1_E: { z80_write8(cpu, addr, cpu->registers.E = z80_op_set(cpu, 1, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_1_H: { z80_write8(cpu, addr, cpu->registers.H = z80_op_set(cpu, 1, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_1_L: { z80_write8(cpu, addr, cpu->registers.L = z80_op_set(cpu, 1, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_1_HL: { z80_write8(cpu, addr, z80_op_set(cpu, 1, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_1_A: { z80_write8(cpu, addr, cpu->registers.A = z80_op_set(cpu, 1, z80_read8(cpu, addr)));} break;
+
+    // BIT SET - Bit 2
+    case XY_CB_SET_2_B: { z80_write8(cpu, addr, cpu->registers.B = z80_op_set(cpu, 2, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_2_C: { z80_write8(cpu, addr, cpu->registers.C = z80_op_set(cpu, 2, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_2_D: { z80_write8(cpu, addr, cpu->registers.D = z80_op_set(cpu, 2, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_2_E: { z80_write8(cpu, addr, cpu->registers.E = z80_op_set(cpu, 2, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_2_H: { z80_write8(cpu, addr, cpu->registers.H = z80_op_set(cpu, 2, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_2_L: { z80_write8(cpu, addr, cpu->registers.L = z80_op_set(cpu, 2, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_2_HL: { z80_write8(cpu, addr, z80_op_set(cpu, 2, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_2_A: { z80_write8(cpu, addr, cpu->registers.A = z80_op_set(cpu, 2, z80_read8(cpu, addr)));} break;
+
+    // BIT SET - Bit 3
+    case XY_CB_SET_3_B: { z80_write8(cpu, addr, cpu->registers.B = z80_op_set(cpu, 3, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_3_C: { z80_write8(cpu, addr, cpu->registers.C = z80_op_set(cpu, 3, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_3_D: { z80_write8(cpu, addr, cpu->registers.D = z80_op_set(cpu, 3, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_3_E: { z80_write8(cpu, addr, cpu->registers.E = z80_op_set(cpu, 3, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_3_H: { z80_write8(cpu, addr, cpu->registers.H = z80_op_set(cpu, 3, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_3_L: { z80_write8(cpu, addr, cpu->registers.L = z80_op_set(cpu, 3, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_3_HL: { z80_write8(cpu, addr, z80_op_set(cpu, 3, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_3_A: { z80_write8(cpu, addr, cpu->registers.A = z80_op_set(cpu, 3, z80_read8(cpu, addr)));} break;
+
+    // BIT SET - Bit 4
+    case XY_CB_SET_4_B: { z80_write8(cpu, addr, cpu->registers.B = z80_op_set(cpu, 4, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_4_C: { z80_write8(cpu, addr, cpu->registers.C = z80_op_set(cpu, 4, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_4_D: { z80_write8(cpu, addr, cpu->registers.D = z80_op_set(cpu, 4, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_4_E: { z80_write8(cpu, addr, cpu->registers.E = z80_op_set(cpu, 4, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_4_H: { z80_write8(cpu, addr, cpu->registers.H = z80_op_set(cpu, 4, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_4_L: { z80_write8(cpu, addr, cpu->registers.L = z80_op_set(cpu, 4, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_4_HL: { z80_write8(cpu, addr, z80_op_set(cpu, 4, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_4_A: { z80_write8(cpu, addr, cpu->registers.A = z80_op_set(cpu, 4, z80_read8(cpu, addr)));} break;
+
+    // BIT SET - Bit 5
+    case XY_CB_SET_5_B: { z80_write8(cpu, addr, cpu->registers.B = z80_op_set(cpu, 5, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_5_C: { z80_write8(cpu, addr, cpu->registers.C = z80_op_set(cpu, 5, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_5_D: { z80_write8(cpu, addr, cpu->registers.D = z80_op_set(cpu, 5, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_5_E: { z80_write8(cpu, addr, cpu->registers.E = z80_op_set(cpu, 5, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_5_H: { z80_write8(cpu, addr, cpu->registers.H = z80_op_set(cpu, 5, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_5_L: { z80_write8(cpu, addr, cpu->registers.L = z80_op_set(cpu, 5, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_5_HL: { z80_write8(cpu, addr, z80_op_set(cpu, 5, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_5_A: { z80_write8(cpu, addr, cpu->registers.A = z80_op_set(cpu, 5, z80_read8(cpu, addr)));} break;
+
+    // BIT SET - Bit 6
+    case XY_CB_SET_6_B: { z80_write8(cpu, addr, cpu->registers.B = z80_op_set(cpu, 6, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_6_C: { z80_write8(cpu, addr, cpu->registers.C = z80_op_set(cpu, 6, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_6_D: { z80_write8(cpu, addr, cpu->registers.D = z80_op_set(cpu, 6, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_6_E: { z80_write8(cpu, addr, cpu->registers.E = z80_op_set(cpu, 6, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_6_H: { z80_write8(cpu, addr, cpu->registers.H = z80_op_set(cpu, 6, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_6_L: { z80_write8(cpu, addr, cpu->registers.L = z80_op_set(cpu, 6, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_6_HL: { z80_write8(cpu, addr, z80_op_set(cpu, 6, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_6_A: { z80_write8(cpu, addr, cpu->registers.A = z80_op_set(cpu, 6, z80_read8(cpu, addr)));} break;
+
+    // BIT SET - Bit 7
+    case XY_CB_SET_7_B: { z80_write8(cpu, addr, cpu->registers.B = z80_op_set(cpu, 7, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_7_C: { z80_write8(cpu, addr, cpu->registers.C = z80_op_set(cpu, 7, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_7_D: { z80_write8(cpu, addr, cpu->registers.D = z80_op_set(cpu, 7, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_7_E: { z80_write8(cpu, addr, cpu->registers.E = z80_op_set(cpu, 7, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_7_H: { z80_write8(cpu, addr, cpu->registers.H = z80_op_set(cpu, 7, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_7_L: { z80_write8(cpu, addr, cpu->registers.L = z80_op_set(cpu, 7, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_7_HL: { z80_write8(cpu, addr, z80_op_set(cpu, 7, z80_read8(cpu, addr)));} break;
+    case XY_CB_SET_7_A: { z80_write8(cpu, addr, cpu->registers.A = z80_op_set(cpu, 7, z80_read8(cpu, addr)));} break;
+
+    default:
+        printf("Unimplemented CB Instruction: 0x%02X\n", cb_opcode);
+        cpu->running = false;
+        cpu->halted = true;
+        break;
+    }
+}
+
+#define XY        IX
+#define XYH       IXH
+#define XYL       IXL
+#define XY_PREFIX 0xDD
+#define XY_STATS_PAGE    Z80_STATS_DD
+#define XY_CB_STATS_PAGE Z80_STATS_DDCB
+#define XY_EXECUTE z80_execute_dd_instruction
+#include "z80_index_op_template.h"
+
+#define XY        IY
+#define XYH       IYH
+#define XYL       IYL
+#define XY_PREFIX 0xFD
+#define XY_STATS_PAGE    Z80_STATS_FD
+#define XY_CB_STATS_PAGE Z80_STATS_FDCB
+#define XY_EXECUTE z80_execute_fd_instruction
+#include "z80_index_op_template.h"
@@ -0,0 +1,157 @@
+// Executor for one index register, included by z80_index_op_execute.c with
+// XY/XYH/XYL naming the register and its halves, XY_PREFIX the prefix byte,
+// XY_STATS_PAGE/XY_CB_STATS_PAGE its histogram pages and XY_EXECUTE the
+// function to define. No include guard on purpose.
+
+void XY_EXECUTE(struct z80_t *cpu, uint8_t opcode)
+{
+    cpu->cycle_count += z80_timing_xy[opcode];
+    z80_stats_count(cpu, XY_STATS_PAGE, opcode);
+    switch (opcode)
+    {
+    case XY_ADD_XY_BC: cpu->registers.XY = z80_op_add16(cpu, cpu->registers.XY, cpu->registers.BC); break;
+    case XY_ADD_XY_DE: cpu->registers.XY = z80_op_add16(cpu, cpu->registers.XY, cpu->registers.DE); break;
+    case XY_ADD_XY_XY: cpu->registers.XY = z80_op_add16(cpu, cpu->registers.XY, cpu->registers.XY); break;
+    case XY_ADD_XY_SP: cpu->registers.XY = z80_op_add16(cpu, cpu->registers.XY, cpu->registers.SP); break;
+    case XY_LD_XY_NN:  cpu->registers.XY = z80_fetch16(cpu); break;
+    case XY_INC_XY: cpu->registers.XY++; break;
+    case XY_DEC_XY: cpu->registers.XY--; break;
+    case XY_DEC_XYH: cpu->registers.XYH = z80_op_dec8(cpu, cpu->registers.XYH); break;
+    case XY_DEC_XYL: cpu->registers.XYL = z80_op_dec8(cpu, cpu->registers.XYL); break;
+    case XY_INC_XYH: cpu->registers.XYH = z80_op_inc8(cpu, cpu->registers.XYH); break;
+    case XY_INC_XYL: cpu->registers.XYL = z80_op_inc8(cpu, cpu->registers.XYL); break;
+    case XY_INC_XY_D:
+    {
+        int8_t offset = (int8_t)z80_fetch8(cpu);
+        uint16_t address = cpu->registers.XY + offset;
+        uint8_t original = z80_read8(cpu, address);
+        uint8_t result = z80_op_inc8(cpu, original);
+        z80_write8(cpu, address, result);
+        break;
+    }
+    case XY_DEC_XY_D:
+    {
+        int8_t offset = (int8_t)z80_fetch8(cpu);
+        uint16_t address = cpu->registers.XY + offset;
+        uint8_t original = z80_read8(cpu, address);
+        uint8_t result = z80_op_dec8(cpu, original);
+        z80_write8(cpu, address, result);
+        break;
+    }
+    case XY_LD_XY_D_N:
+    {
+        int8_t d = (int8_t)z80_fetch8(cpu); // displacement
+        uint8_t n = z80_fetch8(cpu);        // immediate value
+        z80_write8(cpu, cpu->registers.XY + d, n);
+        break;
+    }
+    case XY_LD_B_B:    cpu->registers.B = cpu->registers.B; break;
+    case XY_LD_B_C:    cpu->registers.B = cpu->registers.C; break;
+    case XY_LD_B_D:    cpu->registers.B = cpu->registers.D; break;
+    case XY_LD_B_E:    cpu->registers.B = cpu->registers.E; break;
+    case XY_LD_B_XYH:  cpu->registers.B = cpu->registers.XYH; break;
+    case XY_LD_B_XYL:  cpu->registers.B = cpu->registers.XYL; break;
+    case XY_LD_B_A:    cpu->registers.B = cpu->registers.A; break;
+    case XY_LD_C_B:    cpu->registers.C = cpu->registers.B; break;
+    case XY_LD_C_C:    cpu->registers.C = cpu->registers.C; break;
+    case XY_LD_C_D:    cpu->registers.C = cpu->registers.D; break;
+    case XY_LD_C_E:    cpu->registers.C = cpu->registers.E; break;
+    case XY_LD_C_XYH:  cpu->registers.C = cpu->registers.XYH; break;
+    case XY_LD_C_XYL:  cpu->registers.C = cpu->registers.XYL; break;
+    case XY_LD_C_A:    cpu->registers.C = cpu->registers.A; break;
+    case XY_LD_D_B:    cpu->registers.D = cpu->registers.B; break;
+    case XY_LD_D_C:    cpu->registers.D = cpu->registers.C; break;
+    case XY_LD_D_D:    cpu->registers.D = cpu->registers.D; break;
+    case XY_LD_D_E:    cpu->registers.D = cpu->registers.E; break;
+    case XY_LD_D_XYH:  cpu->registers.D = cpu->registers.XYH; break;
+    case XY_LD_D_XYL:  cpu->registers.D = cpu->registers.XYL; break;
+    case XY_LD_D_A:    cpu->registers.D = cpu->registers.A; break;
+    case XY_LD_E_B:    cpu->registers.E = cpu->registers.B; break;
+    case XY_LD_E_C:    cpu->registers.E = cpu->registers.C; break;
+    case XY_LD_E_D:    cpu->registers.E = cpu->registers.D; break;
+    case XY_LD_E_E:    cpu->registers.E = cpu->registers.E; break;
+    case XY_LD_E_XYH:  cpu->registers.E = cpu->registers.XYH; break;
+    case XY_LD_E_XYL:  cpu->registers.E = cpu->registers.XYL; break;
+    case XY_LD_E_A:    cpu->registers.E = cpu->registers.A; break;
+    case XY_LD_XYH_B:  cpu->registers.XYH = cpu->registers.B; break;
+    case XY_LD_XYH_C:  cpu->registers.XYH = cpu->registers.C; break;
+    case XY_LD_XYH_D:  cpu->registers.XYH = cpu->registers.D; break;
+    case XY_LD_XYH_E:  cpu->registers.XYH = cpu->registers.E; break;
+    case XY_LD_XYH_XYH: cpu->registers.XYH = cpu->registers.XYH; break;
+    case XY_LD_XYH_XYL: cpu->registers.XYH = cpu->registers.XYL; break;
+    case XY_LD_XYH_A:  cpu->registers.XYH = cpu->registers.A; break;
+    case XY_LD_XYL_B:  cpu->registers.XYL = cpu->registers.B; break;
+    case XY_LD_XYL_C:  cpu->registers.XYL = cpu->registers.C; break;
+    case XY_LD_XYL_D:  cpu->registers.XYL = cpu->registers.D; break;
+    case XY_LD_XYL_E:  cpu->registers.XYL = cpu->registers.E; break;
+    case XY_LD_XYL_XYH: cpu->registers.XYL = cpu->registers.XYH; break;
+    case XY_LD_XYL_XYL: cpu->registers.XYL = cpu->registers.XYL; break;
+    case XY_LD_XYL_A:  cpu->registers.XYL = cpu->registers.A; break;
+    case XY_LD_XY_D_B: z80_write8(cpu, cpu->registers.XY + (int8_t)z80_fetch8(cpu), cpu->registers.B); break;
+    case XY_LD_XY_D_C: z80_write8(cpu, cpu->registers.XY + (int8_t)z80_fetch8(cpu), cpu->registers.C); break;
+    case XY_LD_XY_D_D: z80_write8(cpu, cpu->registers.XY + (int8_t)z80_fetch8(cpu), cpu->registers.D); break;
+    case XY_LD_XY_D_E: z80_write8(cpu, cpu->registers.XY + (int8_t)z80_fetch8(cpu), cpu->registers.E); break;
+    case XY_LD_XY_D_H: z80_write8(cpu, cpu->registers.XY + (int8_t)z80_fetch8(cpu), cpu->registers.H); break;
+    case XY_LD_XY_D_L: z80_write8(cpu, cpu->registers.XY + (int8_t)z80_fetch8(cpu), cpu->registers.L); break;
+    case XY_LD_XY_D_A: z80_write8(cpu, cpu->registers.XY + (int8_t)z80_fetch8(cpu), cpu->registers.A); break;
+    case XY_LD_A_B:    cpu->registers.A = cpu->registers.B; break;
+    case XY_LD_A_C:    cpu->registers.A = cpu->registers.C; break;
+    case XY_LD_A_D:    cpu->registers.A = cpu->registers.D; break;
+    case XY_LD_A_E:    cpu->registers.A = cpu->registers.E; break;
+    case XY_LD_A_XYH:  cpu->registers.A = cpu->registers.XYH; break;
+    case XY_LD_A_XYL:  cpu->registers.A = cpu->registers.XYL; break;
+    case XY_LD_A_A:    cpu->registers.A = cpu->registers.A; break;
+    case XY_LD_XYH_N:  cpu->registers.XYH  = z80_fetch8(cpu); break;
+    case XY_LD_XYL_N:  cpu->registers.XYL = z80_fetch8(cpu); break;
+    case XY_LD_B_XY_D: cpu->registers.B = z80_read8(cpu, (cpu->registers.XY + (int8_t)z80_fetch8(cpu))); break;
+    case XY_LD_C_XY_D: cpu->registers.C = z80_read8(cpu, (cpu->registers.XY + (int8_t)z80_fetch8(cpu))); break;
+    case XY_LD_D_XY_D: cpu->registers.D = z80_read8(cpu, (cpu->registers.XY + (int8_t)z80_fetch8(cpu))); break;
+    case XY_LD_E_XY_D: cpu->registers.E = z80_read8(cpu, (cpu->registers.XY + (int8_t)z80_fetch8(cpu))); break;
+    case XY_LD_H_XY_D: cpu->registers.H = z80_read8(cpu, (cpu->registers.XY + (int8_t)z80_fetch8(cpu))); break;
+    case XY_LD_L_XY_D: cpu->registers.L = z80_read8(cpu, (cpu->registers.XY + (int8_t)z80_fetch8(cpu))); break;
+    case XY_LD_NN_XY: z80_write16(cpu, z80_fetch16(cpu), cpu->registers.XY); break;
+    case XY_LD_XY_NN_ind: cpu->registers.XY = z80_read16(cpu, z80_fetch16(cpu)); break;
+    case XY_LD_A_XY_D: cpu->registers.A = z80_read8(cpu, (cpu->registers.XY + (int8_t)z80_fetch8(cpu))); break;
+    case XY_POP_XY: cpu->registers.XY = z80_stack_pop16(cpu); break;
+    case XY_PUSH_XY: z80_stack_push16(cpu, cpu->registers.XY); break;
+    case XY_JP_XY: cpu->registers.PC = cpu->registers.XY; break;
+    case XY_ADD_A_XYH:     z80_op_add8(cpu, cpu->registers.XYH); break;
+    case XY_ADD_A_XYL:     z80_op_add8(cpu, cpu->registers.XYL); break;
+    case XY_ADD_A_XY_D:    z80_op_add8(cpu, z80_read8(cpu, cpu->registers.XY + (int8_t)z80_fetch8(cpu))); break;
+    case XY_ADC_A_XYH:     z80_op_adc8(cpu, cpu->registers.XYH); break;
+    case XY_ADC_A_XYL:     z80_op_adc8(cpu, cpu->registers.XYL); break;
+    case XY_ADC_A_XY_D:    z80_op_adc8(cpu, z80_read8(cpu, cpu->registers.XY + (int8_t)z80_fetch8(cpu))); break;
+    case XY_SUB_A_XYH:     z80_op_sub8(cpu, cpu->registers.XYH); break;
+    case XY_SUB_A_XYL:     z80_op_sub8(cpu, cpu->registers.XYL); break;
+    case XY_SUB_A_XY_D:    z80_op_sub8(cpu, z80_read8(cpu, cpu->registers.XY + (int8_t)z80_fetch8(cpu))); break;
+    case XY_SBC_A_XYH:     z80_op_sbc8(cpu, cpu->registers.XYH); break;
+    case XY_SBC_A_XYL:     z80_op_sbc8(cpu, cpu->registers.XYL); break;
+    case XY_SBC_A_XY_D:    z80_op_sbc8(cpu, z80_read8(cpu, cpu->registers.XY + (int8_t)z80_fetch8(cpu))); break;
+    case XY_AND_A_XYH:     z80_op_and(cpu, cpu->registers.XYH); break;
+    case XY_AND_A_XYL:     z80_op_and(cpu, cpu->registers.XYL); break;
+    case XY_AND_A_XY_D:    z80_op_and(cpu, z80_read8(cpu, cpu->registers.XY + (int8_t)z80_fetch8(cpu))); break;
+    case XY_XOR_A_XYH:     z80_op_xor(cpu, cpu->registers.XYH); break;
+    case XY_XOR_A_XYL:     z80_op_xor(cpu, cpu->registers.XYL); break;
+    case XY_XOR_A_XY_D:    z80_op_xor(cpu, z80_read8(cpu, cpu->registers.XY + (int8_t)z80_fetch8(cpu))); break;
+    case XY_OR_A_XYH:      z80_op_or(cpu, cpu->registers.XYH); break;
+    case XY_OR_A_XYL:      z80_op_or(cpu, cpu->registers.XYL); break;
+    case XY_OR_A_XY_D:     z80_op_or(cpu, z80_read8(cpu, cpu->registers.XY + (int8_t)z80_fetch8(cpu))); break;
+    case XY_CP_A_XYH:      z80_op_cp(cpu, cpu->registers.A, cpu->registers.XYH); break;
+    case XY_CP_A_XYL:      z80_op_cp(cpu, cpu->registers.A, cpu->registers.XYL); break;
+    case XY_CP_A_XY_D:     z80_op_cp(cpu, cpu->registers.A, z80_read8(cpu, cpu->registers.XY + (int8_t)z80_fetch8(cpu))); break;
+    case XY_PREFIX_CB:     execute_index_cb(cpu, XY_CB_STATS_PAGE, cpu->registers.XY + (int8_t)z80_fetch8(cpu)); break;
+    default:
+        printf("Unimplemented 0x%02X Instruction: 0x%02X\n", XY_PREFIX, opcode);
+        cpu->running = false;
+        cpu->halted = true;
+        break;
+    }
+}
+
+#undef XY
+#undef XYH
+#undef XYL
+#undef XY_PREFIX
+#undef XY_EXECUTE
+#undef XY_STATS_PAGE
+#undef XY_CB_STATS_PAGE
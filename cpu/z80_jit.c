@@ -0,0 +1,630 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "z80_jit.h"
+#include "z80_flags.h"
+
+#if Z80_JIT_SUPPORTED
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+#endif
+
+// Translates decoded blocks (z80_block.h) into x86-64 code. Register moves,
+// 16-bit INC/DEC and the register/immediate ALU ops are emitted inline with
+// the generated flag tables; everything else becomes a call into the same
+// handler the interpreter would dispatch to. T-states are added per
+// instruction and the deadline is checked after each one (superinstruction
+// handlers check it between their ops), so a slice ends on exactly the
+// instruction the interpreter would stop at.
+
+#define JIT_BLOCK_MAX_CODE  4096   // worst case for Z80_BLOCK_MAX_OPS ops
+#define JIT_MAX_EXITS       (Z80_BLOCK_MAX_OPS * 5)
+#define JIT_MAX_REPORTS     16
+
+typedef void (*jit_block_fn)(struct z80_t *cpu, uint64_t deadline);
+
+// Host calling convention: cpu arrives in the first argument register and is
+// kept in rbx, the deadline in the second and is kept in r12
+#ifdef _WIN32
+#define MODRM_RBX_ARG0  0xCB    // mov rbx, rcx
+#define MODRM_R12_ARG1  0xD4    // mov r12, rdx
+#define MODRM_ARG0_RBX  0xD9    // mov rcx, rbx
+#define OP_ARG1_IMM32   0xBA    // mov edx, imm32
+#define FRAME_SIZE      40      // shadow space, keeps rsp 16-byte aligned
+#else
+#define MODRM_RBX_ARG0  0xFB    // mov rbx, rdi
+#define MODRM_R12_ARG1  0xF4    // mov r12, rsi
+#define MODRM_ARG0_RBX  0xDF    // mov rdi, rbx
+#define OP_ARG1_IMM32   0xBE    // mov esi, imm32
+#define FRAME_SIZE      8
+#endif
+
+// x86 register numbers used in ModRM fields
+enum { RAX, RCX, RDX };
+
+// Condition codes for the long Jcc form (0F 8x)
+enum { JCC_E = 0x84, JCC_NE = 0x85, JCC_AE = 0x83 };
+
+#define CPU_FIELD(field)  offsetof(struct z80_t, field)
+#define CPU_REG(reg)      (offsetof(struct z80_t, registers) + offsetof(struct registers, reg))
+
+// Operand order of the r field in the opcode (6 is (HL), never emitted inline)
+static const size_t reg8_offset[8] =
+{
+    CPU_REG(B), CPU_REG(C), CPU_REG(D), CPU_REG(E), CPU_REG(H), CPU_REG(L), 0, CPU_REG(A),
+};
+
+static const size_t reg16_offset[4] =
+{
+    CPU_REG(BC), CPU_REG(DE), CPU_REG(HL), CPU_REG(SP),
+};
+
+struct jit_emitter
+{
+    uint8_t *p;
+    uint8_t *exits[JIT_MAX_EXITS];   // rel32 fields to patch to the epilogue
+    int exit_count;
+};
+
+static uint8_t *const jit_unmapped_pages[Z80_PAGE_COUNT];
+
+static void emit8(struct jit_emitter *e, uint8_t value)
+{
+    *e->p++ = value;
+}
+
+static void emit16(struct jit_emitter *e, uint16_t value)
+{
+    memcpy(e->p, &value, sizeof(value));
+    e->p += sizeof(value);
+}
+
+static void emit32(struct jit_emitter *e, uint32_t value)
+{
+    memcpy(e->p, &value, sizeof(value));
+    e->p += sizeof(value);
+}
+
+static void emit64(struct jit_emitter *e, uint64_t value)
+{
+    memcpy(e->p, &value, sizeof(value));
+    e->p += sizeof(value);
+}
+
+// ModRM + disp32 for [rbx + offset]
+static void emit_cpu_operand(struct jit_emitter *e, uint8_t reg, size_t offset)
+{
+    emit8(e, 0x83 | (reg << 3));
+    emit32(e, (uint32_t)offset);
+}
+
+static void emit_exit_if(struct jit_emitter *e, uint8_t condition)
+{
+    emit8(e, 0x0F);
+    emit8(e, condition);
+    e->exits[e->exit_count++] = e->p;
+    emit32(e, 0);
+}
+
+static void emit_prologue(struct jit_emitter *e)
+{
+    emit8(e, 0x53);                                 // push rbx
+    emit8(e, 0x41); emit8(e, 0x54);                 // push r12
+    emit8(e, 0x48); emit8(e, 0x83); emit8(e, 0xEC); emit8(e, FRAME_SIZE);
+    emit8(e, 0x48); emit8(e, 0x89); emit8(e, MODRM_RBX_ARG0);
+    emit8(e, 0x49); emit8(e, 0x89); emit8(e, MODRM_R12_ARG1);
+}
+
+static void emit_epilogue(struct jit_emitter *e)
+{
+    for (int i = 0; i < e->exit_count; i++)
+    {
+        uint32_t rel = (uint32_t)(e->p - (e->exits[i] + 4));
+        memcpy(e->exits[i], &rel, sizeof(rel));
+    }
+    emit8(e, 0x48); emit8(e, 0x83); emit8(e, 0xC4); emit8(e, FRAME_SIZE);
+    emit8(e, 0x41); emit8(e, 0x5C);                 // pop r12
+    emit8(e, 0x5B);                                 // pop rbx
+    emit8(e, 0xC3);                                 // ret
+}
+
+// PC += length; cycles += the opcode's T-states
+static void emit_retire(struct jit_emitter *e, const struct z80_block_op *op)
+{
+    emit8(e, 0x66); emit8(e, 0x83); emit_cpu_operand(e, 0, CPU_REG(PC)); emit8(e, op->length);
+    emit8(e, 0x48); emit8(e, 0x83); emit_cpu_operand(e, 0, CPU_FIELD(cycles)); emit8(e, z80_timing_base[op->opcode]);
+}
+
+static void emit_deadline_check(struct jit_emitter *e)
+{
+    // cmp [rbx + cycles], r12; jae exit
+    emit8(e, 0x4C); emit8(e, 0x39); emit_cpu_operand(e, 4, CPU_FIELD(cycles));
+    emit_exit_if(e, JCC_AE);
+}
+
+#if !Z80_LAZY_FLAGS
+// edx = table[rax]
+static void emit_table_lookup(struct jit_emitter *e, const uint8_t *table)
+{
+    emit8(e, 0x49); emit8(e, 0xB9); emit64(e, (uint64_t)(uintptr_t)table);     // mov r9, table
+    emit8(e, 0x41); emit8(e, 0x0F); emit8(e, 0xB6); emit8(e, 0x14); emit8(e, 0x01); // movzx edx, byte [r9 + rax]
+}
+
+// INC r / DEC r: F = (F & C) | table[result]
+static void emit_inc_dec8(struct jit_emitter *e, size_t reg, bool dec)
+{
+    emit8(e, 0x0F); emit8(e, 0xB6); emit_cpu_operand(e, RCX, reg);    // movzx ecx, byte [r]
+    emit8(e, 0xFE); emit8(e, dec ? 0xC9 : 0xC1);                      // dec cl / inc cl
+    emit8(e, 0x88); emit_cpu_operand(e, RCX, reg);                    // mov [r], cl
+    emit8(e, 0x0F); emit8(e, 0xB6); emit8(e, 0xC1);                   // movzx eax, cl
+    emit_table_lookup(e, dec ? z80_flag_tables.dec : z80_flag_tables.inc);
+    emit8(e, 0x0F); emit8(e, 0xB6); emit_cpu_operand(e, RAX, CPU_REG(F));
+    emit8(e, 0x83); emit8(e, 0xE0); emit8(e, MASK_C);                 // and eax, MASK_C
+    emit8(e, 0x09); emit8(e, 0xD0);                                   // or eax, edx
+    emit8(e, 0x88); emit_cpu_operand(e, RAX, CPU_REG(F));             // mov [F], al
+}
+
+// ADD/ADC/SUB/SBC/AND/XOR/OR/CP A with the operand already in edx
+static void emit_alu8(struct jit_emitter *e, uint8_t alu)
+{
+    bool logic = alu >= 4 && alu <= 6;
+    bool with_carry = alu == 1 || alu == 3;
+
+    emit8(e, 0x0F); emit8(e, 0xB6); emit_cpu_operand(e, RCX, CPU_REG(A));  // movzx ecx, byte [A]
+    if (!logic)
+    {
+        // Table index: carry << 16 | a << 8 | b
+        emit8(e, 0x89); emit8(e, 0xC8);                               // mov eax, ecx
+        emit8(e, 0xC1); emit8(e, 0xE0); emit8(e, 8);                  // shl eax, 8
+        emit8(e, 0x09); emit8(e, 0xD0);                               // or eax, edx
+        if (with_carry)
+        {
+            emit8(e, 0x44); emit8(e, 0x0F); emit8(e, 0xB6); emit_cpu_operand(e, 0, CPU_REG(F)); // movzx r8d, [F]
+            emit8(e, 0x41); emit8(e, 0x83); emit8(e, 0xE0); emit8(e, MASK_C);  // and r8d, MASK_C
+            emit8(e, 0x45); emit8(e, 0x89); emit8(e, 0xC2);           // mov r10d, r8d
+            emit8(e, 0x41); emit8(e, 0xC1); emit8(e, 0xE2); emit8(e, 16);  // shl r10d, 16
+            emit8(e, 0x44); emit8(e, 0x09); emit8(e, 0xD0);           // or eax, r10d
+        }
+    }
+
+    switch (alu)
+    {
+    case 0: emit8(e, 0x00); emit8(e, 0xD1); break;                    // add cl, dl
+    case 1: emit8(e, 0x00); emit8(e, 0xD1);
+            emit8(e, 0x44); emit8(e, 0x00); emit8(e, 0xC1); break;    // add cl, dl; add cl, r8b
+    case 2: emit8(e, 0x28); emit8(e, 0xD1); break;                    // sub cl, dl
+    case 3: emit8(e, 0x28); emit8(e, 0xD1);
+            emit8(e, 0x44); emit8(e, 0x28); emit8(e, 0xC1); break;    // sub cl, dl; sub cl, r8b
+    case 4: emit8(e, 0x20); emit8(e, 0xD1); break;                    // and cl, dl
+    case 5: emit8(e, 0x30); emit8(e, 0xD1); break;                    // xor cl, dl
+    case 6: emit8(e, 0x08); emit8(e, 0xD1); break;                    // or cl, dl
+    default: break;                                                   // cp: A unchanged
+    }
+
+    if (logic)
+    {
+        emit8(e, 0x0F); emit8(e, 0xB6); emit8(e, 0xC1);               // movzx eax, cl
+        emit_table_lookup(e, z80_flag_tables.szp);
+        if (alu == 4)
+        {
+            emit8(e, 0x83); emit8(e, 0xCA); emit8(e, MASK_H);         // or edx, MASK_H
+        }
+    }
+    else
+    {
+        emit_table_lookup(e, alu <= 1 ? z80_flag_tables.adc : z80_flag_tables.sbc);
+    }
+    emit8(e, 0x88); emit_cpu_operand(e, RDX, CPU_REG(F));             // mov [F], dl
+    if (alu != 7)
+    {
+        emit8(e, 0x88); emit_cpu_operand(e, RCX, CPU_REG(A));         // mov [A], cl
+    }
+}
+#endif
+
+// Emit an unprefixed instruction inline. Returns false for anything left to
+// the interpreter handler.
+static bool emit_inline_op(struct jit_emitter *e, const struct z80_block_op *op)
+{
+    uint8_t opcode = op->opcode;
+    uint8_t dst = (opcode >> 3) & 7;
+    uint8_t src = opcode & 7;
+
+    if (op->execute != z80_execute_instruction)
+        return false;
+
+    if (opcode == 0x00)                                       // NOP
+    {
+        emit_retire(e, op);
+        return true;
+    }
+    if (opcode >= 0x40 && opcode <= 0x7F && dst != 6 && src != 6)  // LD r,r'
+    {
+        emit8(e, 0x0F); emit8(e, 0xB6); emit_cpu_operand(e, RAX, reg8_offset[src]);
+        emit8(e, 0x88); emit_cpu_operand(e, RAX, reg8_offset[dst]);
+        emit_retire(e, op);
+        return true;
+    }
+    if ((opcode & 0xC7) == 0x06 && dst != 6)                  // LD r,n
+    {
+        emit8(e, 0xC6); emit_cpu_operand(e, 0, reg8_offset[dst]); emit8(e, op->bytes[1]);
+        emit_retire(e, op);
+        return true;
+    }
+    if ((opcode & 0xCF) == 0x01)                              // LD rr,nn
+    {
+        emit8(e, 0x66); emit8(e, 0xC7); emit_cpu_operand(e, 0, reg16_offset[opcode >> 4]);
+        emit16(e, op->bytes[1] | (op->bytes[2] << 8));
+        emit_retire(e, op);
+        return true;
+    }
+    if ((opcode & 0xC7) == 0x03)                              // INC rr / DEC rr
+    {
+        emit8(e, 0x66); emit8(e, 0xFF); emit_cpu_operand(e, (opcode & 0x08) ? 1 : 0, reg16_offset[opcode >> 4]);
+        emit_retire(e, op);
+        return true;
+    }
+    if (opcode == 0xEB)                                       // EX DE,HL
+    {
+        emit8(e, 0x0F); emit8(e, 0xB7); emit_cpu_operand(e, RAX, CPU_REG(DE));
+        emit8(e, 0x0F); emit8(e, 0xB7); emit_cpu_operand(e, RCX, CPU_REG(HL));
+        emit8(e, 0x66); emit8(e, 0x89); emit_cpu_operand(e, RCX, CPU_REG(DE));
+        emit8(e, 0x66); emit8(e, 0x89); emit_cpu_operand(e, RAX, CPU_REG(HL));
+        emit_retire(e, op);
+        return true;
+    }
+
+#if !Z80_LAZY_FLAGS
+    // Flag producers write F straight from the tables, which would bypass a
+    // pending lazy op, so they stay with the handlers in that build
+    if ((opcode & 0xC6) == 0x04 && dst != 6)                  // INC r / DEC r
+    {
+        emit_inc_dec8(e, reg8_offset[dst], opcode & 1);
+        emit_retire(e, op);
+        return true;
+    }
+    if (opcode >= 0x80 && opcode <= 0xBF && src != 6)         // ALU A,r
+    {
+        emit8(e, 0x0F); emit8(e, 0xB6); emit_cpu_operand(e, RDX, reg8_offset[src]);
+        emit_alu8(e, dst);
+        emit_retire(e, op);
+        return true;
+    }
+    if ((opcode & 0xC7) == 0xC6)                              // ALU A,n
+    {
+        emit8(e, 0xBA); emit32(e, op->bytes[1]);              // mov edx, n
+        emit_alu8(e, dst);
+        emit_retire(e, op);
+        return true;
+    }
+#endif
+    return false;
+}
+
+// Call the interpreter handler exactly as z80_block_execute() does
+static void emit_handler_call(struct jit_emitter *e, struct z80_block_cache *cache,
+                              const struct z80_block_op *op, const struct z80_block_op *next)
+{
+    emit8(e, 0x66); emit8(e, 0x83); emit_cpu_operand(e, 0, CPU_REG(PC)); emit8(e, op->fetch_length);
+    emit8(e, 0xC7); emit_cpu_operand(e, 0, CPU_FIELD(cycle_count)); emit32(e, 0);
+    emit8(e, 0x48); emit8(e, 0x89); emit8(e, MODRM_ARG0_RBX);
+    emit8(e, OP_ARG1_IMM32); emit32(e, op->opcode);
+    emit8(e, 0x48); emit8(e, 0xB8); emit64(e, (uint64_t)(uintptr_t)op->execute);   // mov rax, handler
+    emit8(e, 0xFF); emit8(e, 0xD0);                                               // call rax
+    emit8(e, 0x8B); emit_cpu_operand(e, RAX, CPU_FIELD(cycle_count));
+    emit8(e, 0x48); emit8(e, 0x01); emit_cpu_operand(e, RAX, CPU_FIELD(cycles));   // cycles += cycle_count
+
+    if (!next)
+        return;
+
+    emit_deadline_check(e);
+    emit8(e, 0x80); emit_cpu_operand(e, 7, CPU_FIELD(halted)); emit8(e, 0);       // cmp byte [halted], 0
+    emit_exit_if(e, JCC_NE);
+    emit8(e, 0x80); emit_cpu_operand(e, 7, CPU_FIELD(running)); emit8(e, 0);
+    emit_exit_if(e, JCC_E);
+    emit8(e, 0x48); emit8(e, 0xB8); emit64(e, (uint64_t)(uintptr_t)&cache->dirty);
+    emit8(e, 0x80); emit8(e, 0x38); emit8(e, 0);                                  // cmp byte [rax], 0
+    emit_exit_if(e, JCC_NE);
+    emit8(e, 0x66); emit8(e, 0x81); emit_cpu_operand(e, 7, CPU_REG(PC)); emit16(e, next->pc);
+    emit_exit_if(e, JCC_NE);
+}
+
+static void jit_translate(struct z80_jit *jit, struct z80_block_cache *cache, struct z80_block *block)
+{
+    struct jit_emitter e;
+    uint8_t *start = jit->code + jit->code_used;
+
+    e.p = start;
+    e.exit_count = 0;
+    emit_prologue(&e);
+    for (int i = 0; i < block->count; i += 1 + block->ops[i].fused)
+    {
+        const struct z80_block_op *op = &block->ops[i];
+        int next_index = i + 1 + op->fused;
+        const struct z80_block_op *next = next_index < block->count ? &block->ops[next_index] : NULL;
+
+        if (emit_inline_op(&e, op))
+        {
+            if (next)
+                emit_deadline_check(&e);
+        }
+        else
+        {
+            emit_handler_call(&e, cache, op, next);
+        }
+    }
+    emit_epilogue(&e);
+
+    jit->code_used += e.p - start;
+    jit->translated++;
+    block->native = start;
+}
+
+// The code buffer is never writable and executable at once: it is made
+// writable for a translation and executable again before generated code
+// next runs. Only changes of state cost a system call.
+static bool jit_set_writable(struct z80_jit *jit, bool writable)
+{
+    if (jit->writable == writable)
+        return true;
+
+#if Z80_JIT_SUPPORTED
+#ifdef _WIN32
+    DWORD old_protect;
+    if (!VirtualProtect(jit->code, Z80_JIT_CODE_SIZE, writable ? PAGE_READWRITE : PAGE_EXECUTE_READ,
+                        &old_protect))
+        return false;
+#else
+    if (mprotect(jit->code, Z80_JIT_CODE_SIZE, writable ? PROT_READ | PROT_WRITE : PROT_READ | PROT_EXEC) != 0)
+        return false;
+#endif
+#endif
+    jit->writable = writable;
+    return true;
+}
+
+static struct z80_block *jit_compile(struct z80_t *cpu, uint16_t pc)
+{
+    struct z80_jit *jit = cpu->jit;
+    struct z80_block *block = z80_block_lookup(cpu, pc);
+
+    if (block->native)
+        return block;
+
+    if (jit->code_used + JIT_BLOCK_MAX_CODE > Z80_JIT_CODE_SIZE)
+    {
+        // Out of space: drop every translation and start over
+        z80_block_cache_flush(cpu);
+        jit->code_used = 0;
+        jit->flushes++;
+        block = z80_block_lookup(cpu, pc);
+    }
+    if (jit_set_writable(jit, true))
+        jit_translate(jit, cpu->block_cache, block);
+    return block;
+}
+
+struct z80_jit *z80_jit_create(enum z80_jit_mode mode)
+{
+#if Z80_JIT_SUPPORTED
+    struct z80_jit *jit = calloc(1, sizeof(struct z80_jit));
+    if (!jit)
+        return NULL;
+
+#ifdef _WIN32
+    jit->code = VirtualAlloc(NULL, Z80_JIT_CODE_SIZE, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+#else
+    jit->code = mmap(NULL, Z80_JIT_CODE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (jit->code == MAP_FAILED)
+        jit->code = NULL;
+#endif
+    if (!jit->code)
+    {
+        free(jit);
+        return NULL;
+    }
+    jit->mode = mode;
+    jit->writable = true;
+    return jit;
+#else
+    (void)mode;
+    return NULL;
+#endif
+}
+
+void z80_jit_destroy(struct z80_jit *jit)
+{
+    if (!jit)
+        return;
+
+#if Z80_JIT_SUPPORTED
+#ifdef _WIN32
+    VirtualFree(jit->code, 0, MEM_RELEASE);
+#else
+    munmap(jit->code, Z80_JIT_CODE_SIZE);
+#endif
+#endif
+    free(jit);
+}
+
+// Attach a recompiler to the CPU (or detach with NULL). Translations hang
+// off decoded blocks, so a block cache must already be attached.
+void z80_jit_attach(struct z80_t *cpu, struct z80_jit *jit)
+{
+    cpu->jit = jit;
+    if (jit)
+    {
+        jit->code_used = 0;
+        z80_block_cache_flush(cpu);
+    }
+}
+
+void z80_bus_log_record(struct z80_t *cpu, uint8_t kind, uint16_t addr, uint8_t value)
+{
+    struct z80_bus_log *log = cpu->bus_log;
+
+    if (log->count == Z80_BUS_LOG_SIZE)
+    {
+        log->overflow = true;
+        return;
+    }
+    log->entries[log->count].addr = addr;
+    log->entries[log->count].kind = kind;
+    log->entries[log->count].value = value;
+    log->count++;
+}
+
+// Next journaled access: returns what the bus gave the interpreter and flags
+// any access that differs from it
+uint8_t z80_bus_log_replay(struct z80_t *cpu, uint8_t kind, uint16_t addr, uint8_t value)
+{
+    struct z80_bus_log *log = cpu->bus_log;
+
+    if (log->pos == log->count)
+    {
+        log->mismatch = true;
+        return 0xFF;
+    }
+
+    uint8_t logged = log->entries[log->pos].kind;
+    uint8_t logged_value = log->entries[log->pos].value;
+    bool is_write = kind == Z80_BUS_WRITE || kind == Z80_BUS_OUT;
+
+    if ((logged & ~Z80_BUS_INVALIDATE) != kind || log->entries[log->pos].addr != addr ||
+        (is_write && logged_value != value))
+    {
+        log->mismatch = true;
+    }
+    if (logged & Z80_BUS_INVALIDATE)
+    {
+        cpu->block_cache->dirty = true;
+    }
+    log->pos++;
+    return logged_value;
+}
+
+// Instruction bytes for the recompiled pass, taken from the decode so an
+// instruction that overwrote its own operands sees what the interpreter saw
+uint8_t z80_bus_log_fetch(struct z80_t *cpu, uint16_t addr)
+{
+    struct z80_bus_log *log = cpu->bus_log;
+    const struct z80_block *block = log->block;
+
+    for (int i = 0; i < block->count; i++)
+    {
+        uint16_t offset = addr - block->ops[i].pc;
+        if (offset < block->ops[i].length)
+        {
+            return block->ops[i].bytes[offset];
+        }
+    }
+    log->mismatch = true;
+    return 0xFF;
+}
+
+static bool jit_same_state(const struct z80_t *a, const struct z80_t *b)
+{
+    return memcmp(&a->registers, &b->registers, sizeof(a->registers)) == 0 &&
+           a->cycles == b->cycles &&
+           a->halted == b->halted &&
+           a->running == b->running &&
+           a->iff1 == b->iff1 &&
+           a->iff2 == b->iff2 &&
+           a->int_mode == b->int_mode;
+}
+
+static void jit_report(struct z80_jit *jit, const struct z80_block *block,
+                       const struct z80_t *native, const struct z80_t *expected)
+{
+    if (jit->divergences++ >= JIT_MAX_REPORTS)
+        return;
+
+    printf("JIT mismatch in block %04X (bank %u)%s\n",
+        block->key & 0xFFFF, block->key >> 16, jit->log.mismatch ? ", bus accesses differ" : "");
+    printf("  native: PC:%04X SP:%04X AF:%04X BC:%04X DE:%04X HL:%04X IX:%04X IY:%04X CYC:%llu\n",
+        native->registers.PC, native->registers.SP, native->registers.AF, native->registers.BC,
+        native->registers.DE, native->registers.HL, native->registers.IX, native->registers.IY,
+        (unsigned long long)native->cycles);
+    printf("  interp: PC:%04X SP:%04X AF:%04X BC:%04X DE:%04X HL:%04X IX:%04X IY:%04X CYC:%llu\n",
+        expected->registers.PC, expected->registers.SP, expected->registers.AF, expected->registers.BC,
+        expected->registers.DE, expected->registers.HL, expected->registers.IX, expected->registers.IY,
+        (unsigned long long)expected->cycles);
+}
+
+// Lockstep check of one block. The interpreter runs it against the real bus
+// with every access journaled; the translation then runs from the same
+// starting state with the journal standing in for the bus. The interpreter's
+// result is kept either way, so a bad translation is reported, not executed.
+static void jit_verify(struct z80_t *cpu, struct z80_block *block, uint64_t deadline)
+{
+    struct z80_jit *jit = cpu->jit;
+    struct z80_bus_log *log = &jit->log;
+    struct z80_t start = *cpu;
+    struct z80_t expected;
+
+    log->read_pages = cpu->read_pages;
+    log->write_pages = cpu->write_pages;
+    log->block = block;
+    log->replay = false;
+    log->mismatch = false;
+    log->overflow = false;
+    log->count = 0;
+    log->pos = 0;
+
+    cpu->read_pages = jit_unmapped_pages;
+    cpu->write_pages = jit_unmapped_pages;
+    cpu->bus_log = log;
+    z80_block_execute(cpu, block, deadline);
+    z80_sync_flags(cpu);
+    expected = *cpu;
+
+    *cpu = start;
+    cpu->read_pages = jit_unmapped_pages;
+    cpu->write_pages = jit_unmapped_pages;
+    cpu->bus_log = log;
+    log->replay = true;
+    cpu->block_cache->dirty = false;
+    ((jit_block_fn)block->native)(cpu, deadline);
+    z80_sync_flags(cpu);
+
+    jit->verified++;
+    if (!log->overflow && (log->mismatch || log->pos != log->count || !jit_same_state(cpu, &expected)))
+    {
+        jit_report(jit, block, cpu, &expected);
+    }
+
+    *cpu = expected;
+    cpu->read_pages = log->read_pages;
+    cpu->write_pages = log->write_pages;
+    cpu->bus_log = NULL;
+}
+
+// Recompiled counterpart of z80_run_blocks()
+void z80_jit_run(struct z80_t *cpu, uint64_t deadline)
+{
+    struct z80_jit *jit = cpu->jit;
+
+    while (cpu->cycles < deadline && cpu->running && !cpu->halted && !cpu->exit_reason)
+    {
+        if (cpu->int_pending)
+            z80_check_interrupts(cpu);
+
+        struct z80_block *block = jit_compile(cpu, cpu->registers.PC);
+        if (!block->native || !jit_set_writable(jit, false))
+        {
+            // Left untranslated: the buffer's protection could not be changed
+            z80_block_execute(cpu, block, deadline);
+            continue;
+        }
+        if (jit->mode == Z80_JIT_VERIFY)
+        {
+            jit_verify(cpu, block, deadline);
+            continue;
+        }
+        cpu->block_cache->dirty = false;
+        ((jit_block_fn)block->native)(cpu, deadline);
+    }
+}
@@ -0,0 +1,78 @@
+#ifndef Z80_JIT_H_
+#define Z80_JIT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "z80.h"
+#include "z80_block.h"
+
+// Native code generation is x86-64 only; elsewhere z80_jit_create() returns
+// NULL and the interpreter keeps running
+#if defined(__x86_64__) || defined(_M_X64)
+#define Z80_JIT_SUPPORTED 1
+#else
+#define Z80_JIT_SUPPORTED 0
+#endif
+
+#define Z80_JIT_CODE_SIZE   (4 << 20)  // code buffer, flushed whole when full
+#define Z80_BUS_LOG_SIZE    256        // accesses journaled per verified block
+
+enum z80_jit_mode
+{
+    Z80_JIT_RUN,      // run recompiled blocks
+    Z80_JIT_VERIFY,   // run every block on both paths and compare (slow)
+};
+
+// Journal entry kinds; Z80_BUS_INVALIDATE marks a write that hit decoded code
+enum z80_bus_kind
+{
+    Z80_BUS_READ,
+    Z80_BUS_WRITE,
+    Z80_BUS_IN,
+    Z80_BUS_OUT,
+    Z80_BUS_INVALIDATE = 0x80,
+};
+
+// Bus accesses of one block. The interpreter's pass records them against the
+// real bus; the recompiled pass is fed from (and checked against) the list.
+struct z80_bus_log
+{
+    uint8_t *const *read_pages;   // host tables while the CPU's are unmapped
+    uint8_t *const *write_pages;
+    const struct z80_block *block; // block being checked
+    bool replay;
+    bool mismatch;
+    bool overflow;
+    uint16_t count;
+    uint16_t pos;
+    struct
+    {
+        uint16_t addr;
+        uint8_t kind;
+        uint8_t value;
+    } entries[Z80_BUS_LOG_SIZE];
+};
+
+struct z80_jit
+{
+    enum z80_jit_mode mode;
+    uint8_t *code;
+    size_t code_used;
+    bool writable;         // code is RW while translating, RX while it runs
+    uint64_t translated;
+    uint64_t flushes;
+    uint64_t verified;
+    uint64_t divergences;
+    struct z80_bus_log log;
+};
+
+struct z80_jit *z80_jit_create(enum z80_jit_mode mode);
+void z80_jit_destroy(struct z80_jit *jit);
+void z80_jit_attach(struct z80_t *cpu, struct z80_jit *jit);
+void z80_jit_run(struct z80_t *cpu, uint64_t deadline);
+void z80_bus_log_record(struct z80_t *cpu, uint8_t kind, uint16_t addr, uint8_t value);
+uint8_t z80_bus_log_replay(struct z80_t *cpu, uint8_t kind, uint16_t addr, uint8_t value);
+uint8_t z80_bus_log_fetch(struct z80_t *cpu, uint16_t addr);
+
+#endif
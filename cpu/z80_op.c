@@ -60,8 +60,8 @@ void z80_op_call(struct z80_t *cpu, bool condition)
         }
 
         // Normal CALL instruction
-        z80_stack_push16(cpu, cpu->registers.PC); // 6 cycles
-        cpu->cycle_count++;                       // 1 cycle
+        z80_stack_push16(cpu, cpu->registers.PC);
+        cpu->cycle_count += Z80_TIMING_CALL_TAKEN;
         cpu->registers.PC = addr;
     }
     // If condition is false, do nothing (conditional call not taken)
@@ -69,10 +69,10 @@ void z80_op_call(struct z80_t *cpu, bool condition)
 
 void z80_op_ret(struct z80_t *cpu, bool condition)
 {
-    cpu->cycle_count++; // 1 cycle
     if(condition)
     {
-        uint16_t addr = z80_stack_pop16(cpu); // 6 cycles
+        uint16_t addr = z80_stack_pop16(cpu);
+        cpu->cycle_count += Z80_TIMING_RET_TAKEN;
         cpu->registers.PC = addr;  // Always set PC to the popped address
     }
 }
@@ -81,7 +81,12 @@ void z80_op_jp(struct z80_t *cpu, bool condition)
 {
     uint16_t jp_addr = z80_fetch16(cpu); // 6 cycles
     if(condition)
+    {
+        bool backward = jp_addr < cpu->registers.PC;
         cpu->registers.PC = jp_addr;
+        if (backward && cpu->idle_skip)
+            z80_idle_check(cpu);
+    }
 }
 
 void z80_op_jr(struct z80_t *cpu, bool condition)
@@ -91,7 +96,9 @@ void z80_op_jr(struct z80_t *cpu, bool condition)
     if (condition)
     {
         cpu->registers.PC += offset;
-        cpu->cycle_count += 5;  // Branch taken penalty
+        cpu->cycle_count += Z80_TIMING_JR_TAKEN;
+        if (offset < 0 && cpu->idle_skip)
+            z80_idle_check(cpu);
     }
 }
 
@@ -191,7 +198,6 @@ uint8_t z80_op_srl(struct z80_t *cpu, uint8_t r)
 
 uint16_t z80_op_add16(struct z80_t *cpu, uint16_t rp, uint16_t value)
 {
-    cpu->cycle_count += 7;
     uint16_t result = rp + value; 
     set_flags_add16(cpu, rp, value, result);
     return result;
@@ -255,7 +261,6 @@ void z80_op_rrd(struct z80_t *cpu)
 
 void z80_op_adc16(struct z80_t *cpu, uint16_t rr)
 {
-    cpu->cycle_count += 7;
     uint16_t result = cpu->registers.HL + rr + IS_C_SET(cpu);
     set_flags_adc16(cpu, cpu->registers.HL, rr, result);
     cpu->registers.HL = result;
@@ -263,7 +268,6 @@ void z80_op_adc16(struct z80_t *cpu, uint16_t rr)
 
 void z80_op_sbc16(struct z80_t *cpu, uint16_t rr)
 {
-    cpu->cycle_count += 7;
     uint16_t result = cpu->registers.HL - rr - IS_C_SET(cpu);
     set_flags_sbc16(cpu, cpu->registers.HL, rr, result);
     cpu->registers.HL = result;
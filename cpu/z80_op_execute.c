@@ -134,313 +134,422 @@ enum z80_opcodes
     DD_PREFIX = 0xDD, ED_PREFIX = 0xED, FD_PREFIX = 0xFD, CB_PREFIX = 0xCB
 };
 
+#if Z80_COMPUTED_GOTO
+// Threaded dispatch: every handler ends by fetching the next opcode and
+// jumping straight to its handler, so control only returns to the caller
+// once the deadline is reached or the CPU halts/stops.
+#define Z80_SINGLE_STEP 0
+#define OP(name)    op_##name:
+#define OP_DEFAULT  op_unimplemented:
+#define NEXT                                                            \
+    do                                                                  \
+    {                                                                   \
+        if (deadline == Z80_SINGLE_STEP)                                \
+            return;                                                     \
+        cpu->cycles += cpu->cycle_count;                                \
+        if (cpu->cycles >= deadline || cpu->halted || !cpu->running ||  \
+            cpu->exit_reason)                                           \
+            return;                                                     \
+        if (cpu->int_pending)                                           \
+            z80_check_interrupts(cpu);                                  \
+        opcode = z80_fetch_opcode(cpu);                                 \
+        cpu->cycle_count = z80_timing_base[opcode];                     \
+        goto *dispatch_table[opcode];                                   \
+    } while (0)
+
+static void z80_execute_threaded(struct z80_t *cpu, uint8_t opcode, uint64_t deadline)
+{
+    // Every slot defaults to op_unimplemented and the named ones override it
+#pragma GCC diagnostic push
+#ifdef __clang__
+#pragma GCC diagnostic ignored "-Winitializer-overrides"
+#else
+#pragma GCC diagnostic ignored "-Woverride-init"
+#endif
+    static const void *const dispatch_table[256] =
+    {
+        [0 ... 255] = &&op_unimplemented,
+        [NOP] = &&op_NOP, [HALT] = &&op_HALT, [DI] = &&op_DI, [EI] = &&op_EI,
+        [LD_B_n] = &&op_LD_B_n, [LD_C_n] = &&op_LD_C_n, [LD_D_n] = &&op_LD_D_n, [LD_E_n] = &&op_LD_E_n,
+        [LD_H_n] = &&op_LD_H_n, [LD_L_n] = &&op_LD_L_n, [LD_A_n] = &&op_LD_A_n, [LD_HL_n] = &&op_LD_HL_n,
+        [LD_B_B] = &&op_LD_B_B, [LD_B_C] = &&op_LD_B_C, [LD_B_D] = &&op_LD_B_D, [LD_B_E] = &&op_LD_B_E,
+        [LD_B_H] = &&op_LD_B_H, [LD_B_L] = &&op_LD_B_L, [LD_B_HL] = &&op_LD_B_HL, [LD_B_A] = &&op_LD_B_A,
+        [LD_C_B] = &&op_LD_C_B, [LD_C_C] = &&op_LD_C_C, [LD_C_D] = &&op_LD_C_D, [LD_C_E] = &&op_LD_C_E,
+        [LD_C_H] = &&op_LD_C_H, [LD_C_L] = &&op_LD_C_L, [LD_C_HL] = &&op_LD_C_HL, [LD_C_A] = &&op_LD_C_A,
+        [LD_D_B] = &&op_LD_D_B, [LD_D_C] = &&op_LD_D_C, [LD_D_D] = &&op_LD_D_D, [LD_D_E] = &&op_LD_D_E,
+        [LD_D_H] = &&op_LD_D_H, [LD_D_L] = &&op_LD_D_L, [LD_D_HL] = &&op_LD_D_HL, [LD_D_A] = &&op_LD_D_A,
+        [LD_E_B] = &&op_LD_E_B, [LD_E_C] = &&op_LD_E_C, [LD_E_D] = &&op_LD_E_D, [LD_E_E] = &&op_LD_E_E,
+        [LD_E_H] = &&op_LD_E_H, [LD_E_L] = &&op_LD_E_L, [LD_E_HL] = &&op_LD_E_HL, [LD_E_A] = &&op_LD_E_A,
+        [LD_H_B] = &&op_LD_H_B, [LD_H_C] = &&op_LD_H_C, [LD_H_D] = &&op_LD_H_D, [LD_H_E] = &&op_LD_H_E,
+        [LD_H_H] = &&op_LD_H_H, [LD_H_L] = &&op_LD_H_L, [LD_H_HL] = &&op_LD_H_HL, [LD_H_A] = &&op_LD_H_A,
+        [LD_L_B] = &&op_LD_L_B, [LD_L_C] = &&op_LD_L_C, [LD_L_D] = &&op_LD_L_D, [LD_L_E] = &&op_LD_L_E,
+        [LD_L_H] = &&op_LD_L_H, [LD_L_L] = &&op_LD_L_L, [LD_L_HL] = &&op_LD_L_HL, [LD_L_A] = &&op_LD_L_A,
+        [LD_HL_B] = &&op_LD_HL_B, [LD_HL_C] = &&op_LD_HL_C, [LD_HL_D] = &&op_LD_HL_D, [LD_HL_E] = &&op_LD_HL_E,
+        [LD_HL_H] = &&op_LD_HL_H, [LD_HL_L] = &&op_LD_HL_L, [LD_HL_A] = &&op_LD_HL_A, [LD_A_B] = &&op_LD_A_B,
+        [LD_A_C] = &&op_LD_A_C, [LD_A_D] = &&op_LD_A_D, [LD_A_E] = &&op_LD_A_E, [LD_A_H] = &&op_LD_A_H,
+        [LD_A_L] = &&op_LD_A_L, [LD_A_HL] = &&op_LD_A_HL, [LD_A_A] = &&op_LD_A_A, [LD_BC_A] = &&op_LD_BC_A,
+        [LD_DE_A] = &&op_LD_DE_A, [LD_A_BC] = &&op_LD_A_BC, [LD_A_DE] = &&op_LD_A_DE, [LD_nn_A] = &&op_LD_nn_A,
+        [LD_A_nn] = &&op_LD_A_nn, [LD_BC_nn] = &&op_LD_BC_nn, [LD_DE_nn] = &&op_LD_DE_nn, [LD_HL_nn] = &&op_LD_HL_nn,
+        [LD_SP_nn] = &&op_LD_SP_nn, [LD_nn_HL] = &&op_LD_nn_HL, [LD_HL_nn_ind] = &&op_LD_HL_nn_ind, [LD_SP_HL] = &&op_LD_SP_HL,
+        [INC_B] = &&op_INC_B, [INC_C] = &&op_INC_C, [INC_D] = &&op_INC_D, [INC_E] = &&op_INC_E,
+        [INC_H] = &&op_INC_H, [INC_L] = &&op_INC_L, [INC_A] = &&op_INC_A, [INC_HL_] = &&op_INC_HL_,
+        [DEC_B] = &&op_DEC_B, [DEC_C] = &&op_DEC_C, [DEC_D] = &&op_DEC_D, [DEC_E] = &&op_DEC_E,
+        [DEC_H] = &&op_DEC_H, [DEC_L] = &&op_DEC_L, [DEC_A] = &&op_DEC_A, [DEC_HL_] = &&op_DEC_HL_,
+        [INC_BC] = &&op_INC_BC, [INC_DE] = &&op_INC_DE, [INC_HL] = &&op_INC_HL, [INC_SP] = &&op_INC_SP,
+        [DEC_BC] = &&op_DEC_BC, [DEC_DE] = &&op_DEC_DE, [DEC_HL] = &&op_DEC_HL, [DEC_SP] = &&op_DEC_SP,
+        [ADD_A_B] = &&op_ADD_A_B, [ADD_A_C] = &&op_ADD_A_C, [ADD_A_D] = &&op_ADD_A_D, [ADD_A_E] = &&op_ADD_A_E,
+        [ADD_A_H] = &&op_ADD_A_H, [ADD_A_L] = &&op_ADD_A_L, [ADD_A_HL] = &&op_ADD_A_HL, [ADD_A_A] = &&op_ADD_A_A,
+        [ADD_A_n] = &&op_ADD_A_n, [ADC_A_B] = &&op_ADC_A_B, [ADC_A_C] = &&op_ADC_A_C, [ADC_A_D] = &&op_ADC_A_D,
+        [ADC_A_E] = &&op_ADC_A_E, [ADC_A_H] = &&op_ADC_A_H, [ADC_A_L] = &&op_ADC_A_L, [ADC_A_HL] = &&op_ADC_A_HL,
+        [ADC_A_A] = &&op_ADC_A_A, [ADC_A_n] = &&op_ADC_A_n, [SUB_B] = &&op_SUB_B, [SUB_C] = &&op_SUB_C,
+        [SUB_D] = &&op_SUB_D, [SUB_E] = &&op_SUB_E, [SUB_H] = &&op_SUB_H, [SUB_L] = &&op_SUB_L,
+        [SUB_HL] = &&op_SUB_HL, [SUB_A] = &&op_SUB_A, [SUB_n] = &&op_SUB_n, [SBC_A_B] = &&op_SBC_A_B,
+        [SBC_A_C] = &&op_SBC_A_C, [SBC_A_D] = &&op_SBC_A_D, [SBC_A_E] = &&op_SBC_A_E, [SBC_A_H] = &&op_SBC_A_H,
+        [SBC_A_L] = &&op_SBC_A_L, [SBC_A_HL] = &&op_SBC_A_HL, [SBC_A_A] = &&op_SBC_A_A, [SBC_A_n] = &&op_SBC_A_n,
+        [ADD_HL_BC] = &&op_ADD_HL_BC, [ADD_HL_DE] = &&op_ADD_HL_DE, [ADD_HL_HL] = &&op_ADD_HL_HL, [ADD_HL_SP] = &&op_ADD_HL_SP,
+        [AND_B] = &&op_AND_B, [AND_C] = &&op_AND_C, [AND_D] = &&op_AND_D, [AND_E] = &&op_AND_E,
+        [AND_H] = &&op_AND_H, [AND_L] = &&op_AND_L, [AND_HL] = &&op_AND_HL, [AND_A] = &&op_AND_A,
+        [AND_n] = &&op_AND_n, [XOR_B] = &&op_XOR_B, [XOR_C] = &&op_XOR_C, [XOR_D] = &&op_XOR_D,
+        [XOR_E] = &&op_XOR_E, [XOR_H] = &&op_XOR_H, [XOR_L] = &&op_XOR_L, [XOR_HL] = &&op_XOR_HL,
+        [XOR_A] = &&op_XOR_A, [XOR_n] = &&op_XOR_n, [OR_B] = &&op_OR_B, [OR_C] = &&op_OR_C,
+        [OR_D] = &&op_OR_D, [OR_E] = &&op_OR_E, [OR_H] = &&op_OR_H, [OR_L] = &&op_OR_L,
+        [OR_HL] = &&op_OR_HL, [OR_A] = &&op_OR_A, [OR_n] = &&op_OR_n, [CP_B] = &&op_CP_B,
+        [CP_C] = &&op_CP_C, [CP_D] = &&op_CP_D, [CP_E] = &&op_CP_E, [CP_H] = &&op_CP_H,
+        [CP_L] = &&op_CP_L, [CP_HL] = &&op_CP_HL, [CP_A] = &&op_CP_A, [CP_n] = &&op_CP_n,
+        [RLCA] = &&op_RLCA, [RRCA] = &&op_RRCA, [RRA] = &&op_RRA, [RLA] = &&op_RLA,
+        [JP_nn] = &&op_JP_nn, [JP_NZ_nn] = &&op_JP_NZ_nn, [JP_Z_nn] = &&op_JP_Z_nn, [JP_NC_nn] = &&op_JP_NC_nn,
+        [JP_C_nn] = &&op_JP_C_nn, [JP_PO_nn] = &&op_JP_PO_nn, [JP_PE_nn] = &&op_JP_PE_nn, [JP_P_nn] = &&op_JP_P_nn,
+        [JP_M_nn] = &&op_JP_M_nn, [JP_HL] = &&op_JP_HL, [JR_d] = &&op_JR_d, [JR_NZ_d] = &&op_JR_NZ_d,
+        [JR_Z_d] = &&op_JR_Z_d, [JR_NC_d] = &&op_JR_NC_d, [JR_C_d] = &&op_JR_C_d, [DJNZ_e] = &&op_DJNZ_e,
+        [CALL_nn] = &&op_CALL_nn, [CALL_Z_nn] = &&op_CALL_Z_nn, [CALL_NZ_nn] = &&op_CALL_NZ_nn, [CALL_C_nn] = &&op_CALL_C_nn,
+        [CALL_NC_nn] = &&op_CALL_NC_nn, [RET] = &&op_RET, [RET_Z] = &&op_RET_Z, [RET_NZ] = &&op_RET_NZ,
+        [RET_PE] = &&op_RET_PE, [RET_PO] = &&op_RET_PO, [RET_C] = &&op_RET_C, [RET_NC] = &&op_RET_NC,
+        [RET_M] = &&op_RET_M, [RET_P] = &&op_RET_P, [POP_BC] = &&op_POP_BC, [POP_DE] = &&op_POP_DE,
+        [POP_HL] = &&op_POP_HL, [POP_AF] = &&op_POP_AF, [PUSH_BC] = &&op_PUSH_BC, [PUSH_DE] = &&op_PUSH_DE,
+        [PUSH_HL] = &&op_PUSH_HL, [PUSH_AF] = &&op_PUSH_AF, [RST_00] = &&op_RST_00, [RST_08] = &&op_RST_08,
+        [RST_10] = &&op_RST_10, [RST_18] = &&op_RST_18, [RST_20] = &&op_RST_20, [RST_28] = &&op_RST_28,
+        [RST_30] = &&op_RST_30, [RST_38] = &&op_RST_38, [EX_AF_AF] = &&op_EX_AF_AF, [EXX] = &&op_EXX,
+        [EX_DE_HL] = &&op_EX_DE_HL, [DAA] = &&op_DAA, [CPL] = &&op_CPL, [SCF] = &&op_SCF,
+        [CCF] = &&op_CCF, [IN_A_n] = &&op_IN_A_n, [OUT_n_A] = &&op_OUT_n_A, [DD_PREFIX] = &&op_DD_PREFIX,
+        [ED_PREFIX] = &&op_ED_PREFIX, [FD_PREFIX] = &&op_FD_PREFIX, [CB_PREFIX] = &&op_CB_PREFIX,
+    };
+#pragma GCC diagnostic pop
+
+    cpu->cycle_count += z80_timing_base[opcode];
+    goto *dispatch_table[opcode];
+    {
+#else
+#define OP(name)    case name:
+#define OP_DEFAULT  default:
+#define NEXT        break
+
 void z80_execute_instruction(struct z80_t *cpu, uint8_t opcode)
 {
+    cpu->cycle_count += z80_timing_base[opcode];
     switch (opcode)
     {
+#endif
     // === CONTROL INSTRUCTIONS ===
-    case NOP: break;
-    case HALT: cpu->halted = true; break;
-    case DI: cpu->iff1 = cpu->iff2 = false; break;
-    case EI: cpu->iff1 = cpu->iff2 = true; break;
+    OP(NOP) NEXT;
+    OP(HALT) cpu->halted = true; NEXT;
+    OP(DI) cpu->iff1 = cpu->iff2 = false; z80_update_int_pending(cpu); NEXT;
+    OP(EI) cpu->iff1 = cpu->iff2 = true; z80_update_int_pending(cpu); NEXT;
     
     // === 8-BIT LOAD INSTRUCTIONS - Immediate ===
-    case LD_B_n: cpu->registers.B = z80_fetch8(cpu); break;
-    case LD_C_n: cpu->registers.C = z80_fetch8(cpu); break;
-    case LD_D_n: cpu->registers.D = z80_fetch8(cpu); break;
-    case LD_E_n: cpu->registers.E = z80_fetch8(cpu); break;
-    case LD_H_n: cpu->registers.H = z80_fetch8(cpu); break;
-    case LD_L_n: cpu->registers.L = z80_fetch8(cpu); break;
-    case LD_A_n: cpu->registers.A = z80_fetch8(cpu); break;
-    case LD_HL_n: z80_write8(cpu, cpu->registers.HL, z80_fetch8(cpu)); break;
+    OP(LD_B_n) cpu->registers.B = z80_fetch8(cpu); NEXT;
+    OP(LD_C_n) cpu->registers.C = z80_fetch8(cpu); NEXT;
+    OP(LD_D_n) cpu->registers.D = z80_fetch8(cpu); NEXT;
+    OP(LD_E_n) cpu->registers.E = z80_fetch8(cpu); NEXT;
+    OP(LD_H_n) cpu->registers.H = z80_fetch8(cpu); NEXT;
+    OP(LD_L_n) cpu->registers.L = z80_fetch8(cpu); NEXT;
+    OP(LD_A_n) cpu->registers.A = z80_fetch8(cpu); NEXT;
+    OP(LD_HL_n) z80_write8(cpu, cpu->registers.HL, z80_fetch8(cpu)); NEXT;
     
     // === 8-BIT LOAD INSTRUCTIONS - Register to Register ===
-    case LD_B_B: cpu->registers.B = cpu->registers.B; break;
-    case LD_B_C: cpu->registers.B = cpu->registers.C; break;
-    case LD_B_D: cpu->registers.B = cpu->registers.D; break;
-    case LD_B_E: cpu->registers.B = cpu->registers.E; break;
-    case LD_B_H: cpu->registers.B = cpu->registers.H; break;
-    case LD_B_L: cpu->registers.B = cpu->registers.L; break;
-    case LD_B_HL: cpu->registers.B = z80_read8(cpu, cpu->registers.HL); break;
-    case LD_B_A: cpu->registers.B = cpu->registers.A; break;
-    case LD_C_B: cpu->registers.C = cpu->registers.B; break;
-    case LD_C_C: cpu->registers.C = cpu->registers.C; break;
-    case LD_C_D: cpu->registers.C = cpu->registers.D; break;
-    case LD_C_E: cpu->registers.C = cpu->registers.E; break;
-    case LD_C_H: cpu->registers.C = cpu->registers.H; break;
-    case LD_C_L: cpu->registers.C = cpu->registers.L; break;
-    case LD_C_HL: cpu->registers.C = z80_read8(cpu, cpu->registers.HL); break;
-    case LD_C_A: cpu->registers.C = cpu->registers.A; break;
-    case LD_D_B: cpu->registers.D = cpu->registers.B; break;
-    case LD_D_C: cpu->registers.D = cpu->registers.C; break;
-    case LD_D_D: cpu->registers.D = cpu->registers.D; break;
-    case LD_D_E: cpu->registers.D = cpu->registers.E; break;
-    case LD_D_H: cpu->registers.D = cpu->registers.H; break;
-    case LD_D_L: cpu->registers.D = cpu->registers.L; break;
-    case LD_D_HL: cpu->registers.D = z80_read8(cpu, cpu->registers.HL); break;
-    case LD_D_A: cpu->registers.D = cpu->registers.A; break;
-    case LD_E_B: cpu->registers.E = cpu->registers.B; break;
-    case LD_E_C: cpu->registers.E = cpu->registers.C; break;
-    case LD_E_D: cpu->registers.E = cpu->registers.D; break;
-    case LD_E_E: cpu->registers.E = cpu->registers.E; break;
-    case LD_E_H: cpu->registers.E = cpu->registers.H; break;
-    case LD_E_L: cpu->registers.E = cpu->registers.L; break;
-    case LD_E_HL: cpu->registers.E = z80_read8(cpu, cpu->registers.HL); break;
-    case LD_E_A: cpu->registers.E = cpu->registers.A; break;
-    case LD_H_B: cpu->registers.H = cpu->registers.B; break;
-    case LD_H_C: cpu->registers.H = cpu->registers.C; break;
-    case LD_H_D: cpu->registers.H = cpu->registers.D; break;
-    case LD_H_E: cpu->registers.H = cpu->registers.E; break;
-    case LD_H_H: cpu->registers.H = cpu->registers.H; break;
-    case LD_H_L: cpu->registers.H = cpu->registers.L; break;
-    case LD_H_HL: cpu->registers.H = z80_read8(cpu, cpu->registers.HL); break;
-    case LD_H_A: cpu->registers.H = cpu->registers.A; break;
-    case LD_L_B: cpu->registers.L = cpu->registers.B; break;
-    case LD_L_C: cpu->registers.L = cpu->registers.C; break;
-    case LD_L_D: cpu->registers.L = cpu->registers.D; break;
-    case LD_L_E: cpu->registers.L = cpu->registers.E; break;
-    case LD_L_H: cpu->registers.L = cpu->registers.H; break;
-    case LD_L_L: cpu->registers.L = cpu->registers.L; break;
-    case LD_L_HL: cpu->registers.L = z80_read8(cpu, cpu->registers.HL); break;
-    case LD_L_A: cpu->registers.L = cpu->registers.A; break;
-    case LD_HL_B: z80_write8(cpu, cpu->registers.HL, cpu->registers.B); break;
-    case LD_HL_C: z80_write8(cpu, cpu->registers.HL, cpu->registers.C); break;
-    case LD_HL_D: z80_write8(cpu, cpu->registers.HL, cpu->registers.D); break;
-    case LD_HL_E: z80_write8(cpu, cpu->registers.HL, cpu->registers.E); break;
-    case LD_HL_H: z80_write8(cpu, cpu->registers.HL, cpu->registers.H); break;
-    case LD_HL_L: z80_write8(cpu, cpu->registers.HL, cpu->registers.L); break;
-    case LD_HL_A: z80_write8(cpu, cpu->registers.HL, cpu->registers.A); break;
-    case LD_A_B: cpu->registers.A = cpu->registers.B; break;
-    case LD_A_C: cpu->registers.A = cpu->registers.C; break;
-    case LD_A_D: cpu->registers.A = cpu->registers.D; break;
-    case LD_A_E: cpu->registers.A = cpu->registers.E; break;
-    case LD_A_H: cpu->registers.A = cpu->registers.H; break;
-    case LD_A_L: cpu->registers.A = cpu->registers.L; break;
-    case LD_A_HL: cpu->registers.A = z80_read8(cpu, cpu->registers.HL); break;
-    case LD_A_A: cpu->registers.A = cpu->registers.A; break;
+    OP(LD_B_B) cpu->registers.B = cpu->registers.B; NEXT;
+    OP(LD_B_C) cpu->registers.B = cpu->registers.C; NEXT;
+    OP(LD_B_D) cpu->registers.B = cpu->registers.D; NEXT;
+    OP(LD_B_E) cpu->registers.B = cpu->registers.E; NEXT;
+    OP(LD_B_H) cpu->registers.B = cpu->registers.H; NEXT;
+    OP(LD_B_L) cpu->registers.B = cpu->registers.L; NEXT;
+    OP(LD_B_HL) cpu->registers.B = z80_read8(cpu, cpu->registers.HL); NEXT;
+    OP(LD_B_A) cpu->registers.B = cpu->registers.A; NEXT;
+    OP(LD_C_B) cpu->registers.C = cpu->registers.B; NEXT;
+    OP(LD_C_C) cpu->registers.C = cpu->registers.C; NEXT;
+    OP(LD_C_D) cpu->registers.C = cpu->registers.D; NEXT;
+    OP(LD_C_E) cpu->registers.C = cpu->registers.E; NEXT;
+    OP(LD_C_H) cpu->registers.C = cpu->registers.H; NEXT;
+    OP(LD_C_L) cpu->registers.C = cpu->registers.L; NEXT;
+    OP(LD_C_HL) cpu->registers.C = z80_read8(cpu, cpu->registers.HL); NEXT;
+    OP(LD_C_A) cpu->registers.C = cpu->registers.A; NEXT;
+    OP(LD_D_B) cpu->registers.D = cpu->registers.B; NEXT;
+    OP(LD_D_C) cpu->registers.D = cpu->registers.C; NEXT;
+    OP(LD_D_D) cpu->registers.D = cpu->registers.D; NEXT;
+    OP(LD_D_E) cpu->registers.D = cpu->registers.E; NEXT;
+    OP(LD_D_H) cpu->registers.D = cpu->registers.H; NEXT;
+    OP(LD_D_L) cpu->registers.D = cpu->registers.L; NEXT;
+    OP(LD_D_HL) cpu->registers.D = z80_read8(cpu, cpu->registers.HL); NEXT;
+    OP(LD_D_A) cpu->registers.D = cpu->registers.A; NEXT;
+    OP(LD_E_B) cpu->registers.E = cpu->registers.B; NEXT;
+    OP(LD_E_C) cpu->registers.E = cpu->registers.C; NEXT;
+    OP(LD_E_D) cpu->registers.E = cpu->registers.D; NEXT;
+    OP(LD_E_E) cpu->registers.E = cpu->registers.E; NEXT;
+    OP(LD_E_H) cpu->registers.E = cpu->registers.H; NEXT;
+    OP(LD_E_L) cpu->registers.E = cpu->registers.L; NEXT;
+    OP(LD_E_HL) cpu->registers.E = z80_read8(cpu, cpu->registers.HL); NEXT;
+    OP(LD_E_A) cpu->registers.E = cpu->registers.A; NEXT;
+    OP(LD_H_B) cpu->registers.H = cpu->registers.B; NEXT;
+    OP(LD_H_C) cpu->registers.H = cpu->registers.C; NEXT;
+    OP(LD_H_D) cpu->registers.H = cpu->registers.D; NEXT;
+    OP(LD_H_E) cpu->registers.H = cpu->registers.E; NEXT;
+    OP(LD_H_H) cpu->registers.H = cpu->registers.H; NEXT;
+    OP(LD_H_L) cpu->registers.H = cpu->registers.L; NEXT;
+    OP(LD_H_HL) cpu->registers.H = z80_read8(cpu, cpu->registers.HL); NEXT;
+    OP(LD_H_A) cpu->registers.H = cpu->registers.A; NEXT;
+    OP(LD_L_B) cpu->registers.L = cpu->registers.B; NEXT;
+    OP(LD_L_C) cpu->registers.L = cpu->registers.C; NEXT;
+    OP(LD_L_D) cpu->registers.L = cpu->registers.D; NEXT;
+    OP(LD_L_E) cpu->registers.L = cpu->registers.E; NEXT;
+    OP(LD_L_H) cpu->registers.L = cpu->registers.H; NEXT;
+    OP(LD_L_L) cpu->registers.L = cpu->registers.L; NEXT;
+    OP(LD_L_HL) cpu->registers.L = z80_read8(cpu, cpu->registers.HL); NEXT;
+    OP(LD_L_A) cpu->registers.L = cpu->registers.A; NEXT;
+    OP(LD_HL_B) z80_write8(cpu, cpu->registers.HL, cpu->registers.B); NEXT;
+    OP(LD_HL_C) z80_write8(cpu, cpu->registers.HL, cpu->registers.C); NEXT;
+    OP(LD_HL_D) z80_write8(cpu, cpu->registers.HL, cpu->registers.D); NEXT;
+    OP(LD_HL_E) z80_write8(cpu, cpu->registers.HL, cpu->registers.E); NEXT;
+    OP(LD_HL_H) z80_write8(cpu, cpu->registers.HL, cpu->registers.H); NEXT;
+    OP(LD_HL_L) z80_write8(cpu, cpu->registers.HL, cpu->registers.L); NEXT;
+    OP(LD_HL_A) z80_write8(cpu, cpu->registers.HL, cpu->registers.A); NEXT;
+    OP(LD_A_B) cpu->registers.A = cpu->registers.B; NEXT;
+    OP(LD_A_C) cpu->registers.A = cpu->registers.C; NEXT;
+    OP(LD_A_D) cpu->registers.A = cpu->registers.D; NEXT;
+    OP(LD_A_E) cpu->registers.A = cpu->registers.E; NEXT;
+    OP(LD_A_H) cpu->registers.A = cpu->registers.H; NEXT;
+    OP(LD_A_L) cpu->registers.A = cpu->registers.L; NEXT;
+    OP(LD_A_HL) cpu->registers.A = z80_read8(cpu, cpu->registers.HL); NEXT;
+    OP(LD_A_A) cpu->registers.A = cpu->registers.A; NEXT;
     
     // === 8-BIT LOAD INSTRUCTIONS - Indirect ===
-    case LD_BC_A: z80_write8(cpu, cpu->registers.BC, cpu->registers.A); break;
-    case LD_DE_A: z80_write8(cpu, cpu->registers.DE, cpu->registers.A); break;
-    case LD_A_BC: cpu->registers.A = z80_read8(cpu, cpu->registers.BC); break;
-    case LD_A_DE: cpu->registers.A = z80_read8(cpu, cpu->registers.DE); break;
-    case LD_nn_A: z80_write8(cpu, z80_fetch16(cpu), cpu->registers.A); break;
-    case LD_A_nn: cpu->registers.A = z80_read8(cpu, z80_fetch16(cpu)); break;
+    OP(LD_BC_A) z80_write8(cpu, cpu->registers.BC, cpu->registers.A); NEXT;
+    OP(LD_DE_A) z80_write8(cpu, cpu->registers.DE, cpu->registers.A); NEXT;
+    OP(LD_A_BC) cpu->registers.A = z80_read8(cpu, cpu->registers.BC); NEXT;
+    OP(LD_A_DE) cpu->registers.A = z80_read8(cpu, cpu->registers.DE); NEXT;
+    OP(LD_nn_A) z80_write8(cpu, z80_fetch16(cpu), cpu->registers.A); NEXT;
+    OP(LD_A_nn) cpu->registers.A = z80_read8(cpu, z80_fetch16(cpu)); NEXT;
     
     // === 16-BIT LOAD INSTRUCTIONS ===
-    case LD_BC_nn: cpu->registers.BC = z80_fetch16(cpu); break;
-    case LD_DE_nn: cpu->registers.DE = z80_fetch16(cpu); break;
-    case LD_HL_nn: cpu->registers.HL = z80_fetch16(cpu); break;
-    case LD_SP_nn: cpu->registers.SP = z80_fetch16(cpu); break;
-    case LD_nn_HL: z80_write16(cpu, z80_fetch16(cpu), cpu->registers.HL); break;
-    case LD_HL_nn_ind: cpu->registers.HL = z80_read16(cpu, z80_fetch16(cpu)); break;
-    case LD_SP_HL: cpu->registers.SP = cpu->registers.HL; break;
+    OP(LD_BC_nn) cpu->registers.BC = z80_fetch16(cpu); NEXT;
+    OP(LD_DE_nn) cpu->registers.DE = z80_fetch16(cpu); NEXT;
+    OP(LD_HL_nn) cpu->registers.HL = z80_fetch16(cpu); NEXT;
+    OP(LD_SP_nn) cpu->registers.SP = z80_fetch16(cpu); NEXT;
+    OP(LD_nn_HL) z80_write16(cpu, z80_fetch16(cpu), cpu->registers.HL); NEXT;
+    OP(LD_HL_nn_ind) cpu->registers.HL = z80_read16(cpu, z80_fetch16(cpu)); NEXT;
+    OP(LD_SP_HL) cpu->registers.SP = cpu->registers.HL; NEXT;
     
     // === 8-BIT INCREMENT/DECREMENT ===
-    case INC_B: cpu->registers.B = z80_op_inc8(cpu, cpu->registers.B); break;
-    case INC_C: cpu->registers.C = z80_op_inc8(cpu, cpu->registers.C); break;
-    case INC_D: cpu->registers.D = z80_op_inc8(cpu, cpu->registers.D); break;
-    case INC_E: cpu->registers.E = z80_op_inc8(cpu, cpu->registers.E); break;
-    case INC_H: cpu->registers.H = z80_op_inc8(cpu, cpu->registers.H); break;
-    case INC_L: cpu->registers.L = z80_op_inc8(cpu, cpu->registers.L); break;
-    case INC_A: cpu->registers.A = z80_op_inc8(cpu, cpu->registers.A); break;
-    case INC_HL_:
+    OP(INC_B) cpu->registers.B = z80_op_inc8(cpu, cpu->registers.B); NEXT;
+    OP(INC_C) cpu->registers.C = z80_op_inc8(cpu, cpu->registers.C); NEXT;
+    OP(INC_D) cpu->registers.D = z80_op_inc8(cpu, cpu->registers.D); NEXT;
+    OP(INC_E) cpu->registers.E = z80_op_inc8(cpu, cpu->registers.E); NEXT;
+    OP(INC_H) cpu->registers.H = z80_op_inc8(cpu, cpu->registers.H); NEXT;
+    OP(INC_L) cpu->registers.L = z80_op_inc8(cpu, cpu->registers.L); NEXT;
+    OP(INC_A) cpu->registers.A = z80_op_inc8(cpu, cpu->registers.A); NEXT;
+    OP(INC_HL_)
         {
             uint8_t original = z80_read8(cpu, cpu->registers.HL);
             uint8_t result = z80_op_inc8(cpu, original);
-            cpu->cycle_count++;
             z80_write8(cpu, cpu->registers.HL, result);
         }
-        break;
-    case DEC_B: cpu->registers.B = z80_op_dec8(cpu, cpu->registers.B); break;
-    case DEC_C: cpu->registers.C = z80_op_dec8(cpu, cpu->registers.C); break;
-    case DEC_D: cpu->registers.D = z80_op_dec8(cpu, cpu->registers.D); break;
-    case DEC_E: cpu->registers.E = z80_op_dec8(cpu, cpu->registers.E); break;
-    case DEC_H: cpu->registers.H = z80_op_dec8(cpu, cpu->registers.H); break;
-    case DEC_L: cpu->registers.L = z80_op_dec8(cpu, cpu->registers.L); break;
-    case DEC_A: cpu->registers.A = z80_op_dec8(cpu, cpu->registers.A); break;
-    case DEC_HL_:
+        NEXT;
+    OP(DEC_B) cpu->registers.B = z80_op_dec8(cpu, cpu->registers.B); NEXT;
+    OP(DEC_C) cpu->registers.C = z80_op_dec8(cpu, cpu->registers.C); NEXT;
+    OP(DEC_D) cpu->registers.D = z80_op_dec8(cpu, cpu->registers.D); NEXT;
+    OP(DEC_E) cpu->registers.E = z80_op_dec8(cpu, cpu->registers.E); NEXT;
+    OP(DEC_H) cpu->registers.H = z80_op_dec8(cpu, cpu->registers.H); NEXT;
+    OP(DEC_L) cpu->registers.L = z80_op_dec8(cpu, cpu->registers.L); NEXT;
+    OP(DEC_A) cpu->registers.A = z80_op_dec8(cpu, cpu->registers.A); NEXT;
+    OP(DEC_HL_)
         {
             uint8_t original = z80_read8(cpu, cpu->registers.HL);
             uint8_t result = z80_op_dec8(cpu, original);
-            cpu->cycle_count++;
             z80_write8(cpu, cpu->registers.HL, result);
         }
-        break;
+        NEXT;
     
     // === 16-BIT INCREMENT/DECREMENT ===
-    case INC_BC:   cpu->cycle_count += 2; cpu->registers.BC++; break;
-    case INC_DE:   cpu->cycle_count += 2; cpu->registers.DE++; break;
-    case INC_HL:   cpu->cycle_count += 2; cpu->registers.HL++; break;
-    case INC_SP:   cpu->cycle_count += 2; cpu->registers.SP++; break;
-    case DEC_BC:   cpu->cycle_count += 2; cpu->registers.BC--; break;
-    case DEC_DE:   cpu->cycle_count += 2; cpu->registers.DE--; break;
-    case DEC_HL:   cpu->cycle_count += 2; cpu->registers.HL--; break;
-    case DEC_SP:   cpu->cycle_count += 2; cpu->registers.SP--; break;
+    OP(INC_BC)   cpu->registers.BC++; NEXT;
+    OP(INC_DE)   cpu->registers.DE++; NEXT;
+    OP(INC_HL)   cpu->registers.HL++; NEXT;
+    OP(INC_SP)   cpu->registers.SP++; NEXT;
+    OP(DEC_BC)   cpu->registers.BC--; NEXT;
+    OP(DEC_DE)   cpu->registers.DE--; NEXT;
+    OP(DEC_HL)   cpu->registers.HL--; NEXT;
+    OP(DEC_SP)   cpu->registers.SP--; NEXT;
     
     // === 8-BIT ARITHMETIC ===
-    case ADD_A_B:  z80_op_add8(cpu, cpu->registers.B); break;
-    case ADD_A_C:  z80_op_add8(cpu, cpu->registers.C); break;
-    case ADD_A_D:  z80_op_add8(cpu, cpu->registers.D); break;
-    case ADD_A_E:  z80_op_add8(cpu, cpu->registers.E); break;
-    case ADD_A_H:  z80_op_add8(cpu, cpu->registers.H); break;
-    case ADD_A_L:  z80_op_add8(cpu, cpu->registers.L); break;
-    case ADD_A_HL: z80_op_add8(cpu, z80_read8(cpu, cpu->registers.HL)); break;
-    case ADD_A_A:  z80_op_add8(cpu, cpu->registers.A); break;
-    case ADD_A_n:  z80_op_add8(cpu, z80_fetch8(cpu)); break;
-    case ADC_A_B:  z80_op_adc8(cpu, cpu->registers.B); break;
-    case ADC_A_C:  z80_op_adc8(cpu, cpu->registers.C); break;
-    case ADC_A_D:  z80_op_adc8(cpu, cpu->registers.D); break;
-    case ADC_A_E:  z80_op_adc8(cpu, cpu->registers.E); break;
-    case ADC_A_H:  z80_op_adc8(cpu, cpu->registers.H); break;
-    case ADC_A_L:  z80_op_adc8(cpu, cpu->registers.L); break;
-    case ADC_A_HL: z80_op_adc8(cpu, z80_read8(cpu, cpu->registers.HL)); break;
-    case ADC_A_A:  z80_op_adc8(cpu, cpu->registers.A); break;
-    case ADC_A_n:  z80_op_adc8(cpu, z80_fetch8(cpu)); break;
-    case SUB_B:    z80_op_sub8(cpu, cpu->registers.B); break;
-    case SUB_C:    z80_op_sub8(cpu, cpu->registers.C); break;
-    case SUB_D:    z80_op_sub8(cpu, cpu->registers.D); break;
-    case SUB_E:    z80_op_sub8(cpu, cpu->registers.E); break;
-    case SUB_H:    z80_op_sub8(cpu, cpu->registers.H); break;
-    case SUB_L:    z80_op_sub8(cpu, cpu->registers.L); break;
-    case SUB_HL:   z80_op_sub8(cpu, z80_read8(cpu, cpu->registers.HL)); break;
-    case SUB_A:    z80_op_sub8(cpu, cpu->registers.A); break;
-    case SUB_n:    z80_op_sub8(cpu, z80_fetch8(cpu)); break;
-    case SBC_A_B:  z80_op_sbc8(cpu, cpu->registers.B); break; 
-    case SBC_A_C:  z80_op_sbc8(cpu, cpu->registers.C);break; 
-    case SBC_A_D:  z80_op_sbc8(cpu, cpu->registers.D);break; 
-    case SBC_A_E:  z80_op_sbc8(cpu, cpu->registers.E);break; 
-    case SBC_A_H:  z80_op_sbc8(cpu, cpu->registers.H);break; 
-    case SBC_A_L:  z80_op_sbc8(cpu, cpu->registers.L);break; 
-    case SBC_A_HL: z80_op_sbc8(cpu, z80_read8(cpu, cpu->registers.HL));break; 
-    case SBC_A_A:  z80_op_sbc8(cpu, cpu->registers.A);break;
-    case SBC_A_n:  z80_op_sbc8(cpu, z80_fetch8(cpu)); break;
+    OP(ADD_A_B)  z80_op_add8(cpu, cpu->registers.B); NEXT;
+    OP(ADD_A_C)  z80_op_add8(cpu, cpu->registers.C); NEXT;
+    OP(ADD_A_D)  z80_op_add8(cpu, cpu->registers.D); NEXT;
+    OP(ADD_A_E)  z80_op_add8(cpu, cpu->registers.E); NEXT;
+    OP(ADD_A_H)  z80_op_add8(cpu, cpu->registers.H); NEXT;
+    OP(ADD_A_L)  z80_op_add8(cpu, cpu->registers.L); NEXT;
+    OP(ADD_A_HL) z80_op_add8(cpu, z80_read8(cpu, cpu->registers.HL)); NEXT;
+    OP(ADD_A_A)  z80_op_add8(cpu, cpu->registers.A); NEXT;
+    OP(ADD_A_n)  z80_op_add8(cpu, z80_fetch8(cpu)); NEXT;
+    OP(ADC_A_B)  z80_op_adc8(cpu, cpu->registers.B); NEXT;
+    OP(ADC_A_C)  z80_op_adc8(cpu, cpu->registers.C); NEXT;
+    OP(ADC_A_D)  z80_op_adc8(cpu, cpu->registers.D); NEXT;
+    OP(ADC_A_E)  z80_op_adc8(cpu, cpu->registers.E); NEXT;
+    OP(ADC_A_H)  z80_op_adc8(cpu, cpu->registers.H); NEXT;
+    OP(ADC_A_L)  z80_op_adc8(cpu, cpu->registers.L); NEXT;
+    OP(ADC_A_HL) z80_op_adc8(cpu, z80_read8(cpu, cpu->registers.HL)); NEXT;
+    OP(ADC_A_A)  z80_op_adc8(cpu, cpu->registers.A); NEXT;
+    OP(ADC_A_n)  z80_op_adc8(cpu, z80_fetch8(cpu)); NEXT;
+    OP(SUB_B)    z80_op_sub8(cpu, cpu->registers.B); NEXT;
+    OP(SUB_C)    z80_op_sub8(cpu, cpu->registers.C); NEXT;
+    OP(SUB_D)    z80_op_sub8(cpu, cpu->registers.D); NEXT;
+    OP(SUB_E)    z80_op_sub8(cpu, cpu->registers.E); NEXT;
+    OP(SUB_H)    z80_op_sub8(cpu, cpu->registers.H); NEXT;
+    OP(SUB_L)    z80_op_sub8(cpu, cpu->registers.L); NEXT;
+    OP(SUB_HL)   z80_op_sub8(cpu, z80_read8(cpu, cpu->registers.HL)); NEXT;
+    OP(SUB_A)    z80_op_sub8(cpu, cpu->registers.A); NEXT;
+    OP(SUB_n)    z80_op_sub8(cpu, z80_fetch8(cpu)); NEXT;
+    OP(SBC_A_B)  z80_op_sbc8(cpu, cpu->registers.B); NEXT; 
+    OP(SBC_A_C)  z80_op_sbc8(cpu, cpu->registers.C);NEXT; 
+    OP(SBC_A_D)  z80_op_sbc8(cpu, cpu->registers.D);NEXT; 
+    OP(SBC_A_E)  z80_op_sbc8(cpu, cpu->registers.E);NEXT; 
+    OP(SBC_A_H)  z80_op_sbc8(cpu, cpu->registers.H);NEXT; 
+    OP(SBC_A_L)  z80_op_sbc8(cpu, cpu->registers.L);NEXT; 
+    OP(SBC_A_HL) z80_op_sbc8(cpu, z80_read8(cpu, cpu->registers.HL));NEXT; 
+    OP(SBC_A_A)  z80_op_sbc8(cpu, cpu->registers.A);NEXT;
+    OP(SBC_A_n)  z80_op_sbc8(cpu, z80_fetch8(cpu)); NEXT;
     
     // === 16-BIT ARITHMETIC ===
-    case ADD_HL_BC: cpu->cycle_count += 7; cpu->registers.HL = z80_op_add16(cpu, cpu->registers.HL, cpu->registers.BC); break;
-    case ADD_HL_DE: cpu->cycle_count += 7; cpu->registers.HL = z80_op_add16(cpu, cpu->registers.HL, cpu->registers.DE); break;
-    case ADD_HL_HL: cpu->cycle_count += 7; cpu->registers.HL = z80_op_add16(cpu, cpu->registers.HL, cpu->registers.HL); break;
-    case ADD_HL_SP: cpu->cycle_count += 7; cpu->registers.HL = z80_op_add16(cpu, cpu->registers.HL, cpu->registers.SP); break;
+    OP(ADD_HL_BC) cpu->registers.HL = z80_op_add16(cpu, cpu->registers.HL, cpu->registers.BC); NEXT;
+    OP(ADD_HL_DE) cpu->registers.HL = z80_op_add16(cpu, cpu->registers.HL, cpu->registers.DE); NEXT;
+    OP(ADD_HL_HL) cpu->registers.HL = z80_op_add16(cpu, cpu->registers.HL, cpu->registers.HL); NEXT;
+    OP(ADD_HL_SP) cpu->registers.HL = z80_op_add16(cpu, cpu->registers.HL, cpu->registers.SP); NEXT;
     
     // === LOGICAL OPERATIONS ===
-    case AND_B: z80_op_and(cpu, cpu->registers.B); break;
-    case AND_C: z80_op_and(cpu, cpu->registers.C); break;
-    case AND_D: z80_op_and(cpu, cpu->registers.D); break;
-    case AND_E: z80_op_and(cpu, cpu->registers.E); break;
-    case AND_H: z80_op_and(cpu, cpu->registers.H); break;
-    case AND_L: z80_op_and(cpu, cpu->registers.L); break;
-    case AND_HL: z80_op_and(cpu, z80_read8(cpu, cpu->registers.HL)); break;
-    case AND_A: z80_op_and(cpu, cpu->registers.A); break;
-    case AND_n: z80_op_and(cpu, z80_fetch8(cpu)); break;
-    case XOR_B: z80_op_xor(cpu, cpu->registers.B); break;
-    case XOR_C: z80_op_xor(cpu, cpu->registers.C); break;
-    case XOR_D: z80_op_xor(cpu, cpu->registers.D); break;
-    case XOR_E: z80_op_xor(cpu, cpu->registers.E); break;
-    case XOR_H: z80_op_xor(cpu, cpu->registers.H); break;
-    case XOR_L: z80_op_xor(cpu, cpu->registers.L); break;
-    case XOR_HL: z80_op_xor(cpu, z80_read8(cpu, cpu->registers.HL)); break;
-    case XOR_A: z80_op_xor(cpu, cpu->registers.A); break;
-    case XOR_n: z80_op_xor(cpu, z80_fetch8(cpu)); break;
-    case OR_B: z80_op_or(cpu, cpu->registers.B); break;
-    case OR_C: z80_op_or(cpu, cpu->registers.C); break;
-    case OR_D: z80_op_or(cpu, cpu->registers.D); break;
-    case OR_E: z80_op_or(cpu, cpu->registers.E); break;
-    case OR_H: z80_op_or(cpu, cpu->registers.H); break;
-    case OR_L: z80_op_or(cpu, cpu->registers.L); break;
-    case OR_HL: z80_op_or(cpu, z80_read8(cpu, cpu->registers.HL)); break;
-    case OR_A: z80_op_or(cpu, cpu->registers.A); break;
-    case OR_n: z80_op_or(cpu, z80_fetch8(cpu)); break;
+    OP(AND_B) z80_op_and(cpu, cpu->registers.B); NEXT;
+    OP(AND_C) z80_op_and(cpu, cpu->registers.C); NEXT;
+    OP(AND_D) z80_op_and(cpu, cpu->registers.D); NEXT;
+    OP(AND_E) z80_op_and(cpu, cpu->registers.E); NEXT;
+    OP(AND_H) z80_op_and(cpu, cpu->registers.H); NEXT;
+    OP(AND_L) z80_op_and(cpu, cpu->registers.L); NEXT;
+    OP(AND_HL) z80_op_and(cpu, z80_read8(cpu, cpu->registers.HL)); NEXT;
+    OP(AND_A) z80_op_and(cpu, cpu->registers.A); NEXT;
+    OP(AND_n) z80_op_and(cpu, z80_fetch8(cpu)); NEXT;
+    OP(XOR_B) z80_op_xor(cpu, cpu->registers.B); NEXT;
+    OP(XOR_C) z80_op_xor(cpu, cpu->registers.C); NEXT;
+    OP(XOR_D) z80_op_xor(cpu, cpu->registers.D); NEXT;
+    OP(XOR_E) z80_op_xor(cpu, cpu->registers.E); NEXT;
+    OP(XOR_H) z80_op_xor(cpu, cpu->registers.H); NEXT;
+    OP(XOR_L) z80_op_xor(cpu, cpu->registers.L); NEXT;
+    OP(XOR_HL) z80_op_xor(cpu, z80_read8(cpu, cpu->registers.HL)); NEXT;
+    OP(XOR_A) z80_op_xor(cpu, cpu->registers.A); NEXT;
+    OP(XOR_n) z80_op_xor(cpu, z80_fetch8(cpu)); NEXT;
+    OP(OR_B) z80_op_or(cpu, cpu->registers.B); NEXT;
+    OP(OR_C) z80_op_or(cpu, cpu->registers.C); NEXT;
+    OP(OR_D) z80_op_or(cpu, cpu->registers.D); NEXT;
+    OP(OR_E) z80_op_or(cpu, cpu->registers.E); NEXT;
+    OP(OR_H) z80_op_or(cpu, cpu->registers.H); NEXT;
+    OP(OR_L) z80_op_or(cpu, cpu->registers.L); NEXT;
+    OP(OR_HL) z80_op_or(cpu, z80_read8(cpu, cpu->registers.HL)); NEXT;
+    OP(OR_A) z80_op_or(cpu, cpu->registers.A); NEXT;
+    OP(OR_n) z80_op_or(cpu, z80_fetch8(cpu)); NEXT;
     // === COMPARE OPERATIONS ===
-    case CP_B: z80_op_cp(cpu, cpu->registers.A, cpu->registers.B); break;
-    case CP_C: z80_op_cp(cpu, cpu->registers.A, cpu->registers.C); break;
-    case CP_D: z80_op_cp(cpu, cpu->registers.A, cpu->registers.D); break;
-    case CP_E: z80_op_cp(cpu, cpu->registers.A, cpu->registers.E); break;
-    case CP_H: z80_op_cp(cpu, cpu->registers.A, cpu->registers.H); break;
-    case CP_L: z80_op_cp(cpu, cpu->registers.A, cpu->registers.L); break;
-    case CP_HL: z80_op_cp(cpu, cpu->registers.A, z80_read8(cpu, cpu->registers.HL)); break;
-    case CP_A: z80_op_cp(cpu, cpu->registers.A, cpu->registers.A); break;
-    case CP_n: z80_op_cp(cpu, cpu->registers.A, z80_fetch8(cpu)); break;
+    OP(CP_B) z80_op_cp(cpu, cpu->registers.A, cpu->registers.B); NEXT;
+    OP(CP_C) z80_op_cp(cpu, cpu->registers.A, cpu->registers.C); NEXT;
+    OP(CP_D) z80_op_cp(cpu, cpu->registers.A, cpu->registers.D); NEXT;
+    OP(CP_E) z80_op_cp(cpu, cpu->registers.A, cpu->registers.E); NEXT;
+    OP(CP_H) z80_op_cp(cpu, cpu->registers.A, cpu->registers.H); NEXT;
+    OP(CP_L) z80_op_cp(cpu, cpu->registers.A, cpu->registers.L); NEXT;
+    OP(CP_HL) z80_op_cp(cpu, cpu->registers.A, z80_read8(cpu, cpu->registers.HL)); NEXT;
+    OP(CP_A) z80_op_cp(cpu, cpu->registers.A, cpu->registers.A); NEXT;
+    OP(CP_n) z80_op_cp(cpu, cpu->registers.A, z80_fetch8(cpu)); NEXT;
     
     // === ROTATE AND SHIFT OPERATIONS ===
-    case RLCA: cpu->registers.A = set_flags_rlca(cpu); break;
-    case RRCA: cpu->registers.A = set_flags_rrca(cpu); break;
-    case RRA: cpu->registers.A = set_flags_rra(cpu); break;
-    case RLA: cpu->registers.A = set_flags_rla(cpu); break;
+    OP(RLCA) cpu->registers.A = set_flags_rlca(cpu); NEXT;
+    OP(RRCA) cpu->registers.A = set_flags_rrca(cpu); NEXT;
+    OP(RRA) cpu->registers.A = set_flags_rra(cpu); NEXT;
+    OP(RLA) cpu->registers.A = set_flags_rla(cpu); NEXT;
 
     // === JUMP INSTRUCTIONS ===
-    case JP_nn:    z80_op_jp(cpu, true);             break;
-    case JP_NZ_nn: z80_op_jp(cpu, IS_Z_UNSET(cpu));  break;
-    case JP_Z_nn:  z80_op_jp(cpu, IS_Z_SET(cpu));    break;
-    case JP_NC_nn: z80_op_jp(cpu, IS_C_UNSET(cpu));  break;
-    case JP_C_nn:  z80_op_jp(cpu, IS_C_SET(cpu));    break;
-    case JP_PO_nn: z80_op_jp(cpu, IS_PV_UNSET(cpu)); break;
-    case JP_PE_nn: z80_op_jp(cpu, IS_PV_SET(cpu));   break;
-    case JP_P_nn:  z80_op_jp(cpu, IS_S_UNSET(cpu));  break;
-    case JP_M_nn:  z80_op_jp(cpu, IS_S_SET(cpu));    break;
-    case JP_HL: cpu->registers.PC = cpu->registers.HL;  break;
-    case JR_d:    z80_op_jr(cpu, true);             break;
-    case JR_NZ_d: z80_op_jr(cpu, IS_Z_UNSET(cpu));  break;
-    case JR_Z_d:  z80_op_jr(cpu, IS_Z_SET(cpu));    break;
-    case JR_NC_d: z80_op_jr(cpu, IS_C_UNSET(cpu));  break;
-    case JR_C_d:  z80_op_jr(cpu, IS_C_SET(cpu));    break;
-    case DJNZ_e:
+    OP(JP_nn)    z80_op_jp(cpu, true);             NEXT;
+    OP(JP_NZ_nn) z80_op_jp(cpu, IS_Z_UNSET(cpu));  NEXT;
+    OP(JP_Z_nn)  z80_op_jp(cpu, IS_Z_SET(cpu));    NEXT;
+    OP(JP_NC_nn) z80_op_jp(cpu, IS_C_UNSET(cpu));  NEXT;
+    OP(JP_C_nn)  z80_op_jp(cpu, IS_C_SET(cpu));    NEXT;
+    OP(JP_PO_nn) z80_op_jp(cpu, IS_PV_UNSET(cpu)); NEXT;
+    OP(JP_PE_nn) z80_op_jp(cpu, IS_PV_SET(cpu));   NEXT;
+    OP(JP_P_nn)  z80_op_jp(cpu, IS_S_UNSET(cpu));  NEXT;
+    OP(JP_M_nn)  z80_op_jp(cpu, IS_S_SET(cpu));    NEXT;
+    OP(JP_HL) cpu->registers.PC = cpu->registers.HL;  NEXT;
+    OP(JR_d)    z80_op_jr(cpu, true);             NEXT;
+    OP(JR_NZ_d) z80_op_jr(cpu, IS_Z_UNSET(cpu));  NEXT;
+    OP(JR_Z_d)  z80_op_jr(cpu, IS_Z_SET(cpu));    NEXT;
+    OP(JR_NC_d) z80_op_jr(cpu, IS_C_UNSET(cpu));  NEXT;
+    OP(JR_C_d)  z80_op_jr(cpu, IS_C_SET(cpu));    NEXT;
+    OP(DJNZ_e)
         {
             int8_t offset = (int8_t)z80_fetch8(cpu);
             cpu->registers.B--;
-            cpu->cycle_count += 5; // Base cycles
             if (cpu->registers.B != 0) {
                 cpu->registers.PC += offset;
-                cpu->cycle_count += 3; // Additional cycles for taken branch
+                cpu->cycle_count += Z80_TIMING_JR_TAKEN;
             }
         }
-        break;
+        NEXT;
     
     // === CALL INSTRUCTIONS ===
-    case CALL_nn:    z80_op_call(cpu, true); break;
-    case CALL_Z_nn:  z80_op_call(cpu, IS_Z_SET(cpu)); break;
-    case CALL_NZ_nn: z80_op_call(cpu, IS_Z_UNSET(cpu)); break;
-    case CALL_C_nn:  z80_op_call(cpu, IS_C_SET(cpu)); break;
-    case CALL_NC_nn: z80_op_call(cpu, IS_C_UNSET(cpu)); break;
+    OP(CALL_nn)    z80_op_call(cpu, true); NEXT;
+    OP(CALL_Z_nn)  z80_op_call(cpu, IS_Z_SET(cpu)); NEXT;
+    OP(CALL_NZ_nn) z80_op_call(cpu, IS_Z_UNSET(cpu)); NEXT;
+    OP(CALL_C_nn)  z80_op_call(cpu, IS_C_SET(cpu)); NEXT;
+    OP(CALL_NC_nn) z80_op_call(cpu, IS_C_UNSET(cpu)); NEXT;
     
     // === RETURN INSTRUCTIONS ===
-    case RET:    z80_op_ret(cpu, true); break;
-    case RET_Z:  z80_op_ret(cpu, IS_Z_SET(cpu)); break;
-    case RET_NZ: z80_op_ret(cpu, IS_Z_UNSET(cpu)); break;
-    case RET_PE: z80_op_ret(cpu, IS_PV_SET(cpu)); break;
-    case RET_PO: z80_op_ret(cpu, IS_PV_UNSET(cpu)); break;
-    case RET_C:  z80_op_ret(cpu, IS_C_SET(cpu)); break;
-    case RET_NC: z80_op_ret(cpu, IS_C_UNSET(cpu)); break;
-    case RET_M:  z80_op_ret(cpu, IS_S_SET(cpu)); break;
-    case RET_P:  z80_op_ret(cpu, IS_S_UNSET(cpu)); break;
+    OP(RET)    z80_op_ret(cpu, true); NEXT;
+    OP(RET_Z)  z80_op_ret(cpu, IS_Z_SET(cpu)); NEXT;
+    OP(RET_NZ) z80_op_ret(cpu, IS_Z_UNSET(cpu)); NEXT;
+    OP(RET_PE) z80_op_ret(cpu, IS_PV_SET(cpu)); NEXT;
+    OP(RET_PO) z80_op_ret(cpu, IS_PV_UNSET(cpu)); NEXT;
+    OP(RET_C)  z80_op_ret(cpu, IS_C_SET(cpu)); NEXT;
+    OP(RET_NC) z80_op_ret(cpu, IS_C_UNSET(cpu)); NEXT;
+    OP(RET_M)  z80_op_ret(cpu, IS_S_SET(cpu)); NEXT;
+    OP(RET_P)  z80_op_ret(cpu, IS_S_UNSET(cpu)); NEXT;
 
     // === STACK OPERATIONS ===
-    case POP_BC: cpu->registers.BC = z80_stack_pop16(cpu); break;
-    case POP_DE: cpu->registers.DE = z80_stack_pop16(cpu); break;
-    case POP_HL: cpu->registers.HL = z80_stack_pop16(cpu); break;
-    case POP_AF: cpu->registers.AF = z80_stack_pop16(cpu); break;
-    case PUSH_BC: z80_stack_push16(cpu, cpu->registers.BC); cpu->cycle_count++; break;
-    case PUSH_DE: z80_stack_push16(cpu, cpu->registers.DE); cpu->cycle_count++; break;
-    case PUSH_HL: z80_stack_push16(cpu, cpu->registers.HL); cpu->cycle_count++; break;
-    case PUSH_AF: z80_stack_push16(cpu, cpu->registers.AF); cpu->cycle_count++; break;
+    OP(POP_BC) cpu->registers.BC = z80_stack_pop16(cpu); NEXT;
+    OP(POP_DE) cpu->registers.DE = z80_stack_pop16(cpu); NEXT;
+    OP(POP_HL) cpu->registers.HL = z80_stack_pop16(cpu); NEXT;
+    OP(POP_AF) cpu->registers.AF = z80_stack_pop16(cpu); z80_flags_written(cpu); NEXT;
+    OP(PUSH_BC) z80_stack_push16(cpu, cpu->registers.BC); NEXT;
+    OP(PUSH_DE) z80_stack_push16(cpu, cpu->registers.DE); NEXT;
+    OP(PUSH_HL) z80_stack_push16(cpu, cpu->registers.HL); NEXT;
+    OP(PUSH_AF) z80_sync_flags(cpu); z80_stack_push16(cpu, cpu->registers.AF); NEXT;
 
-    case RST_00: z80_op_rst(cpu, 0x0000); break;
-    case RST_08: z80_op_rst(cpu, 0x0008); break;
-    case RST_10: z80_op_rst(cpu, 0x0010); break;
-    case RST_18: z80_op_rst(cpu, 0x0018); break;
-    case RST_20: z80_op_rst(cpu, 0x0020); break;
-    case RST_28: z80_op_rst(cpu, 0x0028); break;
-    case RST_30: z80_op_rst(cpu, 0x0030); break;
-    case RST_38: z80_op_rst(cpu, 0x0038); break;
+    OP(RST_00) z80_op_rst(cpu, 0x0000); NEXT;
+    OP(RST_08) z80_op_rst(cpu, 0x0008); NEXT;
+    OP(RST_10) z80_op_rst(cpu, 0x0010); NEXT;
+    OP(RST_18) z80_op_rst(cpu, 0x0018); NEXT;
+    OP(RST_20) z80_op_rst(cpu, 0x0020); NEXT;
+    OP(RST_28) z80_op_rst(cpu, 0x0028); NEXT;
+    OP(RST_30) z80_op_rst(cpu, 0x0030); NEXT;
+    OP(RST_38) z80_op_rst(cpu, 0x0038); NEXT;
     
     // === EXCHANGE INSTRUCTIONS ===
-    case EX_AF_AF:
+    OP(EX_AF_AF)
         {
+            z80_sync_flags(cpu);
             uint16_t temp = cpu->registers._AF;
             cpu->registers._AF = cpu->registers.AF;
             cpu->registers.AF = temp;
         }
-        break;
-    case EXX:
+        NEXT;
+    OP(EXX)
         {
             uint16_t temp = cpu->registers._BC;
             cpu->registers._BC = cpu->registers.BC;
@@ -454,43 +563,55 @@ void z80_execute_instruction(struct z80_t *cpu, uint8_t opcode)
             cpu->registers._HL = cpu->registers.HL;
             cpu->registers.HL = temp;
         }
-        break;
-    case EX_DE_HL:
+        NEXT;
+    OP(EX_DE_HL)
         {
             uint16_t temp = cpu->registers.DE;
             cpu->registers.DE = cpu->registers.HL;
             cpu->registers.HL = temp;
-            cpu->cycle_count += 3;
         }
-        break;
+        NEXT;
     
-    case DAA: cpu->registers.A = set_flags_daa(cpu); break;
-    case CPL: cpu->registers.A = set_flags_cpl(cpu); break;
-    case SCF: set_flags_scf(cpu); break;
-    case CCF: set_flags_ccf(cpu); break;
+    OP(DAA) cpu->registers.A = set_flags_daa(cpu); NEXT;
+    OP(CPL) cpu->registers.A = set_flags_cpl(cpu); NEXT;
+    OP(SCF) set_flags_scf(cpu); NEXT;
+    OP(CCF) set_flags_ccf(cpu); NEXT;
 
-    case IN_A_n:
+    OP(IN_A_n)
     {
         uint8_t port = z80_fetch8(cpu);
         cpu->registers.A = z80_port_in(cpu, port);
-        break;
+        NEXT;
     }
-    case OUT_n_A:
+    OP(OUT_n_A)
     {
         uint8_t port = z80_fetch8(cpu);
         z80_port_out(cpu, port, cpu->registers.A);
-        break;
+        NEXT;
     }
     
     // === PREFIX INSTRUCTIONS ===
-    case DD_PREFIX: z80_execute_dd_instruction(cpu, z80_fetch8(cpu)); break;
-    case ED_PREFIX: z80_execute_ed_instruction(cpu, z80_fetch8(cpu)); break;
-    case FD_PREFIX: z80_execute_fd_instruction(cpu, z80_fetch8(cpu)); break;
-    case CB_PREFIX: z80_execute_cb_instruction(cpu, z80_fetch8(cpu)); break;
-    default:
+    OP(DD_PREFIX) z80_execute_dd_instruction(cpu, z80_fetch8(cpu)); NEXT;
+    OP(ED_PREFIX) z80_execute_ed_instruction(cpu, z80_fetch8(cpu)); NEXT;
+    OP(FD_PREFIX) z80_execute_fd_instruction(cpu, z80_fetch8(cpu)); NEXT;
+    OP(CB_PREFIX) z80_execute_cb_instruction(cpu, z80_fetch8(cpu)); NEXT;
+    OP_DEFAULT
         // printf("Unimplemented Instruction: 0x%02X at PC: 0x%04X\n", opcode, cpu->registers.PC - 1);
         cpu->running = false;
         cpu->halted = true;
-        break;
+        NEXT;
     }
-}
\ No newline at end of file
+}
+
+#if Z80_COMPUTED_GOTO
+void z80_execute_instruction(struct z80_t *cpu, uint8_t opcode)
+{
+    z80_execute_threaded(cpu, opcode, Z80_SINGLE_STEP);
+}
+
+void z80_run_threaded(struct z80_t *cpu, uint64_t deadline)
+{
+    cpu->cycle_count = 0;
+    z80_execute_threaded(cpu, z80_fetch_opcode(cpu), deadline);
+}
+#endif
@@ -0,0 +1,92 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "z80_stats.h"
+
+static const char *const page_prefix[Z80_STATS_PAGES] =
+{
+    "", "CB", "ED", "DD", "FD", "DD CB", "FD CB",
+};
+
+struct z80_opcode_stats *z80_stats_create(void)
+{
+    struct z80_opcode_stats *stats = calloc(1, sizeof(*stats));
+    if (!stats)
+    {
+        printf("Failed to allocate the opcode histogram\n");
+    }
+    return stats;
+}
+
+void z80_stats_destroy(struct z80_opcode_stats *stats)
+{
+    free(stats);
+}
+
+void z80_stats_reset(struct z80_opcode_stats *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+}
+
+// Prefix bytes in front of the opcodes of a page, "" for unprefixed
+const char *z80_stats_prefix(enum z80_stats_page page)
+{
+    return page < Z80_STATS_PAGES ? page_prefix[page] : "";
+}
+
+// Fill entries with the up to max most frequent (or most expensive) entries,
+// largest first. Returns how many were found.
+int z80_stats_top(const struct z80_opcode_stats *stats, bool by_cycles, uint16_t *entries, int max)
+{
+    const uint64_t *value = by_cycles ? stats->cycles : stats->count;
+    int found = 0;
+
+    for (int i = 0; i < Z80_STATS_ENTRIES; i++)
+    {
+        if (value[i] == 0 || (found == max && value[i] <= value[entries[max - 1]]))
+            continue;
+
+        int slot = found < max ? found++ : max - 1;
+        while (slot > 0 && value[entries[slot - 1]] < value[i])
+        {
+            entries[slot] = entries[slot - 1];
+            slot--;
+        }
+        entries[slot] = (uint16_t)i;
+    }
+    return found;
+}
+
+// One line per opcode that ran, in page and opcode order
+bool z80_stats_dump_csv(const struct z80_opcode_stats *stats, const char *path)
+{
+    FILE *file = fopen(path, "w");
+    if (!file)
+    {
+        printf("Failed to open %s for writing\n", path);
+        return false;
+    }
+
+    fprintf(file, "prefix,opcode,count,cycles\n");
+    for (int i = 0; i < Z80_STATS_ENTRIES; i++)
+    {
+        if (stats->count[i])
+        {
+            fprintf(file, "%s,%02X,%llu,%llu\n", page_prefix[i >> 8], i & 0xFF,
+                    (unsigned long long)stats->count[i], (unsigned long long)stats->cycles[i]);
+        }
+    }
+
+    bool ok = !ferror(file);
+    if (fclose(file) != 0)
+    {
+        ok = false;
+    }
+    if (!ok)
+    {
+        printf("Failed to write %s\n", path);
+        return false;
+    }
+    printf("Wrote opcode histogram to %s\n", path);
+    return true;
+}
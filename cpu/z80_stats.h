@@ -0,0 +1,75 @@
+#ifndef Z80_STATS_H_
+#define Z80_STATS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "z80.h"
+
+// Opcode histogram: how often each opcode of each executor ran and the
+// T-states it took. The counting hooks are only compiled in with
+// Z80_OPCODE_STATS and only count while cpu->stats is set, which makes
+// z80_run_until() take the debug loop so the threaded, block and JIT paths
+// stay free of them.
+#ifndef Z80_OPCODE_STATS
+#define Z80_OPCODE_STATS 0
+#endif
+
+enum z80_stats_page
+{
+    Z80_STATS_BASE,
+    Z80_STATS_CB,
+    Z80_STATS_ED,
+    Z80_STATS_DD,
+    Z80_STATS_FD,
+    Z80_STATS_DDCB,
+    Z80_STATS_FDCB,
+    Z80_STATS_PAGES
+};
+
+#define Z80_STATS_ENTRIES (Z80_STATS_PAGES * 256)
+
+// Indexed by page << 8 | opcode. A prefixed instruction counts once for
+// each prefix in the page it appears in and once for its final opcode,
+// which is charged the T-states of the whole instruction.
+struct z80_opcode_stats
+{
+    uint64_t count[Z80_STATS_ENTRIES];
+    uint64_t cycles[Z80_STATS_ENTRIES];
+    uint16_t last;         // entry the running instruction is charged to
+};
+
+struct z80_opcode_stats *z80_stats_create(void);
+void z80_stats_destroy(struct z80_opcode_stats *stats);
+void z80_stats_reset(struct z80_opcode_stats *stats);
+const char *z80_stats_prefix(enum z80_stats_page page);
+int z80_stats_top(const struct z80_opcode_stats *stats, bool by_cycles, uint16_t *entries, int max);
+bool z80_stats_dump_csv(const struct z80_opcode_stats *stats, const char *path);
+
+#if Z80_OPCODE_STATS
+// An executor dispatching opcode
+static inline void z80_stats_count(struct z80_t *cpu, enum z80_stats_page page, uint8_t opcode)
+{
+    struct z80_opcode_stats *stats = cpu->stats;
+    if (stats)
+    {
+        stats->last = (uint16_t)(page << 8 | opcode);
+        stats->count[stats->last]++;
+    }
+}
+
+// The instruction finished, cycle_count holds its T-states
+static inline void z80_stats_retire(struct z80_t *cpu)
+{
+    struct z80_opcode_stats *stats = cpu->stats;
+    if (stats)
+    {
+        stats->cycles[stats->last] += cpu->cycle_count;
+    }
+}
+#else
+#define z80_stats_count(cpu, page, opcode) ((void)(cpu), (void)(page), (void)(opcode))
+#define z80_stats_retire(cpu)              ((void)(cpu))
+#endif
+
+#endif
@@ -1,5 +1,7 @@
 #include "z80_test.h"
 #include "z80_flags.h"
+#include "z80_block.h"
+#include "../mmu/mmu.h"
 
 // Global test statistics
 static int tests_run = 0;
@@ -25,6 +27,13 @@ void check_dec_hl_indirect(test_context_t *ctx)
     z80_test_expect_memory_byte(ctx, 0x1000, 0x54);
 }
 
+// Puts SBC HL,BC (ED 42) at 0x0000, for the tests of it.
+void setup_sbc_hl_bc(test_context_t *ctx)
+{
+    z80_test_set_memory_byte(ctx, 0x0000, 0xED);
+    z80_test_set_memory_byte(ctx, 0x0001, 0x42);
+}
+
 // Memory interface functions for testing
 static uint8_t test_read8(void *context, uint16_t addr)
 {
@@ -80,6 +89,7 @@ void z80_test_init(test_context_t *ctx, const char *test_name)
     ctx->cpu.io_read8 = test_io_read8;
     ctx->cpu.io_write8 = test_io_write8;
     ctx->cpu.memory_ctx = ctx;
+    ctx->cpu.io_ctx = ctx;
 
     // Initialize memory and I/O ports
     memset(ctx->memory, 0, sizeof(ctx->memory));
@@ -410,6 +420,11 @@ void z80_test_print_summary(void)
     printf("Success rate: %.1f%%\n", tests_run > 0 ? (100.0 * tests_passed / tests_run) : 0.0);
 }
 
+int z80_test_failures(void)
+{
+    return tests_failed;
+}
+
 // Helper function to create register state
 struct registers z80_test_make_registers(uint16_t pc, uint16_t sp, uint8_t a, uint8_t f,
                                          uint8_t b, uint8_t c, uint8_t d, uint8_t e,
@@ -465,7 +480,7 @@ void z80_test_inc_a(void) {
 // Test INC A with zero flag
 void z80_test_inc_a_zero(void) {
     struct registers initial = z80_test_make_registers(0x0000, 0xFFFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00);
-    struct registers expected = z80_test_make_registers(0x0001, 0xFFFF, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00); // Corrected expected flags (Z=1, H=1, PV=0)
+    struct registers expected = z80_test_make_registers(0x0001, 0xFFFF, 0x00, 0x50, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00); // Corrected expected flags (Z=1, H=1, PV=0)
     z80_perform_test("INC A (zero flag)", 0x3C, &initial, &expected, NULL, NULL);
 }
 
@@ -534,7 +549,7 @@ void z80_test_sbc_a_b_simple(void) {
 
 void z80_test_sbc_a_b_with_carry(void) {
     struct registers initial = z80_test_make_registers(0x0000, 0xFFFF, 0x40, 0x01, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00); // A=0x40, B=0x10, C=1
-    struct registers expected = z80_test_make_registers(0x0001, 0xFFFF, 0x2F, 0x02, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00); // A=0x2F, F=N
+    struct registers expected = z80_test_make_registers(0x0001, 0xFFFF, 0x2F, 0x12, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00); // A=0x2F, F=H,N
     z80_perform_test("SBC A, B (with carry)", 0x98, &initial, &expected, NULL, NULL);
 }
 
@@ -546,7 +561,7 @@ void z80_test_sbc_a_b_borrow(void) {
 
 void z80_test_sbc_a_b_borrow_with_carry(void) {
     struct registers initial = z80_test_make_registers(0x0000, 0xFFFF, 0x10, 0x01, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00); // A=0x10, B=0x40, C=1
-    struct registers expected = z80_test_make_registers(0x0001, 0xFFFF, 0xCF, 0x83, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00); // A=0xCF, F=S,N,C
+    struct registers expected = z80_test_make_registers(0x0001, 0xFFFF, 0xCF, 0x93, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00); // A=0xCF, F=S,H,N,C
     z80_perform_test("SBC A, B (borrow with carry)", 0x98, &initial, &expected, NULL, NULL);
 }
 
@@ -564,7 +579,7 @@ void z80_test_sbc_a_b_half_borrow(void) {
 
 void z80_test_sbc_a_b_overflow(void) {
     struct registers initial = z80_test_make_registers(0x0000, 0xFFFF, 0x80, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00); // A=-128, B=1, C=0
-    struct registers expected = z80_test_make_registers(0x0001, 0xFFFF, 0x7F, 0x06, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00); // A=127, F=P/V,N
+    struct registers expected = z80_test_make_registers(0x0001, 0xFFFF, 0x7F, 0x16, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00); // A=127, F=H,P/V,N
     z80_perform_test("SBC A, B (overflow)", 0x98, &initial, &expected, NULL, NULL);
 }
 
@@ -572,37 +587,37 @@ void z80_test_sbc_a_b_overflow(void) {
 void z80_test_sbc_hl_bc_simple(void) {
     struct registers initial = z80_test_make_registers(0x0000, 0xFFFF, 0x00, 0x00, 0x12, 0x34, 0x00, 0x00, 0x45, 0x67); // HL=0x4567, BC=0x1234, C=0
     struct registers expected = z80_test_make_registers(0x0002, 0xFFFF, 0x00, 0x02, 0x12, 0x34, 0x00, 0x00, 0x33, 0x33); // HL=0x3333, F=N
-    z80_perform_test("SBC HL, BC (simple)", 0xED42, &initial, &expected, NULL, NULL);
+    z80_perform_test("SBC HL, BC (simple)", 0xED, &initial, &expected, setup_sbc_hl_bc, NULL);
 }
 
 void z80_test_sbc_hl_bc_with_carry(void) {
     struct registers initial = z80_test_make_registers(0x0000, 0xFFFF, 0x00, 0x01, 0x12, 0x34, 0x00, 0x00, 0x45, 0x67); // HL=0x4567, BC=0x1234, C=1
     struct registers expected = z80_test_make_registers(0x0002, 0xFFFF, 0x00, 0x02, 0x12, 0x34, 0x00, 0x00, 0x33, 0x32); // HL=0x3332, F=N
-    z80_perform_test("SBC HL, BC (with carry)", 0xED42, &initial, &expected, NULL, NULL);
+    z80_perform_test("SBC HL, BC (with carry)", 0xED, &initial, &expected, setup_sbc_hl_bc, NULL);
 }
 
 void z80_test_sbc_hl_bc_borrow(void) {
     struct registers initial = z80_test_make_registers(0x0000, 0xFFFF, 0x00, 0x00, 0x45, 0x67, 0x00, 0x00, 0x12, 0x34); // HL=0x1234, BC=0x4567, C=0
-    struct registers expected = z80_test_make_registers(0x0002, 0xFFFF, 0x00, 0x83, 0x45, 0x67, 0x00, 0x00, 0xCC, 0xCD); // HL=0xCCCD, F=S,N,C
-    z80_perform_test("SBC HL, BC (borrow)", 0xED42, &initial, &expected, NULL, NULL);
+    struct registers expected = z80_test_make_registers(0x0002, 0xFFFF, 0x00, 0x93, 0x45, 0x67, 0x00, 0x00, 0xCC, 0xCD); // HL=0xCCCD, F=S,H,N,C
+    z80_perform_test("SBC HL, BC (borrow)", 0xED, &initial, &expected, setup_sbc_hl_bc, NULL);
 }
 
 void z80_test_sbc_hl_bc_zero(void) {
     struct registers initial = z80_test_make_registers(0x0000, 0xFFFF, 0x00, 0x00, 0x12, 0x34, 0x00, 0x00, 0x12, 0x34); // HL=0x1234, BC=0x1234, C=0
     struct registers expected = z80_test_make_registers(0x0002, 0xFFFF, 0x00, 0x42, 0x12, 0x34, 0x00, 0x00, 0x00, 0x00); // HL=0x0000, F=Z,N
-    z80_perform_test("SBC HL, BC (zero)", 0xED42, &initial, &expected, NULL, NULL);
+    z80_perform_test("SBC HL, BC (zero)", 0xED, &initial, &expected, setup_sbc_hl_bc, NULL);
 }
 
 void z80_test_sbc_hl_bc_half_borrow(void) {
     struct registers initial = z80_test_make_registers(0x0000, 0xFFFF, 0x00, 0x00, 0x0F, 0xFF, 0x00, 0x00, 0x40, 0x00); // HL=0x4000, BC=0x0FFF, C=0
     struct registers expected = z80_test_make_registers(0x0002, 0xFFFF, 0x00, 0x12, 0x0F, 0xFF, 0x00, 0x00, 0x30, 0x01); // HL=0x3001, F=H,N
-    z80_perform_test("SBC HL, BC (half borrow)", 0xED42, &initial, &expected, NULL, NULL);
+    z80_perform_test("SBC HL, BC (half borrow)", 0xED, &initial, &expected, setup_sbc_hl_bc, NULL);
 }
 
 void z80_test_sbc_hl_bc_overflow(void) {
     struct registers initial = z80_test_make_registers(0x0000, 0xFFFF, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x80, 0x00); // HL=0x8000, BC=0x0001, C=0
-    struct registers expected = z80_test_make_registers(0x0002, 0xFFFF, 0x00, 0x06, 0x00, 0x01, 0x00, 0x00, 0x7F, 0xFF); // HL=0x7FFF, F=P/V,N
-    z80_perform_test("SBC HL, BC (overflow)", 0xED42, &initial, &expected, NULL, NULL);
+    struct registers expected = z80_test_make_registers(0x0002, 0xFFFF, 0x00, 0x16, 0x00, 0x01, 0x00, 0x00, 0x7F, 0xFF); // HL=0x7FFF, F=H,P/V,N
+    z80_perform_test("SBC HL, BC (overflow)", 0xED, &initial, &expected, setup_sbc_hl_bc, NULL);
 }
 
 
@@ -640,3 +655,950 @@ void z80_test_inc_bc_carry(void) {
     struct registers expected = z80_test_make_registers(0x0001, 0xFFFF, 0x00, 0x00, 0x13, 0x00, 0x00, 0x00, 0x00, 0x00);
     z80_perform_test("INC BC (carry)", 0x03, &initial, &expected, NULL, NULL);
 }
+
+// T-states per instruction, checked against the Zilog Z80 CPU User Manual
+// (UM0080). Conditional entries are run both ways through F or B/BC.
+typedef struct
+{
+    const char *name;
+    uint8_t bytes[4];
+    uint8_t f;
+    uint16_t bc;
+    uint64_t cycles;
+} timing_case_t;
+
+static const timing_case_t timing_cases[] =
+{
+    {"NOP",              {0x00},                   0x00, 0x0000,  4},
+    {"LD BC,nn",         {0x01, 0x34, 0x12},       0x00, 0x0000, 10},
+    {"LD (HL),n",        {0x36, 0x55},             0x00, 0x0000, 10},
+    {"INC (HL)",         {0x34},                   0x00, 0x0000, 11},
+    {"INC BC",           {0x03},                   0x00, 0x0000,  6},
+    {"ADD HL,BC",        {0x09},                   0x00, 0x0000, 11},
+    {"EX DE,HL",         {0xEB},                   0x00, 0x0000,  4},
+    {"EX (SP),HL",       {0xE3},                   0x00, 0x0000, 19},
+    {"JP nn",            {0xC3, 0x00, 0x10},       0x00, 0x0000, 10},
+    {"JR e",             {0x18, 0x10},             0x00, 0x0000, 12},
+    {"JR NZ,e (taken)",  {0x20, 0x10},             0x00, 0x0000, 12},
+    {"JR NZ,e (not)",    {0x20, 0x10},             MASK_Z, 0x0000, 7},
+    {"DJNZ e (taken)",   {0x10, 0x10},             0x00, 0x0200, 13},
+    {"DJNZ e (not)",     {0x10, 0x10},             0x00, 0x0100,  8},
+    {"CALL nn",          {0xCD, 0x00, 0x10},       0x00, 0x0000, 17},
+    {"CALL NZ,nn (taken)", {0xC4, 0x00, 0x10},     0x00, 0x0000, 17},
+    {"CALL NZ,nn (not)", {0xC4, 0x00, 0x10},       MASK_Z, 0x0000, 10},
+    {"RET",              {0xC9},                   0x00, 0x0000, 10},
+    {"RET NZ (taken)",   {0xC0},                   0x00, 0x0000, 11},
+    {"RET NZ (not)",     {0xC0},                   MASK_Z, 0x0000, 5},
+    {"PUSH BC",          {0xC5},                   0x00, 0x0000, 11},
+    {"POP BC",           {0xC1},                   0x00, 0x0000, 10},
+    {"RST 38H",          {0xFF},                   0x00, 0x0000, 11},
+    {"OUT (n),A",        {0xD3, 0xBE},             0x00, 0x0000, 11},
+    {"IN A,(n)",         {0xDB, 0xDC},             0x00, 0x0000, 11},
+    {"RLC B",            {0xCB, 0x00},             0x00, 0x0000,  8},
+    {"BIT 0,(HL)",       {0xCB, 0x46},             0x00, 0x0000, 12},
+    {"SET 0,(HL)",       {0xCB, 0xC6},             0x00, 0x0000, 15},
+    {"SBC HL,BC",        {0xED, 0x42},             0x00, 0x0000, 15},
+    {"LD (nn),BC",       {0xED, 0x43, 0x00, 0x20}, 0x00, 0x0000, 20},
+    {"NEG",              {0xED, 0x44},             0x00, 0x0000,  8},
+    {"RLD",              {0xED, 0x6F},             0x00, 0x0000, 18},
+    {"LDI",              {0xED, 0xA0},             0x00, 0x0002, 16},
+    {"LDIR (repeat)",    {0xED, 0xB0},             0x00, 0x0002, 21},
+    {"LDIR (last)",      {0xED, 0xB0},             0x00, 0x0001, 16},
+    {"LD IX,nn",         {0xDD, 0x21, 0x34, 0x12}, 0x00, 0x0000, 14},
+    {"ADD IX,BC",        {0xDD, 0x09},             0x00, 0x0000, 15},
+    {"LD A,(IX+d)",      {0xDD, 0x7E, 0x01},       0x00, 0x0000, 19},
+    {"LD (IX+d),n",      {0xDD, 0x36, 0x01, 0x55}, 0x00, 0x0000, 19},
+    {"INC (IX+d)",       {0xDD, 0x34, 0x01},       0x00, 0x0000, 23},
+    {"PUSH IX",          {0xDD, 0xE5},             0x00, 0x0000, 15},
+    {"LD IY,nn",         {0xFD, 0x21, 0x34, 0x12}, 0x00, 0x0000, 14},
+    {"RLC (IX+d)",       {0xDD, 0xCB, 0x01, 0x06}, 0x00, 0x0000, 23},
+    {"BIT 0,(IY+d)",     {0xFD, 0xCB, 0x01, 0x46}, 0x00, 0x0000, 20},
+};
+
+void z80_test_timing(void)
+{
+    test_context_t ctx;
+    test_result_t result;
+
+    for (size_t i = 0; i < sizeof(timing_cases) / sizeof(timing_cases[0]); i++)
+    {
+        const timing_case_t *t = &timing_cases[i];
+
+        z80_test_init(&ctx, t->name);
+        z80_test_set_memory(&ctx, 0x0000, (uint8_t *)t->bytes, sizeof(t->bytes));
+        ctx.cpu.registers.SP = 0xFF00;
+        ctx.cpu.registers.HL = 0x1000;
+        ctx.cpu.registers.DE = 0x3000;
+        ctx.cpu.registers.BC = t->bc;
+        ctx.cpu.registers.F = t->f;
+        z80_flags_written(&ctx.cpu);
+
+        tests_run++;
+        result.passed = z80_step(&ctx.cpu) == (int)t->cycles && ctx.cpu.cycles == t->cycles;
+        if (result.passed)
+        {
+            tests_passed++;
+        }
+        else
+        {
+            sprintf(result.error_msg, "Cycle count mismatch: expected %llu, got %llu",
+                    (unsigned long long)t->cycles, (unsigned long long)ctx.cpu.cycles);
+            tests_failed++;
+        }
+        z80_test_print_result(&ctx, &result);
+    }
+
+    // Mode 1 interrupt acknowledge
+    z80_test_init(&ctx, "IM 1 acknowledge");
+    ctx.cpu.registers.SP = 0xFF00;
+    ctx.cpu.int_mode = 1;
+    ctx.cpu.iff1 = true;
+    z80_set_interrupt_line(&ctx.cpu, true);
+    z80_check_interrupts(&ctx.cpu);
+
+    tests_run++;
+    result.passed = ctx.cpu.cycles == Z80_TIMING_IM1_ACK && ctx.cpu.registers.PC == 0x0038;
+    if (result.passed)
+    {
+        tests_passed++;
+    }
+    else
+    {
+        sprintf(result.error_msg, "expected %d T-states to 0x0038, got %llu to 0x%04X",
+                Z80_TIMING_IM1_ACK, (unsigned long long)ctx.cpu.cycles, ctx.cpu.registers.PC);
+        tests_failed++;
+    }
+    z80_test_print_result(&ctx, &result);
+}
+
+// Superinstructions must leave exactly the state the plain interpreter does,
+// including when the slice deadline falls between their ops
+typedef struct
+{
+    const char *name;
+    uint8_t bytes[16];
+    enum z80_fusion kind;
+    bool exit;             // port accesses call z80_request_exit()
+} fusion_case_t;
+
+static const fusion_case_t fusion_cases[] =
+{
+    {"DEC B / JR NZ",            {0x06, 0x05, 0x05, 0x20, 0xFD, 0x76}, Z80_FUSE_DEC_JR},
+    {"LD A,(nn) / AND n / JR Z", {0x3A, 0x00, 0x10, 0xE6, 0x0F, 0x28, 0x01, 0x3C, 0x76}, Z80_FUSE_LD_AND_JR},
+    {"IN A,(n) / CP n / JR NZ",  {0xDB, 0x10, 0xFE, 0x07, 0x20, 0xFA, 0x76}, Z80_FUSE_IN_TEST_JR},
+    {"LD A,(HL) / OUT / INC HL", {0x21, 0x00, 0x10, 0x7E, 0xD3, 0x20, 0x23, 0x7E, 0xD3, 0x20, 0x23, 0x76}, Z80_FUSE_LD_OUT_INC},
+    {"IN / AND / JR, exit on IN", {0xDB, 0x10, 0xE6, 0x07, 0x28, 0xFA, 0x76}, Z80_FUSE_IN_TEST_JR, true},
+    {"IN / CP / JR, exit on IN",  {0xDB, 0x10, 0xFE, 0x07, 0x20, 0xFA, 0x76}, Z80_FUSE_IN_TEST_JR, true},
+    {"LD / OUT / INC, exit on OUT", {0x21, 0x00, 0x10, 0x7E, 0xD3, 0x20, 0x23, 0x7E, 0xD3, 0x20, 0x23, 0x76}, Z80_FUSE_LD_OUT_INC, true},
+};
+
+// Port handlers that hand control back, like the SMS VDP's on an IRQ change
+static uint8_t fusion_exit_read8(void *context, uint8_t port)
+{
+    test_context_t *ctx = context;
+    z80_request_exit(&ctx->cpu);
+    return ctx->io_ports[port];
+}
+
+static void fusion_exit_write8(void *context, uint8_t port, uint8_t value)
+{
+    test_context_t *ctx = context;
+    z80_request_exit(&ctx->cpu);
+    ctx->io_ports[port] = value;
+}
+
+// Returns how many of the case's superinstructions the block cache built
+static uint64_t fusion_run(test_context_t *ctx, const fusion_case_t *t, bool fused, uint64_t deadline)
+{
+    z80_test_init(ctx, t->name);
+    z80_test_set_memory(ctx, 0x0000, (uint8_t *)t->bytes, sizeof(t->bytes));
+    z80_test_set_memory_byte(ctx, 0x1000, 0x23);
+    z80_test_set_memory_byte(ctx, 0x1001, 0x45);
+    ctx->io_ports[0x10] = 0x07;
+    if (t->exit)
+    {
+        ctx->cpu.io_read8 = fusion_exit_read8;
+        ctx->cpu.io_write8 = fusion_exit_write8;
+    }
+
+    struct z80_block_cache *cache = NULL;
+    uint64_t built = 0;
+    if (fused)
+    {
+        cache = z80_block_cache_create();
+        z80_block_cache_attach(&ctx->cpu, cache);
+    }
+    z80_run_until(&ctx->cpu, deadline);
+    z80_sync_flags(&ctx->cpu);
+    if (cache)
+    {
+        built = cache->fused[t->kind];
+        z80_block_cache_attach(&ctx->cpu, NULL);
+        z80_block_cache_destroy(cache);
+    }
+    return built;
+}
+
+void z80_test_fusion(void)
+{
+    static test_context_t plain, fused;
+    test_result_t result;
+
+    for (size_t i = 0; i < sizeof(fusion_cases) / sizeof(fusion_cases[0]); i++)
+    {
+        const fusion_case_t *t = &fusion_cases[i];
+        uint64_t deadline;
+
+        result.passed = true;
+        for (deadline = 1; deadline <= 80 && result.passed; deadline++)
+        {
+            fusion_run(&plain, t, false, deadline);
+            result.passed = fusion_run(&fused, t, true, deadline) > 0 &&
+                            plain.cpu.cycles == fused.cpu.cycles &&
+                            memcmp(&plain.cpu.registers, &fused.cpu.registers, sizeof(plain.cpu.registers)) == 0 &&
+                            plain.io_ports[0x20] == fused.io_ports[0x20];
+        }
+
+        tests_run++;
+        if (result.passed)
+        {
+            tests_passed++;
+        }
+        else
+        {
+            sprintf(result.error_msg, "Deadline %llu: PC 0x%04X after %llu T-states, expected 0x%04X after %llu",
+                    (unsigned long long)(deadline - 1), fused.cpu.registers.PC, (unsigned long long)fused.cpu.cycles,
+                    plain.cpu.registers.PC, (unsigned long long)plain.cpu.cycles);
+            tests_failed++;
+        }
+        z80_test_print_result(&fused, &result);
+    }
+}
+
+// Watchpoints must see every iteration of an idle loop, just as they would
+// with the idle-loop fast-forward off. Execute watchpoints are Z80
+// breakpoints (see sms_add_watchpoint()); read watchpoints trap the page
+// in the MMU.
+static uint32_t watch_execute_hits(bool idle_skip)
+{
+    static test_context_t ctx;
+    static uint8_t *pages[Z80_PAGE_COUNT];
+    uint32_t hits = 0;
+
+    z80_test_init(&ctx, "Execute watchpoint on JR $");
+    for (int page = 0; page < Z80_PAGE_COUNT; page++)
+    {
+        pages[page] = ctx.memory + page * Z80_PAGE_SIZE;
+    }
+    ctx.cpu.read_pages = pages;
+    z80_test_set_memory_byte(&ctx, 0x0000, 0x18); // JR $
+    z80_test_set_memory_byte(&ctx, 0x0001, 0xFE);
+    ctx.cpu.idle_skip = idle_skip;
+    z80_set_breakpoint(&ctx.cpu, 0x0000);
+
+    while (z80_run_until(&ctx.cpu, 228) == Z80_RUN_BREAKPOINT)
+    {
+        hits++;
+    }
+    return hits;
+}
+
+// Run the Z80 on the SMS memory map with rom as the cartridge, wired up
+// the way sms_init() does it
+static void test_mmu_init(struct z80_t *cpu, struct mmu_t *mem, const uint8_t *rom, size_t size)
+{
+    mmu_init(mem);
+    mmu_load_rom(mem, rom, size);
+    z80_init(cpu);
+    cpu->read8 = (uint8_t (*)(void *, uint16_t))mmu_read8;
+    cpu->write8 = (void (*)(void *, uint16_t, uint8_t))mmu_write8;
+    cpu->memory_ctx = mem;
+    cpu->read_pages = mem->read_pages;
+    cpu->write_pages = mem->write_pages;
+    cpu->page_banks = mem->page_banks;
+}
+
+static uint32_t watch_read_hits(bool idle_skip)
+{
+    static struct mmu_t mem;
+    static struct z80_t cpu;
+    static const uint8_t rom[] = {0x3A, 0x00, 0xC0, 0x18, 0xFB}; // LD A,(0xC000) / JR -5
+
+    test_mmu_init(&cpu, &mem, rom, sizeof(rom));
+    cpu.idle_skip = idle_skip;
+    mmu_watch_add(&mem, 0xC000, 0xC000, MMU_WATCH_READ);
+
+    z80_run_until(&cpu, 228);
+    uint32_t hits = mem.watch->hits;
+    mmu_deinit(&mem);
+    return hits;
+}
+
+void z80_test_watch(void)
+{
+    test_context_t *ctx = malloc(sizeof(*ctx));
+    test_result_t result;
+    uint32_t expected, hits;
+
+    expected = watch_execute_hits(false);
+    hits = watch_execute_hits(true);
+    z80_test_init(ctx, "Execute watchpoint on JR $");
+    tests_run++;
+    // A stop after every JR but the one that ends the slice
+    result.passed = expected == 18 && hits == expected;
+    if (result.passed)
+    {
+        tests_passed++;
+    }
+    else
+    {
+        sprintf(result.error_msg, "%u hits with idle skip, %u without, expected 18", hits, expected);
+        tests_failed++;
+    }
+    z80_test_print_result(ctx, &result);
+
+    expected = watch_read_hits(false);
+    hits = watch_read_hits(true);
+    z80_test_init(ctx, "Read watchpoint on LD A,(nn) / JR");
+    tests_run++;
+    result.passed = expected == 10 && hits == expected;
+    if (result.passed)
+    {
+        tests_passed++;
+    }
+    else
+    {
+        sprintf(result.error_msg, "%u hits with idle skip, %u without, expected 10", hits, expected);
+        tests_failed++;
+    }
+    z80_test_print_result(ctx, &result);
+    free(ctx);
+}
+
+// Decoded blocks must follow bank switches of every page they cover: a
+// block whose last instruction runs from slot 0 into slot 1 when only
+// slot 1 is switched, and code in cartridge RAM when 0xFFFC flips its bank
+static void block_bank_run(struct z80_t *cpu, uint16_t pc)
+{
+    cpu->registers.PC = pc;
+    cpu->registers.A = 0;
+    cpu->halted = false;
+    z80_run_until(cpu, cpu->cycles + 100);
+}
+
+void z80_test_block_banks(void)
+{
+    static struct mmu_t mem;
+    static struct z80_t cpu;
+    static uint8_t rom[4 * MMU_SLOT_SIZE];
+    test_context_t *ctx = malloc(sizeof(*ctx));
+    struct z80_block_cache *cache = z80_block_cache_create();
+    test_result_t result;
+    uint16_t first, second;
+
+    // CB prefix at 0x3FFF, then SET 0,A or SET 1,A and a HALT from whatever
+    // bank slot 1 shows; the opcode is consumed at decode time
+    rom[0x3FFF] = 0xCB;
+    rom[1 * MMU_SLOT_SIZE] = 0xC7;
+    rom[1 * MMU_SLOT_SIZE + 1] = 0x76;
+    rom[2 * MMU_SLOT_SIZE] = 0xCF;
+    rom[2 * MMU_SLOT_SIZE + 1] = 0x76;
+    test_mmu_init(&cpu, &mem, rom, sizeof(rom));
+    z80_block_cache_attach(&cpu, cache);
+
+    block_bank_run(&cpu, 0x3FFF);
+    first = cpu.registers.A;
+    mmu_write8(&mem, 0xFFFE, 2);
+    block_bank_run(&cpu, 0x3FFF);
+    second = cpu.registers.A;
+
+    z80_test_init(ctx, "Block cache: slot switch under a block's tail");
+    tests_run++;
+    result.passed = first == 0x01 && second == 0x02;
+    if (result.passed)
+    {
+        tests_passed++;
+    }
+    else
+    {
+        sprintf(result.error_msg, "A 0x%02X then 0x%02X, expected 0x01 then 0x02", first, second);
+        tests_failed++;
+    }
+    z80_test_print_result(ctx, &result);
+
+    // INC A / HALT in the first 16KB bank of cartridge RAM, DEC A / HALT in the second
+    for (int bank = 0; bank < 2; bank++)
+    {
+        mmu_write8(&mem, 0xFFFC, 0x08 | bank << 2);
+        mmu_write8(&mem, 0x8000, 0x3C + bank);
+        mmu_write8(&mem, 0x8001, 0x76);
+    }
+    mmu_write8(&mem, 0xFFFC, 0x08);
+    block_bank_run(&cpu, 0x8000);
+    first = cpu.registers.A;
+    mmu_write8(&mem, 0xFFFC, 0x0C);
+    block_bank_run(&cpu, 0x8000);
+    second = cpu.registers.A;
+
+    z80_test_init(ctx, "Block cache: cartridge RAM bank switch");
+    tests_run++;
+    result.passed = first == 0x01 && second == 0xFF;
+    if (result.passed)
+    {
+        tests_passed++;
+    }
+    else
+    {
+        sprintf(result.error_msg, "A 0x%02X then 0x%02X, expected 0x01 then 0xFF", first, second);
+        tests_failed++;
+    }
+    z80_test_print_result(ctx, &result);
+
+    z80_block_cache_attach(&cpu, NULL);
+    z80_block_cache_destroy(cache);
+    mmu_deinit(&mem);
+    free(ctx);
+}
+
+// A port handler asking for control back (the way the SMS VDP does when its
+// IRQ output changes) ends the run right after the OUT, in every run loop
+static void exit_io_write8(void *context, uint8_t port, uint8_t value)
+{
+    (void)port;
+    (void)value;
+    z80_request_exit(context);
+}
+
+static bool request_exit_stops(int loop)
+{
+    static struct mmu_t mem;
+    static struct z80_t cpu;
+    static const uint8_t rom[] = {0x00, 0xD3, 0xBF, 0x00, 0x18, 0xFE}; // NOP / OUT (0xBF),A / NOP / JR $
+    struct z80_block_cache *cache = NULL;
+    enum z80_run_reason reason;
+
+    test_mmu_init(&cpu, &mem, rom, sizeof(rom));
+    cpu.io_write8 = exit_io_write8;
+    cpu.io_ctx = &cpu;
+    if (loop == 1)
+    {
+        cache = z80_block_cache_create();
+        z80_block_cache_attach(&cpu, cache);
+    }
+    else if (loop == 2)
+    {
+        z80_set_breakpoint(&cpu, 0x1000);  // selects the debug loop
+    }
+
+    reason = z80_run_until(&cpu, 228);
+    bool stopped = reason == Z80_RUN_IO_EVENT && cpu.registers.PC == 0x0003 && cpu.cycles == 4 + 11;
+    // The next call carries on to the deadline
+    stopped = stopped && z80_run_until(&cpu, 228) == Z80_RUN_DEADLINE && cpu.cycles >= 228;
+
+    if (cache)
+    {
+        z80_block_cache_attach(&cpu, NULL);
+        z80_block_cache_destroy(cache);
+    }
+    mmu_deinit(&mem);
+    return stopped;
+}
+
+void z80_test_request_exit(void)
+{
+    static const char *const names[] = {"interpreter", "block cache", "debug loop"};
+    test_context_t *ctx = malloc(sizeof(*ctx));
+    test_result_t result;
+    char name[64];
+
+    for (int loop = 0; loop < 3; loop++)
+    {
+        snprintf(name, sizeof(name), "Exit requested by a port write (%s)", names[loop]);
+        z80_test_init(ctx, name);
+        tests_run++;
+        result.passed = request_exit_stops(loop);
+        if (result.passed)
+        {
+            tests_passed++;
+        }
+        else
+        {
+            sprintf(result.error_msg, "did not stop with Z80_RUN_IO_EVENT after the OUT");
+            tests_failed++;
+        }
+        z80_test_print_result(ctx, &result);
+    }
+    free(ctx);
+}
+
+// LDIR/LDDR/OTIR through the bulk path must leave the state single
+// iterations do (memory, registers, T-states, port writes) at every
+// deadline. The reference run sets a breakpoint nowhere near the code,
+// which selects the debug loop and so one iteration per instruction.
+typedef struct
+{
+    const char *name;
+    uint8_t bytes[16];
+    bool interrupt;        // raise an IM 1 interrupt at the deadline and carry on
+    uint8_t exit_value;    // OUT of this value calls z80_request_exit(), 0 = none
+} bulk_case_t;
+
+static const bulk_case_t bulk_cases[] =
+{
+    {"LDIR",                     {0x21, 0x00, 0x10, 0x11, 0x00, 0x20, 0x01, 0x40, 0x00, 0xED, 0xB0, 0x76}},
+    {"LDDR",                     {0x21, 0x3F, 0x10, 0x11, 0x3F, 0x20, 0x01, 0x40, 0x00, 0xED, 0xB8, 0x76}},
+    {"LDIR fill, DE = HL + 1",   {0x21, 0x00, 0x10, 0x11, 0x01, 0x10, 0x01, 0x40, 0x00, 0xED, 0xB0, 0x76}},
+    {"LDIR over its own bytes",  {0x21, 0x00, 0x10, 0x11, 0x00, 0x00, 0x01, 0x40, 0x00, 0xED, 0xB0, 0x76}},
+    {"LDIR, interrupted",        {0x21, 0x00, 0x10, 0x11, 0x00, 0x20, 0x01, 0x40, 0x00, 0xED, 0xB0, 0x76}, true},
+    {"OTIR",                     {0x21, 0x00, 0x10, 0x01, 0x20, 0x40, 0xED, 0xB3, 0x76}},
+    {"OTIR, exit from the port", {0x21, 0x00, 0x10, 0x01, 0x20, 0x40, 0xED, 0xB3, 0x76}, false, 0x1C},
+};
+
+static uint32_t bulk_out_hash;
+static uint8_t bulk_exit_value;
+
+static void bulk_io_write8(void *context, uint8_t port, uint8_t value)
+{
+    test_context_t *ctx = context;
+    bulk_out_hash = (bulk_out_hash ^ value) * 0x01000193u;
+    ctx->io_ports[port] = value;
+    if (bulk_exit_value && value == bulk_exit_value)
+        z80_request_exit(&ctx->cpu);
+}
+
+static uint32_t bulk_run(test_context_t *ctx, const bulk_case_t *t, bool bulk, uint64_t deadline)
+{
+    static uint8_t *pages[Z80_PAGE_COUNT];
+
+    z80_test_init(ctx, t->name);
+    for (int page = 0; page < Z80_PAGE_COUNT; page++)
+    {
+        pages[page] = ctx->memory + page * Z80_PAGE_SIZE;
+    }
+    ctx->cpu.read_pages = pages;
+    ctx->cpu.write_pages = pages;
+    // The source, and for the copy over the code something that still runs
+    // once its bytes land there: a few 0x3C (INC A) among the pattern
+    for (int i = 0; i < 0x40; i++)
+    {
+        ctx->memory[0x1000 + i] = i % 5 ? (uint8_t)(i * 7) : 0x3C;
+    }
+    z80_test_set_memory(ctx, 0x0000, (uint8_t *)t->bytes, sizeof(t->bytes));
+    ctx->cpu.io_write8 = bulk_io_write8;
+    bulk_out_hash = 0;
+    bulk_exit_value = t->exit_value;
+    if (t->interrupt)
+    {
+        ctx->cpu.int_mode = 1;
+        ctx->cpu.iff1 = ctx->cpu.iff2 = true;
+        ctx->cpu.registers.SP = 0xF000;
+        z80_test_set_memory_byte(ctx, 0x0038, 0xFB); // EI
+        z80_test_set_memory_byte(ctx, 0x0039, 0xC9); // RET
+    }
+    if (!bulk)
+    {
+        z80_set_breakpoint(&ctx->cpu, 0xFFFF);
+    }
+
+    z80_run_until(&ctx->cpu, deadline);
+    if (t->interrupt)
+    {
+        // Taken with int_pending set wherever the first run stopped, then
+        // the rest of the transfer
+        z80_set_interrupt_line(&ctx->cpu, true);
+        z80_run_until(&ctx->cpu, deadline + 300);
+    }
+    z80_sync_flags(&ctx->cpu);
+    return bulk_out_hash;
+}
+
+void z80_test_bulk(void)
+{
+    static test_context_t single, bulk;
+    test_result_t result;
+
+    for (size_t i = 0; i < sizeof(bulk_cases) / sizeof(bulk_cases[0]); i++)
+    {
+        const bulk_case_t *t = &bulk_cases[i];
+        uint64_t deadline;
+
+        result.passed = true;
+        for (deadline = 1; deadline <= 1500 && result.passed; deadline++)
+        {
+            uint32_t single_out = bulk_run(&single, t, false, deadline);
+            uint32_t bulk_out = bulk_run(&bulk, t, true, deadline);
+            result.passed = single.cpu.cycles == bulk.cpu.cycles &&
+                            memcmp(&single.cpu.registers, &bulk.cpu.registers, sizeof(single.cpu.registers)) == 0 &&
+                            memcmp(single.memory, bulk.memory, sizeof(single.memory)) == 0 &&
+                            single_out == bulk_out;
+        }
+
+        tests_run++;
+        if (result.passed)
+        {
+            tests_passed++;
+        }
+        else
+        {
+            sprintf(result.error_msg, "Deadline %llu: PC 0x%04X after %llu T-states, expected 0x%04X after %llu",
+                    (unsigned long long)(deadline - 1), bulk.cpu.registers.PC, (unsigned long long)bulk.cpu.cycles,
+                    single.cpu.registers.PC, (unsigned long long)single.cpu.cycles);
+            tests_failed++;
+        }
+        z80_test_print_result(&bulk, &result);
+    }
+}
+
+// The idle-loop fast-forward must end every slice in the state running
+// the loop would: same T-states and registers, with or without it. Loops
+// that write memory or ports are never skipped.
+typedef struct
+{
+    const char *name;
+    uint8_t bytes[8];
+    bool skipped;          // expect idle_skipped > 0 with the fast-forward on
+} idle_case_t;
+
+static const idle_case_t idle_cases[] =
+{
+    {"Idle skip: JR $",                      {0x18, 0xFE}, true},
+    {"Idle skip: IN A,($7E) / CP / JR NZ",   {0xDB, 0x7E, 0xFE, 0x20, 0x20, 0xFA}, true},
+    {"Idle skip: IN from a port with effects", {0xDB, 0x7F, 0xFE, 0x20, 0x20, 0xFA}, false},
+    {"Idle skip: LD ($C000),A / JR",         {0x32, 0x00, 0xC0, 0x18, 0xFB}, false},
+    {"Idle skip: OUT ($20),A / JR",          {0xD3, 0x20, 0x18, 0xFC}, false},
+};
+
+static void idle_run(test_context_t *ctx, const idle_case_t *t, bool idle_skip)
+{
+    static uint8_t *pages[Z80_PAGE_COUNT];
+
+    z80_test_init(ctx, t->name);
+    for (int page = 0; page < Z80_PAGE_COUNT; page++)
+    {
+        pages[page] = ctx->memory + page * Z80_PAGE_SIZE;
+    }
+    ctx->cpu.read_pages = pages;
+    ctx->cpu.write_pages = pages;
+    z80_test_set_memory(ctx, 0x0000, (uint8_t *)t->bytes, sizeof(t->bytes));
+    ctx->io_ports[0x7E] = 0x10;
+    ctx->io_ports[0x7F] = 0x10;
+    z80_idle_port(&ctx->cpu, 0x7E);
+    ctx->cpu.idle_skip = idle_skip;
+
+    // A few scanline-sized slices, the way sms_run_frame() calls it
+    for (uint64_t deadline = 228; deadline <= 4 * 228; deadline += 228)
+    {
+        z80_run_until(&ctx->cpu, deadline);
+    }
+    z80_sync_flags(&ctx->cpu);
+}
+
+void z80_test_idle(void)
+{
+    static test_context_t plain, skip;
+    test_result_t result;
+
+    for (size_t i = 0; i < sizeof(idle_cases) / sizeof(idle_cases[0]); i++)
+    {
+        const idle_case_t *t = &idle_cases[i];
+
+        idle_run(&plain, t, false);
+        idle_run(&skip, t, true);
+        tests_run++;
+        result.passed = plain.cpu.cycles == skip.cpu.cycles &&
+                        memcmp(&plain.cpu.registers, &skip.cpu.registers, sizeof(plain.cpu.registers)) == 0 &&
+                        plain.cpu.idle_skipped == 0 && (skip.cpu.idle_skipped > 0) == t->skipped;
+        if (result.passed)
+        {
+            tests_passed++;
+        }
+        else
+        {
+            sprintf(result.error_msg, "PC 0x%04X after %llu T-states (%llu skipped), expected 0x%04X after %llu",
+                    skip.cpu.registers.PC, (unsigned long long)skip.cpu.cycles,
+                    (unsigned long long)skip.cpu.idle_skipped, plain.cpu.registers.PC,
+                    (unsigned long long)plain.cpu.cycles);
+            tests_failed++;
+        }
+        z80_test_print_result(&skip, &result);
+    }
+}
+
+// HALT: the NOPs it keeps running are charged in one go up to the
+// deadline, whole ones only, refreshing R (bit 7 kept) once each; an
+// interrupt raised between slices wakes it through int_pending
+void z80_test_halt(void)
+{
+    static test_context_t ctx;
+    test_result_t result;
+
+    z80_test_init(&ctx, "HALT until the deadline");
+    z80_test_set_memory_byte(&ctx, 0x0000, 0x76); // HALT
+    z80_test_set_memory_byte(&ctx, 0x0038, 0x76); // HALT in the interrupt handler
+    ctx.cpu.registers.R = 0xFE;
+    ctx.cpu.registers.SP = 0xF000;
+
+    z80_run_until(&ctx.cpu, 103);
+    tests_run++;
+    // 4 T-states of HALT, then 25 NOPs, the last one running past 103
+    result.passed = ctx.cpu.halted && ctx.cpu.cycles == 104 && ctx.cpu.halted_cycles == 100 &&
+                    ctx.cpu.registers.R == (0x80 | ((0x7E + 25) & 0x7F));
+    if (result.passed)
+    {
+        tests_passed++;
+    }
+    else
+    {
+        sprintf(result.error_msg, "%llu T-states, %llu halted, R 0x%02X; expected 104, 100, 0x%02X",
+                (unsigned long long)ctx.cpu.cycles, (unsigned long long)ctx.cpu.halted_cycles,
+                ctx.cpu.registers.R, 0x80 | ((0x7E + 25) & 0x7F));
+        tests_failed++;
+    }
+    z80_test_print_result(&ctx, &result);
+
+    z80_test_init(&ctx, "HALT woken by an interrupt");
+    z80_test_set_memory_byte(&ctx, 0x0000, 0x76);
+    z80_test_set_memory_byte(&ctx, 0x0038, 0x76);
+    ctx.cpu.registers.SP = 0xF000;
+    ctx.cpu.int_mode = 1;
+    ctx.cpu.iff1 = ctx.cpu.iff2 = true;
+    z80_run_until(&ctx.cpu, 100);
+    z80_set_interrupt_line(&ctx.cpu, true);
+    z80_run_until(&ctx.cpu, 200);
+
+    tests_run++;
+    // Acknowledged at once, returning past the HALT, and halted again in the handler
+    result.passed = ctx.cpu.halted && ctx.cpu.registers.PC == 0x0039 && ctx.cpu.registers.SP == 0xEFFE &&
+                    ctx.memory[0xEFFE] == 0x01 && ctx.memory[0xEFFF] == 0x00 &&
+                    ctx.cpu.cycles == 100 + Z80_TIMING_IM1_ACK + 4 + (200 - 100 - Z80_TIMING_IM1_ACK - 4 + 3) / 4 * 4;
+    if (result.passed)
+    {
+        tests_passed++;
+    }
+    else
+    {
+        sprintf(result.error_msg, "PC 0x%04X SP 0x%04X after %llu T-states, expected 0x0039 SP 0xEFFE",
+                ctx.cpu.registers.PC, ctx.cpu.registers.SP, (unsigned long long)ctx.cpu.cycles);
+        tests_failed++;
+    }
+    z80_test_print_result(&ctx, &result);
+}
+
+// Mapper detection: known Korean dumps by CRC-32 first, then the
+// Codemasters header, then the LD (nn),A heuristic
+static uint8_t detect_rom[4 * MMU_SLOT_SIZE];
+
+// Store `count` LD (addr),A instructions at the start of the ROM
+static void detect_stores(uint16_t addr, int count)
+{
+    static int offset;
+
+    if (count == 0)
+    {
+        offset = 0;
+        return;
+    }
+    for (int i = 0; i < count; i++, offset += 3)
+    {
+        detect_rom[offset] = 0x32;
+        detect_rom[offset + 1] = addr & 0xFF;
+        detect_rom[offset + 2] = addr >> 8;
+    }
+}
+
+// Set the last four bytes so the CRC-32 of the whole ROM is crc: with the
+// register run backwards over 32 zero bits, they are what it must be XORed
+// with after the rest of the image
+static void detect_forge_crc(uint32_t crc)
+{
+    size_t len = sizeof(detect_rom) - 4;
+    uint32_t state = 0xFFFFFFFF, x = crc ^ 0xFFFFFFFF;
+
+    for (size_t i = 0; i < len; i++)
+    {
+        state ^= detect_rom[i];
+        for (int bit = 0; bit < 8; bit++)
+        {
+            state = state & 1 ? (state >> 1) ^ 0xEDB88320 : state >> 1;
+        }
+    }
+    for (int bit = 0; bit < 32; bit++)
+    {
+        x = x & 0x80000000 ? ((x ^ 0xEDB88320) << 1) | 1 : x << 1;
+    }
+    x ^= state;
+    for (int i = 0; i < 4; i++)
+    {
+        detect_rom[len + i] = x >> (8 * i);
+    }
+}
+
+typedef struct
+{
+    const char *name;
+    size_t size;
+    uint16_t store;        // LD (store),A instructions to place, stores times
+    int stores;
+    uint16_t store2;       // and store2, stores2 times
+    int stores2;
+    bool codemasters;      // valid Codemasters header
+    uint32_t crc;          // CRC-32 to forge, 0 = leave it
+    enum mmu_mapper_type expected;
+} detect_case_t;
+
+static const detect_case_t detect_cases[] =
+{
+    {"Mapper detect: plain ROM",                 sizeof(detect_rom), 0, 0, 0, 0, false, 0, MMU_MAPPER_SEGA},
+    {"Mapper detect: Sega stores",               sizeof(detect_rom), 0xFFFF, 3, 0xA000, 2, false, 0, MMU_MAPPER_SEGA},
+    {"Mapper detect: Korean stores",             sizeof(detect_rom), 0xA000, 3, 0xFFFF, 2, false, 0, MMU_MAPPER_KOREAN},
+    {"Mapper detect: Korean 8KB stores",         sizeof(detect_rom), 0x0002, 3, 0xA000, 2, false, 0, MMU_MAPPER_KOREAN_8K},
+    {"Mapper detect: 48KB ROM stays Sega",       3 * MMU_SLOT_SIZE, 0xA000, 3, 0, 0, false, 0, MMU_MAPPER_SEGA},
+    {"Mapper detect: Codemasters header",        sizeof(detect_rom), 0xA000, 3, 0, 0, true, 0, MMU_MAPPER_CODEMASTERS},
+    {"Mapper detect: known Korean CRC",          sizeof(detect_rom), 0xFFFF, 3, 0, 0, false, 0x89B79E77, MMU_MAPPER_KOREAN},
+    {"Mapper detect: known Korean 8KB CRC",      sizeof(detect_rom), 0xFFFF, 3, 0, 0, true, 0x445525E2, MMU_MAPPER_KOREAN_8K},
+};
+
+void z80_test_mapper_detect(void)
+{
+    static struct mmu_t mem;
+    test_context_t *ctx = malloc(sizeof(*ctx));
+    test_result_t result;
+
+    for (size_t i = 0; i < sizeof(detect_cases) / sizeof(detect_cases[0]); i++)
+    {
+        const detect_case_t *t = &detect_cases[i];
+
+        memset(detect_rom, 0xFF, sizeof(detect_rom));
+        detect_stores(0, 0);
+        detect_stores(t->store, t->stores);
+        detect_stores(t->store2, t->stores2);
+        if (t->codemasters)
+        {
+            // Checksum 0x1234 and its complement
+            detect_rom[0x7FE6] = 0x34;
+            detect_rom[0x7FE7] = 0x12;
+            detect_rom[0x7FE8] = 0xCC;
+            detect_rom[0x7FE9] = 0xED;
+        }
+        if (t->crc)
+        {
+            detect_forge_crc(t->crc);
+        }
+
+        mmu_init(&mem);
+        mmu_load_rom(&mem, detect_rom, t->size);
+        z80_test_init(ctx, t->name);
+        tests_run++;
+        result.passed = mem.mapper_type == t->expected;
+        if (result.passed)
+        {
+            tests_passed++;
+        }
+        else
+        {
+            sprintf(result.error_msg, "Detected %s, expected %s", mmu_mapper_name(mem.mapper_type),
+                    mmu_mapper_name(t->expected));
+            tests_failed++;
+        }
+        z80_test_print_result(ctx, &result);
+        mmu_deinit(&mem);
+    }
+    free(ctx);
+}
+
+// Bank switching of each mapper, driven by LD (nn),A from system RAM. Every
+// 8KB of the ROM is filled with its own index, so a read tells which bank a
+// page shows.
+typedef struct
+{
+    const char *name;
+    enum mmu_mapper_type mapper;
+    uint16_t writes[4][2];     // address, value
+    int write_count;
+    uint16_t reads[6][2];      // address, expected byte
+} mapper_case_t;
+
+static const mapper_case_t mapper_cases[] =
+{
+    {"Sega mapper: slots 0-2", MMU_MAPPER_SEGA,
+     {{0xFFFF, 5}, {0xFFFE, 3}, {0xFFFD, 4}}, 3,
+     {{0x0000, 0}, {0x0400, 8}, {0x2000, 9}, {0x4000, 6}, {0x8000, 10}, {0xA000, 11}}},
+    {"Sega mapper: cartridge RAM in slot 2", MMU_MAPPER_SEGA,
+     {{0xFFFF, 5}, {0xFFFC, 0x08}, {0x8000, 0x5A}, {0xBFFF, 0xA5}}, 4,
+     {{0x0000, 0}, {0x4000, 2}, {0x8000, 0x5A}, {0xBFFF, 0xA5}, {0xA000, 0x00}, {0x7FFF, 3}}},
+    {"Codemasters mapper: slots 0-2", MMU_MAPPER_CODEMASTERS,
+     {{0x0000, 6}, {0x4000, 2}, {0x8000, 7}}, 3,
+     {{0x0000, 12}, {0x0400, 12}, {0x2000, 13}, {0x4000, 4}, {0x8000, 14}, {0xA000, 15}}},
+    {"Codemasters mapper: cartridge RAM", MMU_MAPPER_CODEMASTERS,
+     {{0x4000, 0x82}, {0xA000, 0x5A}, {0xBFFF, 0xA5}}, 3,
+     {{0x0000, 0}, {0x4000, 4}, {0x8000, 0}, {0xA000, 0x5A}, {0xBFFF, 0xA5}, {0x6000, 5}}},
+    {"Korean mapper: slot 2", MMU_MAPPER_KOREAN,
+     {{0xA000, 5}}, 1,
+     {{0x0000, 0}, {0x2000, 1}, {0x4000, 2}, {0x6000, 3}, {0x8000, 10}, {0xA000, 11}}},
+    {"Korean 8KB mapper: four pages", MMU_MAPPER_KOREAN_8K,
+     {{0x0000, 3}, {0x0001, 4}, {0x0002, 5}, {0x0003, 6}}, 4,
+     {{0x0000, 0}, {0x2000, 1}, {0x4000, 5}, {0x6000, 6}, {0x8000, 3}, {0xA000, 4}}},
+};
+
+void z80_test_mappers(void)
+{
+    static struct mmu_t mem;
+    static struct z80_t cpu;
+    static uint8_t rom[16 * MMU_SLOT_SIZE];
+    test_context_t *ctx = malloc(sizeof(*ctx));
+    test_result_t result;
+
+    for (size_t i = 0; i < sizeof(rom); i++)
+    {
+        rom[i] = i / 0x2000;
+    }
+
+    for (size_t i = 0; i < sizeof(mapper_cases) / sizeof(mapper_cases[0]); i++)
+    {
+        const mapper_case_t *t = &mapper_cases[i];
+        uint16_t pc = 0xC000;
+
+        test_mmu_init(&cpu, &mem, rom, sizeof(rom));
+        mmu_set_mapper_override(&mem, t->mapper);
+        mmu_load_rom(&mem, rom, sizeof(rom));
+
+        // LD A,n / LD (nn),A for each write, then HALT
+        for (int w = 0; w < t->write_count; w++)
+        {
+            mmu_write8(&mem, pc++, 0x3E);
+            mmu_write8(&mem, pc++, t->writes[w][1]);
+            mmu_write8(&mem, pc++, 0x32);
+            mmu_write8(&mem, pc++, t->writes[w][0] & 0xFF);
+            mmu_write8(&mem, pc++, t->writes[w][0] >> 8);
+        }
+        mmu_write8(&mem, pc, 0x76);
+        cpu.registers.PC = 0xC000;
+        z80_run_until(&cpu, 1000);
+
+        z80_test_init(ctx, t->name);
+        tests_run++;
+        result.passed = cpu.halted;
+        sprintf(result.error_msg, "Program did not reach its HALT");
+        for (int r = 0; r < 6 && result.passed; r++)
+        {
+            uint8_t value = mmu_read8(&mem, t->reads[r][0]);
+            if (value != t->reads[r][1])
+            {
+                sprintf(result.error_msg, "0x%04X reads 0x%02X, expected 0x%02X", t->reads[r][0], value,
+                        t->reads[r][1]);
+                result.passed = false;
+            }
+        }
+        if (result.passed)
+        {
+            tests_passed++;
+        }
+        else
+        {
+            tests_failed++;
+        }
+        z80_test_print_result(ctx, &result);
+        mmu_deinit(&mem);
+    }
+    free(ctx);
+}
@@ -65,6 +65,8 @@ test_result_t z80_test_run(test_context_t *ctx);
 void z80_test_print_result(test_context_t *ctx, test_result_t *result);
 // Print test summary
 void z80_test_print_summary(void);
+// Number of failed tests so far
+int z80_test_failures(void);
 // Helper function to create register state
 struct registers z80_test_make_registers(uint16_t pc, uint16_t sp, uint8_t a, uint8_t f,
                                          uint8_t b, uint8_t c, uint8_t d, uint8_t e,
@@ -76,6 +78,8 @@ void setup_hl_indirect(test_context_t *ctx);
 void check_inc_hl_indirect(test_context_t *ctx);
 // Checks the expected memory value after a DEC (HL) instruction.
 void check_dec_hl_indirect(test_context_t *ctx);
+// Places the two bytes of SBC HL, BC for its tests.
+void setup_sbc_hl_bc(test_context_t *ctx);
 
 void z80_perform_test(const char* name,
                       uint8_t opcode,
@@ -83,4 +87,56 @@ void z80_perform_test(const char* name,
                        struct registers* expected,
                       void (*setup_extra)(test_context_t* ctx),
                       void (*check_extra)(test_context_t* ctx));
+
+// Instruction tests
+void z80_test_example(void);
+void z80_test_inc_a(void);
+void z80_test_inc_a_zero(void);
+void z80_test_inc_a_half_carry(void);
+void z80_test_dec_a(void);
+void z80_test_dec_a_zero(void);
+void z80_test_dec_a_underflow(void);
+void z80_test_inc_b(void);
+void z80_test_dec_b(void);
+void z80_test_inc_c(void);
+void z80_test_dec_c(void);
+void z80_test_sbc_a_b_simple(void);
+void z80_test_sbc_a_b_with_carry(void);
+void z80_test_sbc_a_b_borrow(void);
+void z80_test_sbc_a_b_borrow_with_carry(void);
+void z80_test_sbc_a_b_zero(void);
+void z80_test_sbc_a_b_half_borrow(void);
+void z80_test_sbc_a_b_overflow(void);
+void z80_test_sbc_hl_bc_simple(void);
+void z80_test_sbc_hl_bc_with_carry(void);
+void z80_test_sbc_hl_bc_borrow(void);
+void z80_test_sbc_hl_bc_zero(void);
+void z80_test_sbc_hl_bc_half_borrow(void);
+void z80_test_sbc_hl_bc_overflow(void);
+void z80_test_inc_hl_indirect(void);
+void z80_test_dec_hl_indirect(void);
+void z80_test_inc_bc(void);
+void z80_test_dec_bc(void);
+void z80_test_inc_bc_carry(void);
+
+// T-states of each instruction class against the Zilog manual
+void z80_test_timing(void);
+// Superinstructions against the plain interpreter at every deadline
+void z80_test_fusion(void);
+// Watchpoints on idle loops, with and without the idle-loop fast-forward
+void z80_test_watch(void);
+// Decoded blocks across bank switches
+void z80_test_block_banks(void);
+// z80_request_exit() from a port handler
+void z80_test_request_exit(void);
+// LDIR/LDDR/OTIR bulk paths against single iterations at every deadline
+void z80_test_bulk(void);
+// Idle-loop fast-forward against running the loop
+void z80_test_idle(void);
+// HALT charged up to the deadline and woken by an interrupt
+void z80_test_halt(void);
+// Cartridge mapper detection
+void z80_test_mapper_detect(void);
+// Bank switching of each cartridge mapper
+void z80_test_mappers(void);
 #endif
\ No newline at end of file
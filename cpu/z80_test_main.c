@@ -0,0 +1,49 @@
+#include "z80_test.h"
+
+// Runs the Z80 tests against the callback bus; the exit status is the
+// number of failures, for ctest
+int main(void)
+{
+    z80_test_example();
+    z80_test_inc_a();
+    z80_test_inc_a_zero();
+    z80_test_inc_a_half_carry();
+    z80_test_dec_a();
+    z80_test_dec_a_zero();
+    z80_test_dec_a_underflow();
+    z80_test_inc_b();
+    z80_test_dec_b();
+    z80_test_inc_c();
+    z80_test_dec_c();
+    z80_test_sbc_a_b_simple();
+    z80_test_sbc_a_b_with_carry();
+    z80_test_sbc_a_b_borrow();
+    z80_test_sbc_a_b_borrow_with_carry();
+    z80_test_sbc_a_b_zero();
+    z80_test_sbc_a_b_half_borrow();
+    z80_test_sbc_a_b_overflow();
+    z80_test_sbc_hl_bc_simple();
+    z80_test_sbc_hl_bc_with_carry();
+    z80_test_sbc_hl_bc_borrow();
+    z80_test_sbc_hl_bc_zero();
+    z80_test_sbc_hl_bc_half_borrow();
+    z80_test_sbc_hl_bc_overflow();
+    z80_test_inc_hl_indirect();
+    z80_test_dec_hl_indirect();
+    z80_test_inc_bc();
+    z80_test_dec_bc();
+    z80_test_inc_bc_carry();
+    z80_test_timing();
+    z80_test_fusion();
+    z80_test_watch();
+    z80_test_block_banks();
+    z80_test_request_exit();
+    z80_test_bulk();
+    z80_test_idle();
+    z80_test_halt();
+    z80_test_mapper_detect();
+    z80_test_mappers();
+
+    z80_test_print_summary();
+    return z80_test_failures();
+}
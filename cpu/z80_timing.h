@@ -0,0 +1,26 @@
+#ifndef Z80_TIMING_H_
+#define Z80_TIMING_H_
+
+#include <stdint.h>
+
+// T-state tables, one entry per opcode of each executor, generated at build
+// time by z80_timing_gen.c from the cycle counts in z80_opcode_table.h.
+// Every executor adds its entry to cycle_count when it dispatches; prefix
+// opcodes are 0 in the table they appear in, so the executor of the last
+// prefix charges the whole instruction. Entries are the cost of the path
+// that does not branch or repeat; the executors add the extras below when
+// it does. Unconditional JR, CALL and RET are stored the same way and always
+// take the extra.
+extern const uint8_t z80_timing_base[256];  // unprefixed
+extern const uint8_t z80_timing_cb[256];    // CB xx
+extern const uint8_t z80_timing_ed[256];    // ED xx
+extern const uint8_t z80_timing_xy[256];    // DD xx / FD xx (DD CB / FD CB are 0)
+extern const uint8_t z80_timing_xycb[256];  // DD CB d xx / FD CB d xx
+
+#define Z80_TIMING_JR_TAKEN    5   // JR, JR cc, DJNZ jumping
+#define Z80_TIMING_CALL_TAKEN  7   // CALL, CALL cc calling
+#define Z80_TIMING_RET_TAKEN   6   // RET, RET cc returning
+#define Z80_TIMING_REPEAT      5   // LDIR & co. going round again
+#define Z80_TIMING_IM1_ACK     13  // accepting a mode 1 interrupt
+
+#endif
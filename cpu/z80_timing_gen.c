@@ -0,0 +1,122 @@
+// Build-time generator for the Z80 T-state tables.
+//
+// Writes z80_timing_tables.h, which z80.c includes to define the tables
+// declared in z80_timing.h. The base, ED and DD/FD counts come from
+// z80_opcode_table.h; the CB and DD CB/FD CB pages follow the Zilog Z80 CPU
+// User Manual (UM0080) rules below, since the disassembler has no table for
+// them. Branches and block repeats are stored without their extra T-states.
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "z80_opcode_table.h"
+#include "z80_timing.h"
+
+#define PREFIX_FETCH 4 // M1 of a prefix byte
+
+static bool failed = false;
+
+static uint8_t base_entry(int i)
+{
+    switch (i)
+    {
+    case 0x18: return opcode_table[i].cycles - Z80_TIMING_JR_TAKEN;    // JR e
+    case 0xC9: return opcode_table[i].cycles - Z80_TIMING_RET_TAKEN;   // RET
+    case 0xCD: return opcode_table[i].cycles - Z80_TIMING_CALL_TAKEN;  // CALL nn
+    }
+    return opcode_table[i].cycles;
+}
+
+// RLC..SRL r: 8, BIT b,(HL): 12, the rest on (HL): 15
+static uint8_t cb_entry(int i)
+{
+    if ((i & 7) != 6)
+        return 8;
+    return (i & 0xC0) == 0x40 ? 12 : 15;
+}
+
+// LDIR, CPIR, INIR, OTIR and their decrementing forms
+static uint8_t ed_entry(int i)
+{
+    if ((i & 0xF4) == 0xB0)
+        return ed_opcode_table[i].cycles - Z80_TIMING_REPEAT;
+    return ed_opcode_table[i].cycles;
+}
+
+// An opcode the index prefix does not change runs as the unprefixed one
+// after the prefix fetch. DD CB/FD CB are charged by the xycb table.
+static uint8_t xy_entry(int i)
+{
+    if (dd_opcode_table[i].cycles != fd_opcode_table[i].cycles)
+    {
+        fprintf(stderr, "DD/FD T-states differ at 0x%02X\n", i);
+        failed = true;
+    }
+    if (i == 0xCB)
+        return 0;
+    if (strcmp(dd_opcode_table[i].name, "???") == 0)
+        return PREFIX_FETCH + base_entry(i);
+    return dd_opcode_table[i].cycles;
+}
+
+// BIT b,(XY+d): 20, everything else: 23
+static uint8_t xycb_entry(int i)
+{
+    return (i & 0xC0) == 0x40 ? 20 : 23;
+}
+
+static void emit_table(FILE *out, const char *name, const char *comment, uint8_t (*entry)(int))
+{
+    fprintf(out, "// %s\n", comment);
+    fprintf(out, "const uint8_t %s[256] = {", name);
+    for (int i = 0; i < 256; i++)
+    {
+        fprintf(out, "%s%2u,", (i % 16) ? " " : "\n    ", entry(i));
+    }
+    fprintf(out, "\n};\n\n");
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc != 2)
+    {
+        fprintf(stderr, "usage: %s <output header>\n", argv[0]);
+        return 1;
+    }
+
+    static const uint8_t prefixes[] = {0xCB, 0xDD, 0xED, 0xFD};
+    for (size_t i = 0; i < sizeof(prefixes); i++)
+    {
+        if (opcode_table[prefixes[i]].cycles != 0)
+        {
+            fprintf(stderr, "prefix 0x%02X must cost 0 T-states\n", prefixes[i]);
+            return 1;
+        }
+    }
+
+    FILE *out = fopen(argv[1], "w");
+    if (!out)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+
+    fprintf(out, "// Generated by z80_timing_gen.c - do not edit.\n");
+    fprintf(out, "#ifndef Z80_TIMING_TABLES_H_\n#define Z80_TIMING_TABLES_H_\n\n");
+    fprintf(out, "#include \"z80_timing.h\"\n\n");
+
+    emit_table(out, "z80_timing_base", "Unprefixed, prefixes 0", base_entry);
+    emit_table(out, "z80_timing_cb", "CB xx, prefix included", cb_entry);
+    emit_table(out, "z80_timing_ed", "ED xx, prefix included", ed_entry);
+    emit_table(out, "z80_timing_xy", "DD xx / FD xx, prefix included", xy_entry);
+    emit_table(out, "z80_timing_xycb", "DD CB d xx / FD CB d xx, prefixes included", xycb_entry);
+
+    fprintf(out, "#endif\n");
+
+    if (fclose(out) != 0)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,114 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "z80_trace.h"
+
+struct z80_trace *z80_trace_create(uint32_t entries)
+{
+    uint32_t capacity = 1;
+    while (capacity < entries && capacity < 0x80000000u)
+    {
+        capacity <<= 1;
+    }
+
+    struct z80_trace *trace = malloc(sizeof(*trace));
+    if (!trace)
+    {
+        return NULL;
+    }
+    trace->entries = malloc((size_t)capacity * sizeof(struct z80_trace_entry));
+    if (!trace->entries)
+    {
+        printf("Failed to allocate a trace of %u entries\n", capacity);
+        free(trace);
+        return NULL;
+    }
+    trace->mask = capacity - 1;
+    trace->head = 0;
+    return trace;
+}
+
+void z80_trace_destroy(struct z80_trace *trace)
+{
+    if (trace)
+    {
+        free(trace->entries);
+        free(trace);
+    }
+}
+
+// Instruction bytes come straight from the page tables or the read callback
+// so recording costs no T-states and leaves the bus untouched
+static uint8_t trace_peek(struct z80_t *cpu, uint16_t addr)
+{
+    uint8_t *page = cpu->read_pages[addr >> Z80_PAGE_SHIFT];
+    if (page)
+    {
+        return page[addr & Z80_PAGE_MASK];
+    }
+    return cpu->read8(cpu->memory_ctx, addr);
+}
+
+// Record the instruction about to run at PC
+void z80_trace_record(struct z80_t *cpu)
+{
+    struct z80_trace *trace = cpu->trace;
+    struct z80_trace_entry *entry = &trace->entries[trace->head & trace->mask];
+    uint16_t pc = cpu->registers.PC;
+
+    z80_sync_flags(cpu);
+    entry->cycles = cpu->cycles;
+    entry->pc = pc;
+    entry->sp = cpu->registers.SP;
+    entry->af = cpu->registers.AF;
+    entry->bc = cpu->registers.BC;
+    entry->de = cpu->registers.DE;
+    entry->hl = cpu->registers.HL;
+    entry->ix = cpu->registers.IX;
+    entry->iy = cpu->registers.IY;
+    entry->bank = cpu->page_banks ? cpu->page_banks[pc >> Z80_PAGE_SHIFT] : 0;
+    for (int i = 0; i < 4; i++)
+    {
+        entry->bytes[i] = trace_peek(cpu, (uint16_t)(pc + i));
+    }
+    entry->i = cpu->registers.I;
+    entry->r = cpu->registers.R;
+    trace->head++;
+}
+
+// Write the ring, oldest entry first, for z80_trace_decode
+bool z80_trace_dump(const struct z80_trace *trace, const char *path)
+{
+    uint64_t capacity = (uint64_t)trace->mask + 1;
+    uint64_t count = trace->head < capacity ? trace->head : capacity;
+    uint64_t first = trace->head - count;
+
+    FILE *file = fopen(path, "wb");
+    if (!file)
+    {
+        printf("Failed to open trace file: %s\n", path);
+        return false;
+    }
+
+    struct z80_trace_file_header header = {
+        .magic = Z80_TRACE_FILE_MAGIC,
+        .version = Z80_TRACE_FILE_VERSION,
+        .entry_size = sizeof(struct z80_trace_entry),
+        .count = (uint32_t)count,
+    };
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+
+    // The ring wraps at most once: from the oldest entry to the end of the
+    // buffer, then from the start
+    uint64_t start = first & trace->mask;
+    uint64_t tail = capacity - start < count ? capacity - start : count;
+    ok = ok && fwrite(&trace->entries[start], sizeof(struct z80_trace_entry), tail, file) == tail;
+    ok = ok && fwrite(trace->entries, sizeof(struct z80_trace_entry), count - tail, file) == count - tail;
+
+    if (fclose(file) != 0 || !ok)
+    {
+        printf("Failed to write trace file: %s\n", path);
+        return false;
+    }
+    printf("Wrote %llu traced instructions to %s\n", (unsigned long long)count, path);
+    return true;
+}
@@ -0,0 +1,56 @@
+#ifndef Z80_TRACE_H_
+#define Z80_TRACE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "z80.h"
+
+// Trace file: a header followed by the entries, oldest first, in host byte
+// order. Bump the version whenever struct z80_trace_entry changes.
+#define Z80_TRACE_FILE_MAGIC    0x43525443u  // "CTRC"
+#define Z80_TRACE_FILE_VERSION  1
+#define Z80_TRACE_DEFAULT_SIZE  (1u << 20)   // entries (32 MB)
+
+// CPU state before one instruction
+struct z80_trace_entry
+{
+    uint64_t cycles;
+    uint16_t pc;
+    uint16_t sp;
+    uint16_t af;
+    uint16_t bc;
+    uint16_t de;
+    uint16_t hl;
+    uint16_t ix;
+    uint16_t iy;
+    uint16_t bank;         // bank mapped at PC, 0 for flat memory
+    uint8_t bytes[4];      // instruction bytes, read ahead
+    uint8_t i;
+    uint8_t r;
+};
+
+struct z80_trace_file_header
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entry_size;
+    uint32_t count;
+};
+
+// Fixed-size ring of the most recent instructions. Only the emulation thread
+// writes it and it is dumped from the same thread between slices, so the
+// recorder is a store and an increment with no locking.
+struct z80_trace
+{
+    struct z80_trace_entry *entries;
+    uint32_t mask;         // capacity - 1, capacity a power of two
+    uint64_t head;         // entries recorded so far
+};
+
+struct z80_trace *z80_trace_create(uint32_t entries);
+void z80_trace_destroy(struct z80_trace *trace);
+void z80_trace_record(struct z80_t *cpu);
+bool z80_trace_dump(const struct z80_trace *trace, const char *path);
+
+#endif
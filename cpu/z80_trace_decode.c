@@ -0,0 +1,66 @@
+// Offline decoder for trace files written by z80_trace_dump(): prints one
+// line per instruction in the same layout as the live disassembler.
+// Usage: z80_trace_decode <trace file> [output file]
+#include <stdio.h>
+#include <stdlib.h>
+#include "z80.h"
+#include "z80_trace.h"
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s <trace file> [output file]\n", argv[0]);
+        return 1;
+    }
+
+    FILE *in = fopen(argv[1], "rb");
+    if (!in)
+    {
+        fprintf(stderr, "Failed to open trace file: %s\n", argv[1]);
+        return 1;
+    }
+
+    struct z80_trace_file_header header;
+    if (fread(&header, sizeof(header), 1, in) != 1 ||
+        header.magic != Z80_TRACE_FILE_MAGIC ||
+        header.version != Z80_TRACE_FILE_VERSION ||
+        header.entry_size != sizeof(struct z80_trace_entry))
+    {
+        fprintf(stderr, "%s is not a version %d trace file\n", argv[1], Z80_TRACE_FILE_VERSION);
+        fclose(in);
+        return 1;
+    }
+
+    FILE *out = argc > 2 ? fopen(argv[2], "w") : stdout;
+    if (!out)
+    {
+        fprintf(stderr, "Failed to open output file: %s\n", argv[2]);
+        fclose(in);
+        return 1;
+    }
+
+    struct z80_trace_entry entry;
+    uint32_t decoded = 0;
+    while (decoded < header.count && fread(&entry, sizeof(entry), 1, in) == 1)
+    {
+        char text[96];
+        z80_dasm_format(entry.bytes, text, sizeof(text));
+        fprintf(out, "PC: %04X: %s \t SP:%04X CYC:%llu AF:%04X BC:%04X DE:%04X HL:%04X IX:%04X IY:%04X I:%02X R:%02X BANK:%04X\n",
+                entry.pc, text, entry.sp, (unsigned long long)entry.cycles,
+                entry.af, entry.bc, entry.de, entry.hl, entry.ix, entry.iy,
+                entry.i, entry.r, entry.bank);
+        decoded++;
+    }
+    if (decoded != header.count)
+    {
+        fprintf(stderr, "Trace truncated: %u of %u entries\n", decoded, header.count);
+    }
+
+    fclose(in);
+    if (out != stdout)
+    {
+        fclose(out);
+    }
+    return decoded == header.count ? 0 : 1;
+}
@@ -12,6 +12,9 @@
 #include "nuklear_sdl_renderer.h"
 #include "gui_styles.h"
 #include "gui_cpu_state.h"
+#include "gui_opcode_stats.h"
+#include "gui_watch.h"
+#include "gui_profile.h"
 #include "gui_menubar.h"
 #include "sms.h"
 
@@ -99,6 +102,9 @@ void gui_render(struct sms_t *sms, SDL_Renderer *renderer, SDL_Texture *emulator
     gui_render_menubar(ctx, sdl.win, sms);
 
     gui_render_cpu_state_window(ctx, &sms->cpu);
+    gui_render_opcode_stats_window(ctx, sms);
+    gui_render_watch_window(ctx, sms);
+    gui_render_profile_window(ctx, sms);
 
     // Memory viewer window
     if (gui.show_memory_viewer && nk_begin(ctx, "Memory Viewer", nk_rect(400, 200, 600, 400),
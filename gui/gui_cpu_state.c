@@ -221,6 +221,7 @@ void draw_z80_registers(struct nk_context *ctx, struct z80_t *cpu)
 
 void gui_render_cpu_state_window(struct nk_context *ctx, struct z80_t *cpu)
 {
+    z80_sync_flags(cpu);
     if (nk_begin(ctx,
                  "Z80 State",
                  nk_rect(600, 20, 200, 650),
@@ -263,6 +264,11 @@ void gui_render_cpu_state_window(struct nk_context *ctx, struct z80_t *cpu)
         nk_spacing(ctx, 1);
 
         draw_z80_registers(ctx, cpu);
+
+        // Cycles fast-forwarded through idle loops and slept in HALT for the current ROM
+        nk_layout_row_dynamic(ctx, 20.0f, 1);
+        nk_labelf(ctx, NK_TEXT_LEFT, "Idle: %llu cyc", (unsigned long long)cpu->idle_skipped);
+        nk_labelf(ctx, NK_TEXT_LEFT, "Halt: %llu cyc", (unsigned long long)cpu->halted_cycles);
     }
     nk_end(ctx);
 }
\ No newline at end of file
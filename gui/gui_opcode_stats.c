@@ -0,0 +1,93 @@
+#include <stdio.h>
+#include "nuklear.h"
+#include "sms.h"
+#include "z80_stats.h"
+#include "gui_opcode_stats.h"
+#include "gui_styles.h"
+
+#define TOP_ENTRIES 32
+
+static bool sort_by_cycles = false;
+
+static void draw_top_entries(struct nk_context *ctx, const struct z80_opcode_stats *stats)
+{
+    uint16_t top[TOP_ENTRIES];
+    int found = z80_stats_top(stats, sort_by_cycles, top, TOP_ENTRIES);
+
+    uint64_t total = 0;
+    const uint64_t *value = sort_by_cycles ? stats->cycles : stats->count;
+    for (int i = 0; i < Z80_STATS_ENTRIES; i++)
+    {
+        total += value[i];
+    }
+
+    float ratio[] = {0.3f, 0.25f, 0.3f, 0.15f}; // Opcode | Count | Cycles | Share
+    nk_layout_row(ctx, NK_DYNAMIC, 14, 4, ratio);
+    ctx->style.text.color = register_text_color;
+    nk_label(ctx, "Opcode", NK_TEXT_LEFT);
+    nk_label(ctx, "Count", NK_TEXT_RIGHT);
+    nk_label(ctx, "Cycles", NK_TEXT_RIGHT);
+    nk_label(ctx, "%", NK_TEXT_RIGHT);
+
+    char text[32];
+    for (int i = 0; i < found; i++)
+    {
+        uint16_t entry = top[i];
+        const char *prefix = z80_stats_prefix((enum z80_stats_page)(entry >> 8));
+
+        nk_layout_row(ctx, NK_DYNAMIC, 14, 4, ratio);
+        ctx->style.text.color = register_value_color;
+        snprintf(text, sizeof(text), "%s%s%02X", prefix, *prefix ? " " : "", entry & 0xFF);
+        nk_label(ctx, text, NK_TEXT_LEFT);
+
+        ctx->style.text.color = default_text_color;
+        snprintf(text, sizeof(text), "%llu", (unsigned long long)stats->count[entry]);
+        nk_label(ctx, text, NK_TEXT_RIGHT);
+        snprintf(text, sizeof(text), "%llu", (unsigned long long)stats->cycles[entry]);
+        nk_label(ctx, text, NK_TEXT_RIGHT);
+        snprintf(text, sizeof(text), "%.1f", total ? 100.0 * value[entry] / total : 0.0);
+        nk_label(ctx, text, NK_TEXT_RIGHT);
+    }
+}
+
+// Most executed opcodes, next to the Z80 State window
+void gui_render_opcode_stats_window(struct nk_context *ctx, struct sms_t *sms)
+{
+    if (nk_begin(ctx,
+                 "Opcode Stats",
+                 nk_rect(810, 20, 300, 650),
+                 NK_WINDOW_BORDER | NK_WINDOW_MOVABLE | NK_WINDOW_TITLE | NK_WINDOW_MINIMIZABLE))
+    {
+        if (!Z80_OPCODE_STATS)
+        {
+            nk_layout_row_dynamic(ctx, 20, 1);
+            nk_label(ctx, "Built without CASTER_OPCODE_STATS", NK_TEXT_LEFT);
+            nk_end(ctx);
+            return;
+        }
+
+        struct z80_opcode_stats *stats = sms->cpu.stats;
+
+        nk_layout_row_dynamic(ctx, 25, 3);
+        // Stopping writes the CSV, like the H key
+        if (nk_button_label(ctx, stats ? "Stop" : "Record"))
+        {
+            sms_toggle_opcode_stats(sms);
+            stats = sms->cpu.stats;
+        }
+        if (nk_button_label(ctx, "Reset") && stats)
+        {
+            z80_stats_reset(stats);
+        }
+        if (nk_button_label(ctx, sort_by_cycles ? "By cycles" : "By count"))
+        {
+            sort_by_cycles = !sort_by_cycles;
+        }
+
+        if (stats)
+        {
+            draw_top_entries(ctx, stats);
+        }
+    }
+    nk_end(ctx);
+}
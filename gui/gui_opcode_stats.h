@@ -0,0 +1,9 @@
+#ifndef GUI_OPCODE_STATS_H_
+#define GUI_OPCODE_STATS_H_
+
+struct sms_t;
+struct nk_context;
+
+void gui_render_opcode_stats_window(struct nk_context *ctx, struct sms_t *sms);
+
+#endif
@@ -0,0 +1,178 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "nuklear.h"
+#include "sms.h"
+#include "sms_profile.h"
+#include "gui_profile.h"
+
+#define HEATMAP_COLUMNS 64
+#define CELL_HEIGHT     4
+
+enum heatmap_kind
+{
+    HEATMAP_READS,
+    HEATMAP_WRITES,
+    HEATMAP_EXECUTES,
+    HEATMAP_ALL
+};
+
+static int shown_region = MMU_PROFILE_CARTRIDGE;
+static enum heatmap_kind shown_kind = HEATMAP_ALL;
+
+// Bytes per heatmap row: a bank of cartridge, 1KB of the RAMs
+static size_t row_bytes(int region)
+{
+    return region == MMU_PROFILE_CARTRIDGE ? SMS_PROFILE_BANK_SIZE : 0x400;
+}
+
+static uint64_t cell_value(const struct mmu_access_counts *counts, size_t first, size_t count)
+{
+    uint64_t value = 0;
+    for (size_t i = first; i < first + count; i++)
+    {
+        switch (shown_kind)
+        {
+        case HEATMAP_READS: value += counts[i].read; break;
+        case HEATMAP_WRITES: value += counts[i].write; break;
+        case HEATMAP_EXECUTES: value += counts[i].execute; break;
+        default: value += (uint64_t)counts[i].read + counts[i].write + counts[i].execute; break;
+        }
+    }
+    return value;
+}
+
+static int bit_length(uint64_t value)
+{
+    int bits = 0;
+    while (value)
+    {
+        bits++;
+        value >>= 1;
+    }
+    return bits;
+}
+
+// Black through red to yellow on a log2 scale, so cold tables still show
+static struct nk_color heat_color(uint64_t value, uint64_t max)
+{
+    if (!value)
+        return nk_rgb(0x10, 0x10, 0x10);
+    float heat = (float)bit_length(value) / bit_length(max);
+    if (heat < 0.5f)
+        return nk_rgb((nk_byte)(0x40 + heat * 2 * 0xBF), 0x00, 0x00);
+    return nk_rgb(0xFF, (nk_byte)((heat - 0.5f) * 2 * 0xFF), 0x00);
+}
+
+// One cell per row_bytes / HEATMAP_COLUMNS bytes, hovering a cell tells
+// where it is and its count
+static void draw_heatmap(struct nk_context *ctx, const struct sms_profile *profile)
+{
+    static uint64_t *cells = NULL;
+    static size_t cells_size = 0;
+
+    size_t size;
+    const struct mmu_access_counts *counts = sms_profile_region(profile, shown_region, &size);
+    size_t cell_bytes = row_bytes(shown_region) / HEATMAP_COLUMNS;
+    size_t cell_count = size / cell_bytes;
+    if (cell_count == 0)
+        return;
+    if (cell_count > cells_size)
+    {
+        uint64_t *grown = realloc(cells, cell_count * sizeof(*cells));
+        if (!grown)
+            return;
+        cells = grown;
+        cells_size = cell_count;
+    }
+
+    uint64_t max = 0;
+    for (size_t i = 0; i < cell_count; i++)
+    {
+        cells[i] = cell_value(counts, i * cell_bytes, cell_bytes);
+        if (cells[i] > max)
+            max = cells[i];
+    }
+
+    size_t rows = cell_count / HEATMAP_COLUMNS;
+    struct nk_rect bounds;
+    nk_layout_row_dynamic(ctx, (float)(rows * CELL_HEIGHT), 1);
+    if (!nk_widget(&bounds, ctx))
+        return;
+
+    struct nk_command_buffer *canvas = nk_window_get_canvas(ctx);
+    float cell_width = bounds.w / HEATMAP_COLUMNS;
+    for (size_t i = 0; i < cell_count; i++)
+    {
+        struct nk_rect cell = nk_rect(bounds.x + (i % HEATMAP_COLUMNS) * cell_width,
+                                      bounds.y + (i / HEATMAP_COLUMNS) * CELL_HEIGHT,
+                                      cell_width, CELL_HEIGHT);
+        nk_fill_rect(canvas, cell, 0, heat_color(cells[i], max));
+    }
+
+    if (nk_input_is_mouse_hovering_rect(&ctx->input, bounds))
+    {
+        size_t column = (size_t)((ctx->input.mouse.pos.x - bounds.x) / cell_width);
+        size_t row = (size_t)((ctx->input.mouse.pos.y - bounds.y) / CELL_HEIGHT);
+        size_t cell = row * HEATMAP_COLUMNS + (column < HEATMAP_COLUMNS ? column : HEATMAP_COLUMNS - 1);
+        if (cell < cell_count)
+        {
+            char text[64];
+            size_t offset = cell * cell_bytes;
+            snprintf(text, sizeof(text), "Bank %02zX %04zX-%04zX: %llu",
+                     offset / SMS_PROFILE_BANK_SIZE, offset % SMS_PROFILE_BANK_SIZE,
+                     offset % SMS_PROFILE_BANK_SIZE + cell_bytes - 1, (unsigned long long)cells[cell]);
+            nk_tooltip(ctx, text);
+        }
+    }
+}
+
+// Per-byte access heatmap of the region picked, next to the Watchpoints
+// window
+void gui_render_profile_window(struct nk_context *ctx, struct sms_t *sms)
+{
+    if (nk_begin(ctx,
+                 "Access Heatmap",
+                 nk_rect(1430, 20, 330, 650),
+                 NK_WINDOW_BORDER | NK_WINDOW_MOVABLE | NK_WINDOW_TITLE | NK_WINDOW_MINIMIZABLE))
+    {
+        struct sms_profile *profile = sms->profile;
+
+        nk_layout_row_dynamic(ctx, 25, 2);
+        // Stopping writes the CSV and binary dumps, like the M key
+        if (nk_button_label(ctx, profile ? "Stop" : "Record"))
+        {
+            sms_toggle_profile(sms);
+            profile = sms->profile;
+        }
+        if (nk_button_label(ctx, "Reset") && profile)
+        {
+            sms_profile_reset(profile);
+        }
+
+        nk_layout_row_dynamic(ctx, 20, 4);
+        if (nk_option_label(ctx, "ROM", shown_region == MMU_PROFILE_CARTRIDGE))
+            shown_region = MMU_PROFILE_CARTRIDGE;
+        if (nk_option_label(ctx, "SRAM", shown_region == MMU_PROFILE_CARTRIDGE_RAM))
+            shown_region = MMU_PROFILE_CARTRIDGE_RAM;
+        if (nk_option_label(ctx, "RAM", shown_region == MMU_PROFILE_SYSTEM_RAM))
+            shown_region = MMU_PROFILE_SYSTEM_RAM;
+        if (nk_option_label(ctx, "VRAM", shown_region == SMS_PROFILE_VRAM))
+            shown_region = SMS_PROFILE_VRAM;
+
+        nk_layout_row_dynamic(ctx, 20, 4);
+        if (nk_option_label(ctx, "All", shown_kind == HEATMAP_ALL))
+            shown_kind = HEATMAP_ALL;
+        if (nk_option_label(ctx, "R", shown_kind == HEATMAP_READS))
+            shown_kind = HEATMAP_READS;
+        if (nk_option_label(ctx, "W", shown_kind == HEATMAP_WRITES))
+            shown_kind = HEATMAP_WRITES;
+        if (nk_option_label(ctx, "X", shown_kind == HEATMAP_EXECUTES))
+            shown_kind = HEATMAP_EXECUTES;
+
+        if (profile)
+        {
+            draw_heatmap(ctx, profile);
+        }
+    }
+    nk_end(ctx);
+}
@@ -0,0 +1,9 @@
+#ifndef GUI_PROFILE_H_
+#define GUI_PROFILE_H_
+
+struct sms_t;
+struct nk_context;
+
+void gui_render_profile_window(struct nk_context *ctx, struct sms_t *sms);
+
+#endif
@@ -0,0 +1,137 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "nuklear.h"
+#include "sms.h"
+#include "gui_watch.h"
+#include "gui_styles.h"
+
+#define SHOWN_HITS 32
+
+static char start_text[5] = "C000";
+static int start_len = 4;
+static char end_text[5] = "C0FF";
+static int end_len = 4;
+static nk_bool watch_read = nk_false;
+static nk_bool watch_write = nk_true;
+static nk_bool watch_execute = nk_false;
+
+static const char *kind_name(uint8_t kinds, char *text)
+{
+    text[0] = (kinds & MMU_WATCH_READ) ? 'R' : '-';
+    text[1] = (kinds & MMU_WATCH_WRITE) ? 'W' : '-';
+    text[2] = (kinds & MMU_WATCH_EXECUTE) ? 'X' : '-';
+    text[3] = '\0';
+    return text;
+}
+
+static uint16_t parse_hex(const char *text, int len)
+{
+    char buffer[5] = {0};
+    for (int i = 0; i < len && i < 4; i++)
+    {
+        buffer[i] = text[i];
+    }
+    return (uint16_t)strtoul(buffer, NULL, 16);
+}
+
+static void draw_add_row(struct nk_context *ctx, struct sms_t *sms)
+{
+    nk_layout_row_dynamic(ctx, 25, 2);
+    nk_edit_string(ctx, NK_EDIT_FIELD, start_text, &start_len, 5, nk_filter_hex);
+    nk_edit_string(ctx, NK_EDIT_FIELD, end_text, &end_len, 5, nk_filter_hex);
+
+    nk_layout_row_dynamic(ctx, 25, 4);
+    nk_checkbox_label(ctx, "R", &watch_read);
+    nk_checkbox_label(ctx, "W", &watch_write);
+    nk_checkbox_label(ctx, "X", &watch_execute);
+    if (nk_button_label(ctx, "Add"))
+    {
+        uint8_t kinds = (watch_read ? MMU_WATCH_READ : 0) |
+                        (watch_write ? MMU_WATCH_WRITE : 0) |
+                        (watch_execute ? MMU_WATCH_EXECUTE : 0);
+        uint16_t start = parse_hex(start_text, start_len);
+        uint16_t end = end_len ? parse_hex(end_text, end_len) : start;
+        if (sms_add_watchpoint(sms, start, end, kinds) < 0)
+        {
+            printf("Couldn't watch %04X-%04X\n", start, end);
+        }
+    }
+}
+
+static void draw_watchpoints(struct nk_context *ctx, struct sms_t *sms, const struct mmu_watch *watch)
+{
+    char text[32];
+    char kinds[4];
+
+    for (int i = 0; i < watch->count; i++)
+    {
+        const struct mmu_watchpoint *point = &watch->points[i];
+        nk_layout_row_dynamic(ctx, 20, 2);
+        ctx->style.text.color = register_value_color;
+        snprintf(text, sizeof(text), "%04X-%04X %s", point->start, point->end, kind_name(point->kinds, kinds));
+        nk_label(ctx, text, NK_TEXT_LEFT);
+        if (nk_button_label(ctx, "Remove"))
+        {
+            sms_remove_watchpoint(sms, i);
+            break;
+        }
+    }
+}
+
+// Latest hits first
+static void draw_hits(struct nk_context *ctx, const struct mmu_watch *watch)
+{
+    float ratio[] = {0.35f, 0.2f, 0.1f, 0.2f, 0.15f}; // Cycles | PC | Kind | Addr | Value
+    nk_layout_row(ctx, NK_DYNAMIC, 14, 5, ratio);
+    ctx->style.text.color = register_text_color;
+    nk_label(ctx, "Cycles", NK_TEXT_LEFT);
+    nk_label(ctx, "PC", NK_TEXT_LEFT);
+    nk_label(ctx, "", NK_TEXT_LEFT);
+    nk_label(ctx, "Addr", NK_TEXT_LEFT);
+    nk_label(ctx, "Val", NK_TEXT_RIGHT);
+
+    uint32_t shown = watch->hits < SHOWN_HITS ? watch->hits : SHOWN_HITS;
+    char text[32];
+    ctx->style.text.color = default_text_color;
+    for (uint32_t i = 0; i < shown; i++)
+    {
+        const struct mmu_watch_hit *hit = &watch->log[(watch->hits - 1 - i) & (MMU_WATCH_LOG_SIZE - 1)];
+
+        nk_layout_row(ctx, NK_DYNAMIC, 14, 5, ratio);
+        snprintf(text, sizeof(text), "%llu", (unsigned long long)hit->cycles);
+        nk_label(ctx, text, NK_TEXT_LEFT);
+        snprintf(text, sizeof(text), "%04X", hit->pc);
+        nk_label(ctx, text, NK_TEXT_LEFT);
+        nk_label(ctx, hit->kind == MMU_WATCH_READ ? "R" : hit->kind == MMU_WATCH_WRITE ? "W" : "X", NK_TEXT_LEFT);
+        snprintf(text, sizeof(text), "%04X", hit->addr);
+        nk_label(ctx, text, NK_TEXT_LEFT);
+        snprintf(text, sizeof(text), "%02X", hit->value);
+        nk_label(ctx, text, NK_TEXT_RIGHT);
+    }
+}
+
+// Watchpoints and their latest hits, next to the Opcode Stats window
+void gui_render_watch_window(struct nk_context *ctx, struct sms_t *sms)
+{
+    if (nk_begin(ctx,
+                 "Watchpoints",
+                 nk_rect(1120, 20, 300, 650),
+                 NK_WINDOW_BORDER | NK_WINDOW_MOVABLE | NK_WINDOW_TITLE | NK_WINDOW_MINIMIZABLE))
+    {
+        draw_add_row(ctx, sms);
+
+        const struct mmu_watch *watch = sms->mem.watch;
+        if (watch)
+        {
+            draw_watchpoints(ctx, sms, watch);
+
+            nk_layout_row_dynamic(ctx, 20, 1);
+            ctx->style.text.color = register_text_color;
+            char text[32];
+            snprintf(text, sizeof(text), "Hits: %u", watch->hits);
+            nk_label(ctx, text, NK_TEXT_LEFT);
+            draw_hits(ctx, watch);
+        }
+    }
+    nk_end(ctx);
+}
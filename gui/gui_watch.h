@@ -0,0 +1,9 @@
+#ifndef GUI_WATCH_H_
+#define GUI_WATCH_H_
+
+struct sms_t;
+struct nk_context;
+
+void gui_render_watch_window(struct nk_context *ctx, struct sms_t *sms);
+
+#endif
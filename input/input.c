@@ -43,6 +43,7 @@ static const key_mapping_t default_key_map[] =
 static const size_t key_map_size = sizeof(default_key_map) / sizeof(default_key_map[0]);
 static uint8_t button_states[SMS_BUTTON_COUNT] = {0};
 static sms_controller_t controller[2] = {0xFF};
+static uint8_t io_control = 0xFF;       // every line an input
 
 void input_init(void)
 {
@@ -72,9 +73,23 @@ void input_handle_event(struct sms_t *sms, SDL_Keycode key, bool pressed)
     controller[0].button_start = !button_states[SMS_BUTTON_START];
 }
 
+// The TH lines (port B bits 6 and 7) that the I/O control port set as
+// outputs read back the level written there, which is how games tell an
+// export console from a Japanese one
+static uint8_t io_th_lines(uint8_t value)
+{
+    if (!(io_control & 0x02))   // port A TH
+        value = (value & ~0x40) | ((io_control & 0x20) << 1);
+    if (!(io_control & 0x08))   // port B TH
+        value = (value & ~0x80) | (io_control & 0x80);
+    return value;
+}
+
+// Pad ports A and B, on all their mirrors (see sms_ports.c)
 uint8_t input_port_read(struct sms_t *sms, uint8_t port)
 {
-    switch (port)
+    (void)sms;
+    switch ((port & SMS_PORT_DECODE_MASK) | (SMS_PORT_IO_A & ~SMS_PORT_DECODE_MASK))
     {
     case SMS_PORT_IO_A:                           // 0xDE - Controller 1 + Controller 2 fire buttons
         return (controller[1].button_2 << 7 |     // Controller 2 Button 2
@@ -87,16 +102,31 @@ uint8_t input_port_read(struct sms_t *sms, uint8_t port)
                 controller[0].button_up << 0);    // Controller 1 Up
 
     case SMS_PORT_IO_B:                           // 0xDD - Controller 2 directions + system bits
-        return (0x1 << 7 |                        
-                controller[0].button_start << 6 | // Pause button
-                0x1 << 5 |                        
-                0x1 << 4 |                        // Reset bit
-                controller[1].button_right << 3 | // Controller 2 Right
-                controller[1].button_left << 2 |  // Controller 2 Left
-                controller[1].button_down << 1 |  // Controller 2 Down
-                controller[1].button_up << 0);    // Controller 2 Up
+        return io_th_lines(0x1 << 7 |                        
+                           controller[0].button_start << 6 | // Pause button
+                           0x1 << 5 |                        
+                           0x1 << 4 |                        // Reset bit
+                           controller[1].button_right << 3 | // Controller 2 Right
+                           controller[1].button_left << 2 |  // Controller 2 Left
+                           controller[1].button_down << 1 |  // Controller 2 Down
+                           controller[1].button_up << 0);    // Controller 2 Up
 
     default:
         return 0xFF;
     }
-}
\ No newline at end of file
+}
+
+// I/O control port (0x3F): direction and output level of the TR and TH lines
+static void input_io_control_write(struct sms_t *sms, uint8_t port, uint8_t value)
+{
+    (void)sms;
+    (void)port;
+    io_control = value;
+}
+
+void input_register_ports(struct sms_t *sms)
+{
+    sms_map_port_read(sms, SMS_PORT_IO_A, input_port_read);
+    sms_map_port_read(sms, SMS_PORT_IO_B, input_port_read);
+    sms_map_port_write(sms, SMS_PORT_IO_CONTROL, input_io_control_write);
+}
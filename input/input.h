@@ -9,6 +9,7 @@ void input_init(void);
 void input_cleanup(void);
 void input_handle_event(struct sms_t *sms, SDL_Keycode key, bool pressed);
 uint8_t input_port_read(struct sms_t *sms, uint8_t port);
+void input_register_ports(struct sms_t *sms);
 
 // // Input mapping functions
 // void input_map_controller_buttons(struct sms_t *sms);
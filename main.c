@@ -1,6 +1,7 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdint.h>
+#include <string.h>
 #include "core/sms.h"
 #include "input/input.h"
 #include <SDL3/SDL.h>
@@ -19,10 +20,38 @@ int main(int argc, char* argv[])
     sms_init(&sms);
     sms_create(&sms);
 
+    // Command line: [--jit | --jit-verify] [--mapper name] [rom]
+    const char *filename = NULL;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--jit") == 0)
+        {
+            sms_enable_jit(&sms, false);
+        }
+        else if (strcmp(argv[i], "--jit-verify") == 0)
+        {
+            sms_enable_jit(&sms, true);
+        }
+        else if (strcmp(argv[i], "--mapper") == 0 && i + 1 < argc)
+        {
+            // Cartridge board to use instead of detecting it
+            const char *name = argv[++i];
+            enum mmu_mapper_type mapper = mmu_mapper_from_name(name);
+            if (mapper == MMU_MAPPER_AUTO && strcmp(name, "auto") != 0)
+            {
+                printf("Unknown mapper '%s', detecting it from the ROM\n", name);
+            }
+            mmu_set_mapper_override(&sms.mem, mapper);
+        }
+        else
+        {
+            filename = argv[i];
+        }
+    }
+
     // Load ROM if provided via command line
-    if (argc >= 2)
+    if (filename)
     {
-        const char *filename = argv[1];
         if (!sms_load_rom_file(&sms, filename))
         {
             SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Error", "Failed to load ROM file", NULL);
@@ -50,7 +79,21 @@ int main(int argc, char* argv[])
                 }
                 else if (event.key.key == SDLK_D)
                 {
-                    sms.cpu.debug = !sms.cpu.debug;
+                    // Binary trace at close to full speed; written out when
+                    // toggled off or when the CPU stops
+                    sms_toggle_trace(&sms);
+                }
+                else if (event.key.key == SDLK_H)
+                {
+                    // Opcode histogram, written out as CSV when toggled off
+                    // or on exit
+                    sms_toggle_opcode_stats(&sms);
+                }
+                else if (event.key.key == SDLK_M)
+                {
+                    // Memory access heatmap, written out as CSV and binary
+                    // when toggled off, on exit or when the ROM changes
+                    sms_toggle_profile(&sms);
                 }
                 else if (event.key.key == SDLK_P)
                 {
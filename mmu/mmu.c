@@ -1,59 +1,137 @@
 #include "mmu.h"
 #include <string.h>
 #include <stdlib.h>
+#include <stdbool.h>
+#include <stdio.h>
 
-#define SMS_MEM_SIZE 0x10000       // 64KB
-#define SMS_PAGE_SIZE 0x4000       // 16KB
-#define SMS_SYSTEM_RAM_SIZE 0x2000 // 8KB
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#else
+#include <sys/mman.h>
+#endif
 
-static void mmu_load_page(struct mmu_t *mem, uint8_t page, uint8_t slot)
+typedef char mmu_dirty_bits_fit[MMU_CARTRIDGE_RAM_PAGES <= 32 ? 1 : -1];
+typedef char mmu_ram_banks_fit[MMU_BANK_CARTRIDGE_RAM + MMU_CARTRIDGE_RAM_PAGES <= Z80_BANK_RAM ? 1 : -1];
+
+// What a page shows for a bank past the end of the cartridge (or with no
+// cartridge at all)
+static uint8_t mmu_open_bus[MMU_SLOT_SIZE];
+
+// Host memory of ROM bank number bank, banks being size bytes
+static uint8_t *mmu_rom_bank(struct mmu_t *mem, uint8_t bank, size_t size)
+{
+    if ((bank + 1) * size > mem->cartridge_banks * MMU_SLOT_SIZE)
+    {
+        return mmu_open_bus;
+    }
+    return mem->cartridge + bank * size;
+}
+
+// Set what a page really maps to. A page trapped for the access (by a
+// watchpoint or the profiler) is published as NULL so the Z80 comes through
+// mmu_read8/mmu_write8 for it; every other page keeps its direct pointer.
+static void mmu_set_read_page(struct mmu_t *mem, int page, uint8_t *host)
+{
+    mem->host_read_pages[page] = host;
+    mem->read_pages[page] = (mem->trapped_pages[page] & MMU_WATCH_READ) ? NULL : host;
+}
+
+static void mmu_set_write_page(struct mmu_t *mem, int page, uint8_t *host)
 {
-    uint32_t cart_offset = page * SMS_PAGE_SIZE;
-    uint16_t memory_offset = slot * SMS_PAGE_SIZE;
+    mem->host_write_pages[page] = host;
+    mem->write_pages[page] = (mem->trapped_pages[page] & MMU_WATCH_WRITE) ? NULL : host;
+}
 
-    // Check if page exists in cartridge
-    if (cart_offset >= mem->cartridge_size)
+// Work out which pages watchpoints and the profiler trap, and republish
+// every page
+static void mmu_trap_pages(struct mmu_t *mem)
+{
+    for (int page = 0; page < Z80_PAGE_COUNT; page++)
     {
-        // Page doesn't exist, fill with 0xFF or handle as needed
-        memset(mem->memory + memory_offset, 0xFF, SMS_PAGE_SIZE);
-        return;
+        mem->trapped_pages[page] = mem->watch ? mem->watch->pages[page] : 0;
+        if (mem->profile)
+            mem->trapped_pages[page] |= MMU_WATCH_READ | MMU_WATCH_WRITE;
+        mmu_set_read_page(mem, page, mem->host_read_pages[page]);
+        mmu_set_write_page(mem, page, mem->host_write_pages[page]);
     }
+}
 
-    if (slot == 0)
+// Show size bytes of host memory from base at Z80 address addr on. A bank
+// switch is just this: a pointer per page, no copying. bank goes into
+// page_banks to key the blocks decoded from these pages.
+static void mmu_map(struct mmu_t *mem, uint16_t addr, size_t size, uint8_t *base, uint16_t bank)
+{
+    for (size_t offset = 0; offset < size; offset += Z80_PAGE_SIZE)
     {
-        // For slot 0, only load bytes 0x400-0x3FFF (preserve first 1KB)
-        uint32_t copy_size = SMS_PAGE_SIZE - 0x400;
-        if (cart_offset + 0x400 + copy_size > mem->cartridge_size)
-        {
-            copy_size = mem->cartridge_size - (cart_offset + 0x400);
-        }
+        int page = (addr + offset) >> Z80_PAGE_SHIFT;
+        mmu_set_read_page(mem, page, base + offset);
+        mem->page_banks[page] = bank;
+    }
+}
+
+// size bytes of cartridge RAM from offset on at addr, each page with a
+// bank id of its own
+static void mmu_map_cartridge_ram(struct mmu_t *mem, uint16_t addr, size_t size, size_t offset)
+{
+    for (size_t page = 0; page < size; page += Z80_PAGE_SIZE)
+    {
+        mmu_map(mem, addr + page, Z80_PAGE_SIZE, mem->cartridge_ram + offset + page,
+                MMU_BANK_CARTRIDGE_RAM + ((offset + page) >> Z80_PAGE_SHIFT));
+    }
+}
+
+// Whether a page of the cartridge area shows cartridge RAM
+static bool mmu_is_cartridge_ram(struct mmu_t *mem, int page)
+{
+    uint16_t bank = mem->page_banks[page];
+    return bank >= MMU_BANK_CARTRIDGE_RAM && bank < MMU_BANK_CARTRIDGE_RAM + MMU_CARTRIDGE_RAM_PAGES;
+}
 
-        memcpy(mem->memory + memory_offset + 0x400,
-               mem->cartridge + cart_offset + 0x400,
-               copy_size);
+// One 16KB slot showing a ROM bank
+static void mmu_map_rom_slot(struct mmu_t *mem, int slot, uint8_t bank)
+{
+    mmu_map(mem, slot * MMU_SLOT_SIZE, MMU_SLOT_SIZE, mmu_rom_bank(mem, bank, MMU_SLOT_SIZE), bank);
+}
+
+// Cartridge mappers. Each one sets its power-on registers (reset), maps the
+// cartridge area 0x0000-0xBFFF from its registers (map), and is handed the
+// writes the shared path in mmu_write8 can't complete itself: ROM area
+// writes and the 0xFFFC-0xFFFF RAM mirror (write). Cartridge RAM is mapped
+// with mmu_map_cartridge_ram() and written by the shared path.
+struct mmu_mapper
+{
+    const char *name;
+    void (*reset)(struct mmu_t *mem);
+    void (*map)(struct mmu_t *mem);
+    void (*write)(struct mmu_t *mem, uint16_t addr, uint8_t data);
+};
+
+// Sega: 0xFFFD-0xFFFF select the banks of slots 0-2, the first 1KB stays
+// on bank 0. 0xFFFC bit 3 puts cartridge RAM in slot 2, bit 2 picks which
+// 16KB of it.
+static void mmu_sega_map_slot(struct mmu_t *mem, int slot)
+{
+    uint8_t bank = mem->page_registers[slot];
+
+    if (slot == 2 && mem->cartridge_ram_enabled)
+    {
+        mmu_map_cartridge_ram(mem, 0x8000, MMU_SLOT_SIZE, mem->cartridge_ram_page * MMU_SLOT_SIZE);
+    }
+    else if (slot == 0)
+    {
+        uint8_t *rom = mmu_rom_bank(mem, bank, MMU_SLOT_SIZE);
+        mmu_map(mem, 0x0000, MMU_FIXED_SIZE, mmu_rom_bank(mem, 0, MMU_SLOT_SIZE), 0);
+        mmu_map(mem, MMU_FIXED_SIZE, MMU_SLOT_SIZE - MMU_FIXED_SIZE, rom + MMU_FIXED_SIZE, bank);
     }
     else
     {
-        // For other slots, load the entire page
-        uint32_t copy_size = SMS_PAGE_SIZE;
-        if (cart_offset + copy_size > mem->cartridge_size)
-        {
-            copy_size = mem->cartridge_size - cart_offset;
-        }
-
-        memcpy(mem->memory + memory_offset,
-               mem->cartridge + cart_offset,
-               copy_size);
+        mmu_map_rom_slot(mem, slot, bank);
     }
 }
 
-void mmu_init(struct mmu_t *mem)
+static void mmu_sega_reset(struct mmu_t *mem)
 {
-    memset(mem->memory, 0, SMS_MEM_SIZE);
-    memset(mem->system_ram, 0, SMS_SYSTEM_RAM_SIZE);
-
-    mem->cartridge = NULL;
-    mem->cartridge_size = 0;
     mem->control_register = 0;
     mem->cartridge_ram_enabled = false;
     mem->cartridge_ram_page = 0;
@@ -62,148 +140,671 @@ void mmu_init(struct mmu_t *mem)
     mem->page_registers[2] = 2;
 }
 
-void mmu_deinit(struct mmu_t *mem)
+static void mmu_sega_map(struct mmu_t *mem)
 {
-    if (mem->cartridge)
+    for (int slot = 0; slot < MMU_SLOT_COUNT; slot++)
     {
-        free(mem->cartridge);
-        mem->cartridge = NULL;
+        mmu_sega_map_slot(mem, slot);
     }
 }
 
-void mmu_load_rom(struct mmu_t *mem, const uint8_t *data, size_t len)
+static void mmu_sega_write(struct mmu_t *mem, uint16_t addr, uint8_t data)
 {
-    if (mem->cartridge)
+    switch (addr)
     {
-        free(mem->cartridge);
+    case 0xFFFC:
+        mem->control_register = data;
+        mem->cartridge_ram_enabled = (data & 0x08) != 0;
+        mem->cartridge_ram_page = (data & 0x04) != 0;
+        mmu_sega_map_slot(mem, 2);
+        break;
+
+    case 0xFFFD:
+    case 0xFFFE:
+    case 0xFFFF:
+        mem->page_registers[addr - 0xFFFD] = data;
+        mmu_sega_map_slot(mem, addr - 0xFFFD);
+        break;
     }
+}
 
-    mem->cartridge = malloc(len);
-    memcpy(mem->cartridge, data, len);
-    mem->cartridge_size = len;
+// Codemasters: writes to 0x0000, 0x4000 and 0x8000 select the banks of
+// slots 0-2, with no fixed first 1KB. Bit 7 of the slot 1 register puts
+// 8KB of cartridge RAM at 0xA000-0xBFFF.
+static void mmu_codemasters_map_slot(struct mmu_t *mem, int slot)
+{
+    mmu_map_rom_slot(mem, slot, mem->page_registers[slot]);
+    if (slot == 2 && mem->cartridge_ram_enabled)
+    {
+        mmu_map_cartridge_ram(mem, 0xA000, 0x2000, 0);
+    }
+}
+
+static void mmu_codemasters_reset(struct mmu_t *mem)
+{
+    mem->cartridge_ram_enabled = false;
+    mem->page_registers[0] = 0;
+    mem->page_registers[1] = 1;
+    mem->page_registers[2] = 0;
+}
+
+static void mmu_codemasters_map(struct mmu_t *mem)
+{
+    for (int slot = 0; slot < MMU_SLOT_COUNT; slot++)
+    {
+        mmu_codemasters_map_slot(mem, slot);
+    }
+}
 
-    // Load first 1KB (fixed area - interrupt vectors, etc.)
-    memcpy(mem->memory, mem->cartridge, 0x400);
+static void mmu_codemasters_write(struct mmu_t *mem, uint16_t addr, uint8_t data)
+{
+    switch (addr)
+    {
+    case 0x0000:
+    case 0x8000:
+        mem->page_registers[addr >> 14] = data;
+        mmu_codemasters_map_slot(mem, addr >> 14);
+        break;
 
-    // Load the first three pages
-    mmu_load_page(mem, 0, 0);
-    mmu_load_page(mem, 1, 1);
-    mmu_load_page(mem, 2, 2);
+    case 0x4000:
+        mem->page_registers[1] = data & 0x7F;
+        mem->cartridge_ram_enabled = (data & 0x80) != 0;
+        mmu_codemasters_map_slot(mem, 1);
+        mmu_codemasters_map_slot(mem, 2);
+        break;
+    }
 }
 
-uint8_t mmu_read8(struct mmu_t *mem, uint16_t addr)
+// Korean: slots 0 and 1 are fixed to banks 0 and 1, writes to 0xA000
+// select the bank of slot 2
+static void mmu_korean_reset(struct mmu_t *mem)
+{
+    mem->page_registers[2] = 2;
+}
+
+static void mmu_korean_map(struct mmu_t *mem)
+{
+    mmu_map_rom_slot(mem, 0, 0);
+    mmu_map_rom_slot(mem, 1, 1);
+    mmu_map_rom_slot(mem, 2, mem->page_registers[2]);
+}
+
+static void mmu_korean_write(struct mmu_t *mem, uint16_t addr, uint8_t data)
 {
-    switch (addr & 0xE000)
+    if (addr == 0xA000)
     {
-    case 0x0000: // 0x0000-0x1FFF: ROM Page 0
-    case 0x2000: // 0x2000-0x3FFF: ROM Page 0
-    case 0x4000: // 0x4000-0x5FFF: ROM Page 1
-    case 0x6000: // 0x6000-0x7FFF: ROM Page 1
-        return mem->memory[addr];
-    case 0x8000: // 0x8000-0x9FFF: ROM Page 2 or Cartridge RAM
-    case 0xA000: // 0xA000-0xBFFF: ROM Page 2 or Cartridge RAM
-        return mem->memory[addr];
+        mem->page_registers[2] = data;
+        mmu_map_rom_slot(mem, 2, data);
+    }
+}
 
-    case 0xC000: // 0xC000-0xDFFF: System RAM
-        return mem->system_ram[addr & 0x1FFF];
+// Korean 8KB (MSX style): 0x0000-0x3FFF is fixed to the first 16KB, writes
+// to 0x0000-0x0003 select the 8KB banks shown at 0x8000, 0xA000, 0x4000 and
+// 0x6000. Their page_banks are tagged MMU_BANK_8K so a decoded block is
+// never taken for one of a 16KB bank with the same number.
+static const uint16_t mmu_korean_8k_addr[4] = {0x8000, 0xA000, 0x4000, 0x6000};
+
+static void mmu_korean_8k_map_page(struct mmu_t *mem, int reg)
+{
+    uint8_t bank = mem->page_registers[reg];
+    mmu_map(mem, mmu_korean_8k_addr[reg], 0x2000, mmu_rom_bank(mem, bank, 0x2000), MMU_BANK_8K | bank);
+}
 
-    case 0xE000: // 0xE000-0xFFFF: Mirror of System RAM
-        return mem->system_ram[addr & 0x1FFF];
+static void mmu_korean_8k_reset(struct mmu_t *mem)
+{
+    memset(mem->page_registers, 0, sizeof(mem->page_registers));
+}
 
-    default:
-        return 0xFF;
+static void mmu_korean_8k_map(struct mmu_t *mem)
+{
+    mmu_map_rom_slot(mem, 0, 0);
+    for (int reg = 0; reg < 4; reg++)
+    {
+        mmu_korean_8k_map_page(mem, reg);
     }
 }
 
-uint16_t mmu_read16(struct mmu_t *mem, uint16_t addr)
+static void mmu_korean_8k_write(struct mmu_t *mem, uint16_t addr, uint8_t data)
 {
-    uint8_t low = mmu_read8(mem, addr);
-    uint8_t high = mmu_read8(mem, addr + 1);
-    return (high << 8) | low;
+    if (addr < 4)
+    {
+        mem->page_registers[addr] = data;
+        mmu_korean_8k_map_page(mem, addr);
+    }
 }
 
-void mmu_write8(struct mmu_t *mem, uint16_t addr, uint8_t data)
+static const struct mmu_mapper mmu_mappers[MMU_MAPPER_COUNT] =
+{
+    [MMU_MAPPER_SEGA]        = {"sega", mmu_sega_reset, mmu_sega_map, mmu_sega_write},
+    [MMU_MAPPER_CODEMASTERS] = {"codemasters", mmu_codemasters_reset, mmu_codemasters_map, mmu_codemasters_write},
+    [MMU_MAPPER_KOREAN]      = {"korean", mmu_korean_reset, mmu_korean_map, mmu_korean_write},
+    [MMU_MAPPER_KOREAN_8K]   = {"korean8k", mmu_korean_8k_reset, mmu_korean_8k_map, mmu_korean_8k_write},
+};
+
+const char *mmu_mapper_name(enum mmu_mapper_type type)
 {
-    switch (addr & 0xE000)
+    return type > MMU_MAPPER_AUTO && type < MMU_MAPPER_COUNT ? mmu_mappers[type].name : "auto";
+}
+
+// MMU_MAPPER_AUTO for "auto" or a name no mapper has
+enum mmu_mapper_type mmu_mapper_from_name(const char *name)
+{
+    for (int type = MMU_MAPPER_AUTO + 1; type < MMU_MAPPER_COUNT; type++)
     {
-    case 0x0000: // 0x0000-0x1FFF: ROM Page 0 (read-only)
-    case 0x2000: // 0x2000-0x3FFF: ROM Page 0 (read-only)
-    case 0x4000: // 0x4000-0x5FFF: ROM Page 1 (read-only)
-    case 0x6000: // 0x6000-0x7FFF: ROM Page 1 (read-only)
-        // ROM is read-only, ignore writes
-        return;
+        if (strcmp(name, mmu_mappers[type].name) == 0)
+            return (enum mmu_mapper_type)type;
+    }
+    return MMU_MAPPER_AUTO;
+}
+
+// Mapper to use for the next cartridge, MMU_MAPPER_AUTO to detect it
+void mmu_set_mapper_override(struct mmu_t *mem, enum mmu_mapper_type type)
+{
+    mem->mapper_override = type;
+}
+
+// Korean boards have no header to tell them by, so known dumps are looked
+// up by the CRC-32 of the whole image
+static const struct
+{
+    uint32_t crc;
+    enum mmu_mapper_type mapper;
+} mmu_known_roms[] =
+{
+    {0x89B79E77, MMU_MAPPER_KOREAN},     // Dodgeball King
+    {0x929222C4, MMU_MAPPER_KOREAN},     // Jang Pung II
+    {0x18FB98A3, MMU_MAPPER_KOREAN},     // Jang Pung 3
+    {0x97D03541, MMU_MAPPER_KOREAN},     // Sangokushi 3
+    {0x9195C34C, MMU_MAPPER_KOREAN},     // Super Boy 3
+    {0x77EFE84A, MMU_MAPPER_KOREAN_8K},  // Cyborg Z
+    {0x06965ED9, MMU_MAPPER_KOREAN_8K},  // F-1 Spirit
+    {0xF89AF3CC, MMU_MAPPER_KOREAN_8K},  // Knightmare II: The Maze of Galious
+    {0x0A77FA5E, MMU_MAPPER_KOREAN_8K},  // Nemesis 2
+    {0x445525E2, MMU_MAPPER_KOREAN_8K},  // Penguin Adventure
+    {0x83F0EEDE, MMU_MAPPER_KOREAN_8K},  // Street Master
+    {0xA05258F5, MMU_MAPPER_KOREAN_8K},  // Won-Si-In
+};
+
+// CRC-32 (zlib polynomial) of a ROM image, four bits at a time
+static uint32_t mmu_crc32(const uint8_t *data, size_t len)
+{
+    static const uint32_t nibble[16] =
+    {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+    };
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < len; i++)
+    {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ nibble[crc & 0x0F];
+        crc = (crc >> 4) ^ nibble[crc & 0x0F];
+    }
+    return crc ^ 0xFFFFFFFF;
+}
+
+// Pick the board for a ROM. Known Korean dumps come from the CRC table.
+// Otherwise, Codemasters games carry a header with a checksum and its
+// complement at 0x7FE6, and the rest are told apart by which mapper
+// registers the code stores to with LD (nn),A. Sega wins ties.
+static enum mmu_mapper_type mmu_detect_mapper(const uint8_t *rom, size_t len)
+{
+    uint32_t crc = mmu_crc32(rom, len);
+    for (size_t i = 0; i < sizeof(mmu_known_roms) / sizeof(mmu_known_roms[0]); i++)
+    {
+        if (mmu_known_roms[i].crc == crc)
+            return mmu_known_roms[i].mapper;
+    }
+
+    if (len >= 0x8000)
+    {
+        uint32_t checksum = rom[0x7FE6] | rom[0x7FE7] << 8;
+        uint32_t complement = rom[0x7FE8] | rom[0x7FE9] << 8;
+        if (checksum + complement == 0x10000)
+            return MMU_MAPPER_CODEMASTERS;
+    }
+    if (len <= 3 * MMU_SLOT_SIZE)
+        return MMU_MAPPER_SEGA;
+
+    uint32_t sega = 0, korean = 0, korean_8k = 0;
+    for (size_t i = 0; i + 2 < len; i++)
+    {
+        if (rom[i] != 0x32)
+            continue;
+        uint16_t addr = rom[i + 1] | rom[i + 2] << 8;
+        sega += addr >= 0xFFFD;
+        korean += addr == 0xA000;
+        korean_8k += addr < 4;
+    }
+    if (korean_8k > sega && korean_8k > korean)
+        return MMU_MAPPER_KOREAN_8K;
+    if (korean > sega)
+        return MMU_MAPPER_KOREAN;
+    return MMU_MAPPER_SEGA;
+}
+
+// Build the whole Z80 page table. Every page is mapped for reading; the
+// cartridge area and the page holding the mapper registers (0xFFFC-0xFFFF)
+// are written through mmu_write8, so the write table only changes with
+// watchpoints (see sms_add_watchpoint()) and the block cache's copy of it
+// stays valid.
+static void mmu_map_slots(struct mmu_t *mem)
+{
+    for (int page = 0; page < Z80_PAGE_COUNT; page++)
+    {
+        uint16_t addr = page << Z80_PAGE_SHIFT;
 
-    case 0x8000: // 0x8000-0x9FFF: ROM Page 2 or Cartridge RAM
-    case 0xA000: // 0xA000-0xBFFF: ROM Page 2 or Cartridge RAM
-        if (mem->cartridge_ram_enabled)
+        if (addr < 0xC000)
         {
-            uint16_t ram_offset = (addr & 0x1FFF); // Offset within 8KB window (0x0000-0x1FFF)
-            if (mem->cartridge_ram_page == 0)
-            { // If cartridge_ram_page selects 0x8000-0x9FFF
-                if ((addr & 0xE000) == 0x8000)
-                { // Only if address is within 0x8000-0x9FFF
-                    mem->cartridge_ram[ram_offset] = data;
-                }
-                // Else, if ram_slot is 0xA000-0xBFFF, do nothing (it's unmapped RAM or ROM)
-            }
-            else
-            { // If cartridge_ram_page selects 0xA000-0xBFFF
-                if ((addr & 0xE000) == 0xA000)
-                { // Only if address is within 0xA000-0xBFFF
-                    mem->cartridge_ram[ram_offset] = data;
-                }
-                // Else, if ram_slot is 0x8000-0x9FFF, do nothing
-            }
+            mmu_set_write_page(mem, page, NULL);
+        }
+        else
+        {
+            uint8_t *ram = mem->system_ram + (addr & 0x1FFF);
+            mmu_set_read_page(mem, page, ram);
+            bool mapper_page = page == (MMU_MEMORY_CONTROL_REGISTER >> Z80_PAGE_SHIFT);
+            mmu_set_write_page(mem, page, mapper_page ? NULL : ram);
+            mem->page_banks[page] = Z80_BANK_RAM;
+        }
+    }
+    mem->mapper->map(mem);
+}
+
+// Watchpoints. Only the pages they cover leave the published tables, so
+// unwatched accesses never see them; accesses to a watched page come
+// through mmu_read8/mmu_write8 and are checked against the list here.
+// Execute watchpoints are only kept in the list: the owner turns them into
+// Z80 breakpoints and reports their hits with mmu_watch_check().
+
+// Work out which pages are watched for what and republish every page
+static void mmu_watch_publish(struct mmu_t *mem)
+{
+    struct mmu_watch *watch = mem->watch;
+
+    memset(watch->pages, 0, sizeof(watch->pages));
+    for (int i = 0; i < watch->count; i++)
+    {
+        const struct mmu_watchpoint *point = &watch->points[i];
+        for (int page = point->start >> Z80_PAGE_SHIFT; page <= point->end >> Z80_PAGE_SHIFT; page++)
+        {
+            watch->pages[page] |= point->kinds;
         }
-        // If cartridge RAM is not enabled, this is ROM and write is ignored
+    }
+    mmu_trap_pages(mem);
+}
+
+// Watch start..end (inclusive) for the accesses in kinds. Returns the
+// watchpoint's index, or -1 when all MMU_MAX_WATCHPOINTS are in use.
+int mmu_watch_add(struct mmu_t *mem, uint16_t start, uint16_t end, uint8_t kinds)
+{
+    if (!mem->watch)
+    {
+        mem->watch = calloc(1, sizeof(struct mmu_watch));
+        if (!mem->watch)
+        {
+            printf("Failed to allocate watchpoints\n");
+            return -1;
+        }
+    }
+
+    struct mmu_watch *watch = mem->watch;
+    if (watch->count >= MMU_MAX_WATCHPOINTS || start > end || !kinds)
+    {
+        return -1;
+    }
+    watch->points[watch->count].start = start;
+    watch->points[watch->count].end = end;
+    watch->points[watch->count].kinds = kinds;
+    watch->count++;
+    mmu_watch_publish(mem);
+    return watch->count - 1;
+}
+
+void mmu_watch_remove(struct mmu_t *mem, int index)
+{
+    struct mmu_watch *watch = mem->watch;
+    if (!watch || index < 0 || index >= watch->count)
+    {
         return;
+    }
+    memmove(&watch->points[index], &watch->points[index + 1],
+            (watch->count - index - 1) * sizeof(watch->points[0]));
+    watch->count--;
+    mmu_watch_publish(mem);
+}
 
-    case 0xC000: // 0xC000-0xDFFF: System RAM
-        mem->system_ram[addr & 0x1FFF] = data;
+// Log an access of kind to addr if a watchpoint covers it. The owner's
+// on_watch_hit stamps the hit (PC, cycles) before it goes into the ring.
+void mmu_watch_check(struct mmu_t *mem, uint16_t addr, uint8_t kind, uint8_t value)
+{
+    struct mmu_watch *watch = mem->watch;
+    if (!watch || !(watch->pages[addr >> Z80_PAGE_SHIFT] & kind))
+    {
         return;
+    }
 
-    case 0xE000: // 0xE000-0xFFFF: Mirror of System RAM or control registers
-        if (addr >= 0xFFFC && addr <= 0xFFFF)
+    for (int i = 0; i < watch->count; i++)
+    {
+        const struct mmu_watchpoint *point = &watch->points[i];
+        if ((point->kinds & kind) && addr >= point->start && addr <= point->end)
         {
-            // Memory mapper control registers
-            switch (addr)
+            struct mmu_watch_hit *hit = &watch->log[watch->hits++ & (MMU_WATCH_LOG_SIZE - 1)];
+            hit->cycles = 0;
+            hit->addr = addr;
+            hit->pc = 0;
+            hit->kind = kind;
+            hit->value = value;
+            if (mem->on_watch_hit)
             {
-            case 0xFFFC:
-                mem->control_register = data;
-                mem->cartridge_ram_enabled = (data & 0x08) != 0;
-                mem->cartridge_ram_page = (data & 0x04) != 0;
-                break;
-
-            case 0xFFFD:
-                mem->page_registers[0] = data;
-                mmu_load_page(mem, data, 0);
-                break;
-
-            case 0xFFFE:
-                mem->page_registers[1] = data;
-                mmu_load_page(mem, data, 1);
-                break;
-
-            case 0xFFFF:
-                mem->page_registers[2] = data;
-                mmu_load_page(mem, data, 2);
-                break;
+                mem->on_watch_hit(mem->watch_ctx, hit);
             }
+            return;
         }
-        else
+    }
+}
+
+// Access profiler. While it runs every page is trapped, so each access
+// comes through here and is charged to the byte of ROM, cartridge RAM or
+// system RAM it really reached, found from the page's host pointer: the
+// mapper registers already picked the bank when they set it. With the
+// profiler stopped the page tables are exactly what they were.
+
+// Start counting into profile, whose regions the caller sized for the
+// loaded cartridge
+void mmu_profile_start(struct mmu_t *mem, struct mmu_profile *profile)
+{
+    mem->profile = profile;
+    mmu_trap_pages(mem);
+}
+
+void mmu_profile_stop(struct mmu_t *mem)
+{
+    mem->profile = NULL;
+    mmu_trap_pages(mem);
+}
+
+// Counts of the byte host points to, NULL for open bus
+static struct mmu_access_counts *mmu_profile_counts(struct mmu_t *mem, const uint8_t *host)
+{
+    struct mmu_profile *profile = mem->profile;
+
+    if (host >= mem->system_ram && host < mem->system_ram + MMU_RAM_SIZE)
+    {
+        return &profile->counts[MMU_PROFILE_SYSTEM_RAM][host - mem->system_ram];
+    }
+    if (host >= mem->cartridge_ram && host < mem->cartridge_ram + MMU_CARTRIDGE_RAM_SIZE)
+    {
+        return &profile->counts[MMU_PROFILE_CARTRIDGE_RAM][host - mem->cartridge_ram];
+    }
+    if (mem->cartridge && host >= mem->cartridge &&
+        (size_t)(host - mem->cartridge) < profile->size[MMU_PROFILE_CARTRIDGE])
+    {
+        return &profile->counts[MMU_PROFILE_CARTRIDGE][host - mem->cartridge];
+    }
+    return NULL;
+}
+
+static inline const uint8_t *mmu_host_address(struct mmu_t *mem, uint16_t addr)
+{
+    return mem->host_read_pages[addr >> Z80_PAGE_SHIFT] + (addr & Z80_PAGE_MASK);
+}
+
+// The CPU is about to execute the instruction at pc (see z80_t.on_execute)
+void mmu_profile_execute(struct mmu_t *mem, uint16_t pc)
+{
+    struct mmu_access_counts *counts = mmu_profile_counts(mem, mmu_host_address(mem, pc));
+    if (counts)
+    {
+        counts->execute++;
+    }
+}
+
+// The read path for pages taken out of read_pages by a watchpoint or the
+// profiler
+uint8_t mmu_read8_trapped(struct mmu_t *mem, uint16_t addr)
+{
+    const uint8_t *host = mmu_host_address(mem, addr);
+    if (mem->profile)
+    {
+        struct mmu_access_counts *counts = mmu_profile_counts(mem, host);
+        if (counts)
         {
-            // Mirror of system RAM
-            mem->system_ram[addr & 0x1FFF] = data;
+            counts->read++;
         }
-        return;
+    }
+    if (mem->watch)
+    {
+        mmu_watch_check(mem, addr, MMU_WATCH_READ, *host);
+    }
+    return *host;
+}
+
+// Read without triggering watchpoints or the profiler, for debuggers
+uint8_t mmu_peek8(struct mmu_t *mem, uint16_t addr)
+{
+    return *mmu_host_address(mem, addr);
+}
+
+void mmu_init(struct mmu_t *mem)
+{
+    memset(mmu_open_bus, 0xFF, sizeof(mmu_open_bus));
+    memset(mem->system_ram, 0, sizeof(mem->system_ram));
+    memset(mem->cartridge_ram, 0, sizeof(mem->cartridge_ram));
+    mem->cartridge_ram_dirty = 0;
+    mem->memory_control = 0xAB; // as the BIOS leaves it when it boots a cartridge
+    mem->watch = NULL;
+    mem->on_watch_hit = NULL;
+    mem->watch_ctx = NULL;
+    mem->profile = NULL;
+    memset(mem->trapped_pages, 0, sizeof(mem->trapped_pages));
+
+    mem->cartridge = NULL;
+    mem->cartridge_size = 0;
+    mem->cartridge_banks = 0;
+    mem->cartridge_mapped = false;
+    mem->mapper_type = MMU_MAPPER_SEGA;
+    mem->mapper_override = MMU_MAPPER_AUTO;
+    mem->mapper = &mmu_mappers[mem->mapper_type];
+    mem->mapper->reset(mem);
+
+    mmu_map_slots(mem);
+}
 
-    default:
+// Map the whole of an open ROM file read-only, NULL if the platform won't.
+// The pages are shared with the page cache (and every other instance
+// running the same ROM) and only read in as the game touches them.
+static uint8_t *mmu_map_file(FILE *file, size_t size)
+{
+#ifdef _WIN32
+    HANDLE handle = (HANDLE)_get_osfhandle(_fileno(file));
+    HANDLE mapping = CreateFileMappingA(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!mapping)
+        return NULL;
+    uint8_t *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, size);
+    CloseHandle(mapping); // the view keeps the mapping alive
+    return data;
+#else
+    uint8_t *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+    return data == MAP_FAILED ? NULL : data;
+#endif
+}
+
+static void mmu_release_cartridge(struct mmu_t *mem)
+{
+    if (mem->cartridge_mapped)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(mem->cartridge);
+#else
+        munmap(mem->cartridge, mem->cartridge_size);
+#endif
+    }
+    else
+    {
+        free(mem->cartridge);
+    }
+    mem->cartridge = NULL;
+    mem->cartridge_size = 0;
+    mem->cartridge_banks = 0;
+    mem->cartridge_mapped = false;
+}
+
+// Take over a cartridge image (whole banks), pick its mapper and power-on
+// map it
+static void mmu_insert_cartridge(struct mmu_t *mem, uint8_t *cartridge, size_t len, bool mapped)
+{
+    mmu_release_cartridge(mem);
+    mem->cartridge = cartridge;
+    mem->cartridge_size = len;
+    mem->cartridge_banks = (len + MMU_SLOT_SIZE - 1) / MMU_SLOT_SIZE;
+    mem->cartridge_mapped = mapped;
+
+    // A new cartridge brings its own (blank) RAM, see sms_battery_ready()
+    memset(mem->cartridge_ram, 0, sizeof(mem->cartridge_ram));
+    mem->cartridge_ram_dirty = 0;
+
+    mem->mapper_type = mem->mapper_override != MMU_MAPPER_AUTO ? mem->mapper_override
+                                                               : mmu_detect_mapper(cartridge, len);
+    mem->mapper = &mmu_mappers[mem->mapper_type];
+    mem->mapper->reset(mem);
+    mmu_map_slots(mem);
+}
+
+void mmu_deinit(struct mmu_t *mem)
+{
+    free(mem->watch);
+    mem->watch = NULL;
+    mmu_release_cartridge(mem);
+    mmu_map_slots(mem);
+}
+
+void mmu_load_rom(struct mmu_t *mem, const uint8_t *data, size_t len)
+{
+    size_t banks = (len + MMU_SLOT_SIZE - 1) / MMU_SLOT_SIZE;
+    uint8_t *cartridge = malloc(banks * MMU_SLOT_SIZE);
+    if (!cartridge)
+    {
+        printf("Failed to allocate %zu bytes for the cartridge\n", len);
         return;
     }
+    memcpy(cartridge, data, len);
+    memset(cartridge + len, 0xFF, banks * MMU_SLOT_SIZE - len);
+    mmu_insert_cartridge(mem, cartridge, len, false);
+}
+
+// Load a ROM straight from its file. An image of whole banks (any real
+// cartridge dump) is mapped and used in place; anything else, or a file the
+// platform can't map, is read once into a padded buffer. The loaded ROM is
+// left alone on failure.
+bool mmu_load_rom_file(struct mmu_t *mem, const char *filename)
+{
+    FILE *file = fopen(filename, "rb");
+    if (!file)
+    {
+        printf("Failed to open ROM file: %s\n", filename);
+        return false;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    if (size <= 0)
+    {
+        printf("Invalid ROM file size: %ld\n", size);
+        fclose(file);
+        return false;
+    }
+
+    size_t len = (size_t)size;
+    if (len % MMU_SLOT_SIZE == 0)
+    {
+        uint8_t *mapped = mmu_map_file(file, len);
+        if (mapped)
+        {
+            fclose(file);
+            mmu_insert_cartridge(mem, mapped, len, true);
+            return true;
+        }
+    }
+
+    size_t banks = (len + MMU_SLOT_SIZE - 1) / MMU_SLOT_SIZE;
+    uint8_t *cartridge = malloc(banks * MMU_SLOT_SIZE);
+    if (!cartridge)
+    {
+        printf("Failed to allocate %zu bytes for the cartridge\n", len);
+        fclose(file);
+        return false;
+    }
+
+    size_t bytes_read = fread(cartridge, 1, len, file);
+    fclose(file);
+    if (bytes_read != len)
+    {
+        printf("Failed to read ROM file completely\n");
+        free(cartridge);
+        return false;
+    }
+    memset(cartridge + len, 0xFF, banks * MMU_SLOT_SIZE - len);
+    mmu_insert_cartridge(mem, cartridge, len, false);
+    return true;
+}
+
+uint8_t mmu_read8(struct mmu_t *mem, uint16_t addr)
+{
+    return mmu_read8_inline(mem, addr);
+}
+
+uint16_t mmu_read16(struct mmu_t *mem, uint16_t addr)
+{
+    uint8_t low = mmu_read8(mem, addr);
+    uint8_t high = mmu_read8(mem, addr + 1);
+    return (high << 8) | low;
+}
+
+// System RAM and cartridge RAM are written here; everything else in the
+// cartridge area, and the mapper registers over the top of the RAM mirror,
+// goes to the mapper
+void mmu_write8(struct mmu_t *mem, uint16_t addr, uint8_t data)
+{
+    int page = addr >> Z80_PAGE_SHIFT;
+
+    if (mem->watch)
+    {
+        mmu_watch_check(mem, addr, MMU_WATCH_WRITE, data);
+    }
+    if (addr >= 0xC000)
+    {
+        mem->system_ram[addr & 0x1FFF] = data;
+        if (mem->profile)
+        {
+            mem->profile->counts[MMU_PROFILE_SYSTEM_RAM][addr & 0x1FFF].write++;
+        }
+        if (addr < MMU_MEMORY_CONTROL_REGISTER)
+            return;
+    }
+    else if (mmu_is_cartridge_ram(mem, page))
+    {
+        uint8_t *ram = mem->host_read_pages[page];
+        ram[addr & Z80_PAGE_MASK] = data;
+        mem->cartridge_ram_dirty |= 1u << ((ram - mem->cartridge_ram) >> Z80_PAGE_SHIFT);
+        if (mem->profile)
+        {
+            mem->profile->counts[MMU_PROFILE_CARTRIDGE_RAM][ram - mem->cartridge_ram + (addr & Z80_PAGE_MASK)].write++;
+        }
+    }
+    mem->mapper->write(mem, addr, data);
 }
 
 void mmu_write16(struct mmu_t *mem, uint16_t addr, uint16_t data)
 {
     mmu_write8(mem, addr, data & 0xFF);            // Low byte
     mmu_write8(mem, addr + 1, (data >> 8) & 0xFF); // High byte
+}
+
+// Memory control port, registered on its mirrors by sms_ports_init()
+void mmu_port_write(struct mmu_t *mem, uint8_t port, uint8_t value)
+{
+    (void)port;
+    mem->memory_control = value;
 }
\ No newline at end of file
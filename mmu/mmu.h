@@ -2,45 +2,188 @@
 #define MMU_H_
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "../cpu/z80.h"
+#include "../cpu/z80_block.h"
 
 #define MMU_MEMORY_CONTROL_REGISTER 0xFFFC
 
-#define MMU_ROM_SLOT_0_SIZE 0x4000
-#define MMU_ROM_SLOT_1_SIZE 0x4000
-#define MMU_RAM_SLOT_SIZE   0x4000
-#define MMU_RAM_SIZE        0x2000
+#define MMU_SLOT_SIZE            0x4000  // one ROM bank / mapper slot
+#define MMU_SLOT_COUNT           3
+#define MMU_FIXED_SIZE           0x400   // start of slot 0, always bank 0
+#define MMU_RAM_SIZE             0x2000
+#define MMU_CARTRIDGE_RAM_SIZE   0x8000  // two 16KB banks
+#define MMU_CARTRIDGE_RAM_PAGES  (MMU_CARTRIDGE_RAM_SIZE >> Z80_PAGE_SHIFT)
+#define MMU_BANK_8K              0x8000  // page_banks tag of 8KB-paged banks
+// page_banks of cartridge RAM: one id per 1KB page of it, so decoded blocks
+// follow the RAM bank switches of 0xFFFC
+#define MMU_BANK_CARTRIDGE_RAM   Z80_BANK_RAM_FIRST
+
+// Cartridge boards, see the mappers in mmu.c
+enum mmu_mapper_type
+{
+    MMU_MAPPER_AUTO,          // detect from the ROM
+    MMU_MAPPER_SEGA,
+    MMU_MAPPER_CODEMASTERS,
+    MMU_MAPPER_KOREAN,
+    MMU_MAPPER_KOREAN_8K,
+    MMU_MAPPER_COUNT
+};
+
+#define MMU_MAX_WATCHPOINTS  16
+#define MMU_WATCH_LOG_SIZE   256     // hits kept, a power of two
+
+enum mmu_watch_kind
+{
+    MMU_WATCH_READ    = 1 << 0,
+    MMU_WATCH_WRITE   = 1 << 1,
+    MMU_WATCH_EXECUTE = 1 << 2,
+};
+
+struct mmu_watchpoint
+{
+    uint16_t start, end;     // inclusive
+    uint8_t kinds;           // enum mmu_watch_kind bits
+};
+
+struct mmu_watch_hit
+{
+    uint64_t cycles;         // CPU cycles, stamped by on_watch_hit
+    uint16_t addr;
+    uint16_t pc;             // stamped by on_watch_hit
+    uint8_t kind;            // the one enum mmu_watch_kind that hit
+    uint8_t value;           // byte read or written, opcode for execute
+};
+
+// Watchpoints and the ring of their latest hits, for the debugger
+struct mmu_watch
+{
+    struct mmu_watchpoint points[MMU_MAX_WATCHPOINTS];
+    int count;
+    uint8_t pages[Z80_PAGE_COUNT];           // kinds watched in each page
+    struct mmu_watch_hit log[MMU_WATCH_LOG_SIZE];
+    uint32_t hits;           // total so far, the latest is log[(hits - 1) % MMU_WATCH_LOG_SIZE]
+};
+
+// Accesses to one byte while profiling
+struct mmu_access_counts
+{
+    uint32_t read;
+    uint32_t write;
+    uint32_t execute;
+};
+
+// Memory the profiler tells apart. Cartridge counts are per byte of the ROM
+// image, so every bank has its own whatever slot it was seen through.
+enum mmu_profile_region
+{
+    MMU_PROFILE_CARTRIDGE,
+    MMU_PROFILE_CARTRIDGE_RAM,
+    MMU_PROFILE_SYSTEM_RAM,
+    MMU_PROFILE_REGIONS
+};
+
+// Counts for each region, sized by the owner (see core/sms_profile.h)
+struct mmu_profile
+{
+    struct mmu_access_counts *counts[MMU_PROFILE_REGIONS];
+    size_t size[MMU_PROFILE_REGIONS];
+};
+
+struct mmu_mapper;
 
 struct mmu_t
 {
+    // ROM image, padded with 0xFF to whole banks so every slot pointer
+    // covers a full bank. A ROM file of whole banks is the read-only file
+    // mapping itself (cartridge_mapped), see mmu_load_rom_file().
     uint8_t *cartridge;
-    uint8_t cartridge_ram[16 * 1024];
     size_t cartridge_size;
-    union
-    {
-        uint8_t memory[65535]; 
-        struct
-        {
-            uint8_t rom_slot_0[MMU_ROM_SLOT_0_SIZE];
-            uint8_t rom_slot_1[MMU_ROM_SLOT_1_SIZE];
-            uint8_t ram_slot[MMU_RAM_SLOT_SIZE];
-            uint8_t system_ram[MMU_RAM_SIZE];
-        };
-    };
-    uint8_t page_registers[3];
+    size_t cartridge_banks;
+    bool cartridge_mapped;
+    // Board of the loaded cartridge and its registers. Switching banks only
+    // moves page pointers.
+    const struct mmu_mapper *mapper;
+    enum mmu_mapper_type mapper_type;
+    enum mmu_mapper_type mapper_override;
+    uint8_t page_registers[4];
     uint8_t control_register;
     uint8_t cartridge_ram_page;
     uint8_t cartridge_ram_enabled;
+    // Memory control port (0x3E): which of BIOS, cartridge, card, RAM and
+    // I/O are enabled. There is no BIOS to switch to, so it is only kept.
+    uint8_t memory_control;
+    // Direct-access page tables handed to the Z80 (NULL = use mmu_read8/mmu_write8)
+    uint8_t *read_pages[Z80_PAGE_COUNT];
+    uint8_t *write_pages[Z80_PAGE_COUNT];
+    // What each page really maps to. The tables above are these minus the
+    // pages trapped for watchpoints or the profiler, see mmu_set_read_page()
+    uint8_t *host_read_pages[Z80_PAGE_COUNT];
+    uint8_t *host_write_pages[Z80_PAGE_COUNT];
+    uint8_t trapped_pages[Z80_PAGE_COUNT];   // enum mmu_watch_kind bits
+    // ROM bank visible in each page (Z80_BANK_RAM for system RAM,
+    // MMU_BANK_CARTRIDGE_RAM + page of it for cartridge RAM), keys decoded blocks
+    uint16_t page_banks[Z80_PAGE_COUNT];
+    uint8_t system_ram[MMU_RAM_SIZE];
+    uint8_t cartridge_ram[MMU_CARTRIDGE_RAM_SIZE];
+    // Cartridge RAM pages written since the battery last took them, one bit
+    // per Z80 page (see core/sms_battery.h)
+    uint32_t cartridge_ram_dirty;
+    // Watchpoints (NULL until the first is added), see mmu_watch_add()
+    struct mmu_watch *watch;
+    void (*on_watch_hit)(void *ctx, struct mmu_watch_hit *hit);
+    void *watch_ctx;
+    // Access counters while profiling (NULL otherwise), see mmu_profile_start()
+    struct mmu_profile *profile;
 };
 
 void mmu_init(struct mmu_t *mem);
 void mmu_deinit(struct mmu_t *mem);
 void mmu_load_rom(struct mmu_t *mem, const uint8_t *data, size_t len);
+bool mmu_load_rom_file(struct mmu_t *mem, const char *filename);
+void mmu_set_mapper_override(struct mmu_t *mem, enum mmu_mapper_type type);
+const char *mmu_mapper_name(enum mmu_mapper_type type);
+enum mmu_mapper_type mmu_mapper_from_name(const char *name);
+int mmu_watch_add(struct mmu_t *mem, uint16_t start, uint16_t end, uint8_t kinds);
+void mmu_watch_remove(struct mmu_t *mem, int index);
+void mmu_watch_check(struct mmu_t *mem, uint16_t addr, uint8_t kind, uint8_t value);
+void mmu_profile_start(struct mmu_t *mem, struct mmu_profile *profile);
+void mmu_profile_stop(struct mmu_t *mem);
+void mmu_profile_execute(struct mmu_t *mem, uint16_t pc);
+uint8_t mmu_read8_trapped(struct mmu_t *mem, uint16_t addr);
+uint8_t mmu_peek8(struct mmu_t *mem, uint16_t addr);
 uint8_t mmu_read8(struct mmu_t *mem, uint16_t addr);
 uint16_t mmu_read16(struct mmu_t *mem, uint16_t addr);
 void mmu_write8(struct mmu_t *mem, uint16_t addr, uint8_t data);
 void mmu_write16(struct mmu_t *mem, uint16_t addr, uint16_t data);
-uint8_t mmu_port_read(struct mmu_t *mem, uint8_t port);
 void mmu_port_write(struct mmu_t *mem, uint8_t port, uint8_t value);
 
+// Inline accessors for statically bound buses (see core/sms_bus.h);
+// mmu_read8/mmu_write8 are the out-of-line callback versions
+static inline uint8_t mmu_read8_inline(struct mmu_t *mem, uint16_t addr)
+{
+    // Every page is mapped for reading (see mmu_map_slots()) unless a
+    // watchpoint or the profiler trapped it
+    uint8_t *page = mem->read_pages[addr >> Z80_PAGE_SHIFT];
+    if (page)
+    {
+        return page[addr & Z80_PAGE_MASK];
+    }
+    return mmu_read8_trapped(mem, addr);
+}
+
+static inline void mmu_write8_inline(struct mmu_t *mem, uint16_t addr, uint8_t data)
+{
+    // System RAM and its mirror below the mapper registers' page; the rest
+    // (ROM, cartridge RAM, mapper registers, trapped pages) is left out of
+    // write_pages and takes the full path
+    uint8_t *page = mem->write_pages[addr >> Z80_PAGE_SHIFT];
+    if (page)
+    {
+        page[addr & Z80_PAGE_MASK] = data;
+        return;
+    }
+    mmu_write8(mem, addr, data);
+}
+
 #endif
\ No newline at end of file
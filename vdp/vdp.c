@@ -1,3 +1,4 @@
+#include <string.h>
 #include "vdp.h"
 #include "SDL3/SDL.h"
 
@@ -295,6 +296,15 @@ static void vdp_draw_scanline(struct vdp_t *vdp, uint32_t *framebuffer, uint16_t
     }
 }
 
+// The IRQ output: a pending frame or line interrupt whose enable bit is set.
+// The flags latch whether or not the interrupt is enabled, so enabling it
+// later raises the IRQ at once.
+static void vdp_update_irq(struct vdp_t *vdp)
+{
+    vdp->irq_pending = (vdp->vblank_flag && vdp->frame_interrupt_enable) ||
+                       (vdp->line_interrupt_flag && vdp->line_interrupt_enable);
+}
+
 void vdp_process_scanline(struct vdp_t *vdp, uint32_t *framebuffer)
 {
     // Handle HBlank interrupt (line counter)
@@ -303,10 +313,8 @@ void vdp_process_scanline(struct vdp_t *vdp, uint32_t *framebuffer)
         if (vdp->line_counter == 0)
         {
             vdp->line_counter = vdp->line_counter_reload_value;
-            if (vdp->line_interrupt_enable)
-            {
-                vdp->irq_pending = 1;
-            }
+            vdp->line_interrupt_flag = true;
+            vdp_update_irq(vdp);
         }
         else
         {
@@ -327,13 +335,10 @@ void vdp_process_scanline(struct vdp_t *vdp, uint32_t *framebuffer)
     // Check for VBlank interrupt
     if (vdp->v_counter == VDP_NTSC_SCANLINE_INTERRUPT_LINE)
     {
-        // Trigger VBlank interrupt if enabled (IE0 bit in register 1)
-        if (vdp->frame_interrupt_enable) // IE0 bit (bit 5)
-        {
-            vdp->status_flag |= 0x80; // Set VBlank interrupt flag in status
-            vdp->vblank_flag = true;
-            vdp->irq_pending = 1;
-        }
+        // Raises the IRQ if enabled (IE0 bit in register 1)
+        vdp->status_flag |= 0x80; // Set VBlank interrupt flag in status
+        vdp->vblank_flag = true;
+        vdp_update_irq(vdp);
     }
 
     if (vdp->v_counter > VDP_SCANLINES_NTSC)
@@ -342,46 +347,6 @@ void vdp_process_scanline(struct vdp_t *vdp, uint32_t *framebuffer)
     }
 }
 
-uint8_t vdp_port_read(struct vdp_t *vdp, uint8_t port)
-{
-    switch (port)
-    {
-    case 0x7E: // V-Counter
-        return vdp->v_counter;
-
-    case 0x7F: // H-Counter
-        return vdp->h_counter;
-
-    case 0xBE: // VDP Data Port
-        vdp->second_write = false;
-        return vdp_data_port_read(vdp);
-
-    case 0xBF: // VDP Control/Status Port
-        return vdp_control_port_read(vdp);
-
-    default:
-        return 0xFF;
-    }
-}
-
-void vdp_port_write(struct vdp_t *vdp, uint8_t port, uint8_t value)
-{
-    switch (port) {
-        case 0xBE: // VDP Data Port
-            vdp->second_write = false;
-            vdp_data_port_write(vdp, value);
-            break;
-            
-        case 0xBF: // VDP Control Port
-            vdp_control_port_write(vdp, value);
-            break;
-            
-        default:
-            // Other ports are read-only or ignored
-            break;
-    }
-}
-
 /*
 The VDP control port is a read/write port allowing the VDP registers to be written;
 the VRAM/CRAM read/write address to be set; and the status flags to be read. 
@@ -424,6 +389,7 @@ uint8_t vdp_control_port_read(struct vdp_t *vdp)
     vdp->status_flag = vdp->vblank_flag << 7 | vdp->sprite_overflow_flag << 6 | vdp->sprite_collision_flag << 5 | vdp->fifth_sprite;
     vdp->second_write = false;
     vdp->vblank_flag = false;
+    vdp->line_interrupt_flag = false;
     vdp->irq_pending = 0; 
     vdp->sprite_collision_flag = false;
     vdp->fifth_sprite = 0x0;
@@ -432,6 +398,7 @@ uint8_t vdp_control_port_read(struct vdp_t *vdp)
 
 uint8_t vdp_data_port_read(struct vdp_t *vdp)
 {
+    vdp->second_write = false;  // Any data port access resets the control latch
     uint8_t value_to_return = vdp->read_buffer; // Return the *previously* buffered value
     vdp->read_buffer = vdp->vram[vdp->address]; // Load the *next* value into the buffer
     vdp->address++;
@@ -447,6 +414,7 @@ bool vdp_interrupt_pending(struct vdp_t *vdp)
 
 void vdp_data_port_write(struct vdp_t *vdp, uint8_t value)
 {
+    vdp->second_write = false;  // Resets the control latch, as reads do
     if(vdp->code == 0x1)    // Vram Write Address
     {
         vdp->vram[vdp->address] = value; // Write to VRAM
@@ -466,6 +434,37 @@ void vdp_data_port_write(struct vdp_t *vdp, uint8_t value)
 
 }
 
+// Same as size writes to the data port (e.g. an OTIR to 0xBE), with VRAM
+// uploads done as straight copies between address wraps
+void vdp_data_port_write_block(struct vdp_t *vdp, const uint8_t *data, size_t size)
+{
+    vdp->second_write = false;
+    if (size == 0)
+        return;
+
+    if (vdp->code == 0x1)    // Vram Write Address
+    {
+        while (size > 0)
+        {
+            size_t n = 0x4000 - vdp->address;
+            if (n > size)
+                n = size;
+            memcpy(&vdp->vram[vdp->address], data, n);
+            vdp->address = (vdp->address + n) & 0x3FFF;
+            data += n;
+            size -= n;
+        }
+        vdp->read_buffer = data[-1];
+    }
+    else if (vdp->code == 0x3) // Cram Write address
+    {
+        for (size_t i = 0; i < size; i++)
+        {
+            vdp_data_port_write(vdp, data[i]);
+        }
+    }
+}
+
 void vdp_write_register(struct vdp_t *vdp, vdp_register_t r, uint8_t value)
 {
     if (r > VDP_REGISTER_COUNT)
@@ -483,6 +482,7 @@ void vdp_write_register(struct vdp_t *vdp, vdp_register_t r, uint8_t value)
         vdp->mode4_enable           = (value & 0x04) != 0;
         vdp->extra_height_enable    = (value & 0x02) != 0;
         vdp->sync_disable           = (value & 0x01) != 0;
+        vdp_update_irq(vdp);
         break;
     case VDP_REG_MODE_CONTROL_2:
         vdp->display_enable         = (value & 0x40) != 0;
@@ -491,6 +491,7 @@ void vdp_write_register(struct vdp_t *vdp, vdp_register_t r, uint8_t value)
         vdp->mode3_enable           = (value & 0x08) != 0;
         vdp->sprite_size            = (value & 0x02) != 0;
         vdp->sprite_doubled         = (value & 0x01) != 0;
+        vdp_update_irq(vdp);
         break;
     case VDP_REG_NAME_TABLE_BASE:
         vdp->name_table_base = value;
@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 // VDP Register definitions
 #define VDP_REGISTER_COUNT 16
@@ -151,6 +152,7 @@ struct vdp_t
 
     // Status
     uint8_t vblank_flag;
+    bool line_interrupt_flag;    // Line counter underflowed since the last status read
     uint8_t sprite_overflow_flag;
     uint8_t sprite_collision_flag;
     uint8_t fifth_sprite;
@@ -158,18 +160,17 @@ struct vdp_t
     
     uint64_t total_cycles;
 
-    bool irq_pending;
+    bool irq_pending;            // IRQ output, see vdp_update_irq()
 };
 
 void vdp_init(struct vdp_t *vdp);
 void vdp_step(struct vdp_t *vdp, uint8_t cycles);
 void vdp_write_register(struct vdp_t *vdp, vdp_register_t r, uint8_t value);
-uint8_t vdp_port_read(struct vdp_t *vdp, uint8_t port);
-void vdp_port_write(struct vdp_t *vdp, uint8_t port, uint8_t value);
 void vdp_process_scanline(struct vdp_t *vdp, uint32_t *framebuffer);
 void vdp_control_port_write(struct vdp_t *vdp, uint8_t value);
 uint8_t vdp_control_port_read(struct vdp_t *vdp);
 void vdp_data_port_write(struct vdp_t *vdp, uint8_t value);
+void vdp_data_port_write_block(struct vdp_t *vdp, const uint8_t *data, size_t size);
 uint8_t vdp_data_port_read(struct vdp_t *vdp);
 bool vdp_interrupt_pending(struct vdp_t *vdp);
 void vdp_draw_nametable(struct vdp_t *vdp, uint32_t *framebuffer);